@@ -0,0 +1,427 @@
+/**
+ * @file ManagerBenchmark.cpp
+ * @brief Reproducible micro- and macrobenchmarks of the S3, DynamoDB and EC2 managers
+ *
+ * Microbenchmarks time single calls: S3 PutObject and GetObject at several
+ * object sizes, object listings, DynamoDB PutItem, GetItem and Scan, and EC2
+ * DescribeInstances over fleets of several sizes. Macrobenchmarks time whole
+ * operations: a 64 MiB multipart upload, a 64 MiB ranged download, a parallel
+ * listing, and GetItem from several threads at once.
+ *
+ * Every service is served by an in-process stand-in on 127.0.0.1 (see
+ * StandIns.h), so results depend only on the client code and the machine. To
+ * benchmark against other local stand-ins, point the endpoint variables at them:
+ *   AWSEXAMPLES_S3_ENDPOINT        e.g. "http://localhost:9000" for MinIO
+ *   AWSEXAMPLES_DYNAMODB_ENDPOINT  e.g. "http://localhost:8000" for DynamoDB Local
+ *   AWSEXAMPLES_EC2_ENDPOINT       e.g. "http://localhost:5000" for a mock EC2 endpoint
+ * The endpoints used are recorded in the context section of the results.
+ *
+ * Accepts the usual Google Benchmark flags; write JSON results with
+ *   manager-benchmark --benchmark_out=results.json --benchmark_out_format=json
+ * or build the run-manager-benchmark target.
+ */
+
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/EC2Manager.h"
+#include "awsexamples/FleetSnapshot.h"
+#include "awsexamples/S3Manager.h"
+#include "awsexamples/S3ObjectLister.h"
+#include "MockHttpServer.h"
+#include "StandIns.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kListGroups = 10;                                   // Prefixes the listed keys are spread over
+constexpr int kListKeysPerGroup = 500;                            // Keys under each prefix
+constexpr int kTableItems = 1000;                                 // Items in the benchmark table
+constexpr std::int64_t kMacroObjectSize = 64LL * 1024 * 1024;     // Size of the multipart object
+
+/**
+ * Services under test: an endpoint from the environment, or an in-process
+ * stand-in. Servers are declared before the managers so they outlive them.
+ */
+struct Backends {
+    standins::S3StandIn s3StandIn;
+    standins::DynamoDBStandIn dynamoStandIn;
+    standins::EC2StandIn ec2StandIn;
+    std::unique_ptr<MockHttpServer> s3Server;
+    std::unique_ptr<MockHttpServer> dynamoServer;
+    std::unique_ptr<MockHttpServer> ec2Server;
+    std::unique_ptr<awsexamples::S3Manager> s3;
+    std::unique_ptr<awsexamples::DynamoDBManager> dynamo;
+    std::unique_ptr<awsexamples::EC2Manager> ec2;
+    std::string bucketName;
+    std::string tableName;
+};
+
+Backends* backends = nullptr;
+
+// Use the endpoint named by an environment variable, or start a server for the stand-in
+template <typename StandIn>
+std::string Endpoint(const char* variable, StandIn& standIn, std::unique_ptr<MockHttpServer>& server) {
+    const char* endpoint = std::getenv(variable);
+    if (endpoint != nullptr && *endpoint != '\0') {
+        return endpoint;
+    }
+    server = std::make_unique<MockHttpServer>(
+        [&standIn](const MockHttpServer::Request& request) { return standIn.Handle(request); }, true);
+    return server->IsRunning() ? server->Endpoint() : "";
+}
+
+// Client configuration for one endpoint; stand-ins accept any credentials
+Aws::Client::ClientConfiguration ClientConfig(const std::string& endpoint) {
+    awsexamples::utils::ClientOptions options;
+    options.region = "us-east-1";
+    options.endpointOverride = endpoint;
+    options.requestTimeoutMs = 30000;
+    options.maxConnections = 32;
+    return awsexamples::utils::ConfigureClient(options);
+}
+
+// Path of a scratch file in TMPDIR
+std::string ScratchPath(const std::string& name) {
+    const char* directory = std::getenv("TMPDIR");
+    const std::string base = directory != nullptr && *directory != '\0' ? directory : "/tmp";
+    return base + "/manager-benchmark-" + name;
+}
+
+// Write a file of the given size filled with a repeating pattern
+bool WriteScratchFile(const std::string& path, std::int64_t size) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::string chunk(1024 * 1024, '\0');
+    for (std::size_t i = 0; i < chunk.size(); ++i) {
+        chunk[i] = static_cast<char>('a' + i % 26);
+    }
+    for (std::int64_t written = 0; written < size && file; written += static_cast<std::int64_t>(chunk.size())) {
+        file.write(chunk.data(), static_cast<std::streamsize>(std::min<std::int64_t>(size - written, chunk.size())));
+    }
+    return static_cast<bool>(file);
+}
+
+std::string ObjectKey(const char* prefix, std::int64_t size) {
+    return std::string(prefix) + std::to_string(size);
+}
+
+std::string ItemId(std::int64_t index) {
+    return "item" + std::to_string(index % kTableItems);
+}
+
+// Create the bucket and table and fill them with the data the read benchmarks use
+bool Seed(Backends& services) {
+    if (!services.s3->CreateBucket(services.bucketName, "us-east-1")) {
+        return false;
+    }
+    for (std::int64_t size = 1024; size <= 1024 * 1024; size *= 64) {
+        if (!services.s3->UploadText(services.bucketName, ObjectKey("get/", size), std::string(size, 'g'))) {
+            return false;
+        }
+    }
+    for (int group = 0; group < kListGroups; ++group) {
+        for (int key = 0; key < kListKeysPerGroup; ++key) {
+            const std::string name = "list/" + std::to_string(group) + "/" + std::to_string(key);
+            if (!services.s3->UploadText(services.bucketName, name, "x")) {
+                return false;
+            }
+        }
+    }
+
+    if (!services.dynamo->CreateTable(services.tableName) ||
+        !services.dynamo->WaitForTableState(services.tableName, "ACTIVE", 60)) {
+        return false;
+    }
+    for (int item = 0; item < kTableItems; ++item) {
+        if (!services.dynamo->PutItem(services.tableName, ItemId(item), "Benchmark item " + std::to_string(item),
+                                      item % 100)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Remove everything Seed and the benchmarks created, for endpoints that persist data
+void CleanUp(Backends& services) {
+    std::vector<std::string> keys;
+    {
+        awsexamples::S3ObjectLister lister(*services.s3, services.bucketName);
+        for (const auto& object : lister) {
+            keys.push_back(object.GetKey());
+        }
+    }
+    for (const auto& key : keys) {
+        services.s3->DeleteObject(services.bucketName, key);
+    }
+    services.s3->DeleteBucket(services.bucketName);
+    services.dynamo->DeleteTable(services.tableName);
+}
+
+// ---- S3 ----
+
+void BM_S3PutObject(benchmark::State& state) {
+    const std::string body(static_cast<std::size_t>(state.range(0)), 'p');
+    const std::string key = ObjectKey("put/", state.range(0));
+    for (auto _ : state) {
+        if (!backends->s3->UploadText(backends->bucketName, key, body)) {
+            state.SkipWithError("PutObject failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_S3PutObject)
+    ->RangeMultiplier(64)
+    ->Range(1024, 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+void BM_S3GetObject(benchmark::State& state) {
+    const std::string key = ObjectKey("get/", state.range(0));
+    const std::string localPath = ScratchPath("get-" + std::to_string(state.range(0)));
+    for (auto _ : state) {
+        if (!backends->s3->DownloadFile(backends->bucketName, key, localPath)) {
+            state.SkipWithError("GetObject failed");
+            break;
+        }
+    }
+    std::remove(localPath.c_str());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_S3GetObject)
+    ->RangeMultiplier(64)
+    ->Range(1024, 1024 * 1024)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Arguments: keys per page, prefetch
+void BM_S3ListObjects(benchmark::State& state) {
+    awsexamples::ListObjectsOptions options;
+    options.prefix = "list/";
+    options.pageSize = static_cast<int>(state.range(0));
+    options.prefetch = state.range(1) != 0;
+    std::int64_t listed = 0;
+    for (auto _ : state) {
+        awsexamples::S3ObjectLister lister(*backends->s3, backends->bucketName, options);
+        for (const auto& object : lister) {
+            benchmark::DoNotOptimize(object.GetSize());
+            ++listed;
+        }
+        if (lister.Failed()) {
+            state.SkipWithError("ListObjectsV2 failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(listed);
+}
+BENCHMARK(BM_S3ListObjects)
+    ->ArgNames({"page", "prefetch"})
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({100, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// ---- DynamoDB ----
+
+void BM_DynamoDBPutItem(benchmark::State& state) {
+    std::int64_t index = 0;
+    for (auto _ : state) {
+        const int age = static_cast<int>(index % 100);
+        if (!backends->dynamo->PutItem(backends->tableName, ItemId(index), "Updated item", age)) {
+            state.SkipWithError("PutItem failed");
+            break;
+        }
+        ++index;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DynamoDBPutItem)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Runs single-threaded as a microbenchmark and multi-threaded as a macrobenchmark
+void BM_DynamoDBGetItem(benchmark::State& state) {
+    std::int64_t index = state.thread_index() * 7919;
+    awsexamples::AttributeMap item;
+    for (auto _ : state) {
+        if (!backends->dynamo->GetItem(backends->tableName, ItemId(index++), item) || item.empty()) {
+            state.SkipWithError("GetItem failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DynamoDBGetItem)->Threads(1)->Threads(8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Argument: items per Scan request
+void BM_DynamoDBScan(benchmark::State& state) {
+    awsexamples::ScanOptions options;
+    options.pageSize = static_cast<int>(state.range(0));
+    std::int64_t scanned = 0;
+    for (auto _ : state) {
+        auto result = backends->dynamo->ScanTable(backends->tableName, options,
+                                                  [&scanned](const awsexamples::AttributeMap&) {
+                                                      ++scanned;
+                                                      return true;
+                                                  });
+        if (!result) {
+            state.SkipWithError("Scan failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(scanned);
+}
+BENCHMARK(BM_DynamoDBScan)->ArgName("page")->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// ---- EC2 ----
+
+// Argument: instances in the stand-in fleet; an external endpoint describes whatever it has
+void BM_EC2DescribeFleet(benchmark::State& state) {
+    backends->ec2StandIn.SetFleetSize(static_cast<std::size_t>(state.range(0)));
+    std::size_t instances = 0;
+    for (auto _ : state) {
+        awsexamples::FleetSnapshot snapshot;
+        if (!backends->ec2->DescribeFleet(snapshot)) {
+            state.SkipWithError("DescribeInstances failed");
+            break;
+        }
+        instances = snapshot.Size();
+    }
+    state.counters["instances"] = static_cast<double>(instances);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(instances));
+}
+BENCHMARK(BM_EC2DescribeFleet)
+    ->ArgName("fleet")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// ---- Macrobenchmarks ----
+
+// Argument: parts uploaded in parallel
+void BM_S3MultipartUpload(benchmark::State& state) {
+    const std::string localPath = ScratchPath("upload");
+    if (!WriteScratchFile(localPath, kMacroObjectSize)) {
+        state.SkipWithError("Could not write the scratch file");
+        return;
+    }
+    awsexamples::MultipartUploadOptions options;
+    options.concurrency = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        if (!backends->s3->UploadFile(backends->bucketName, "macro/upload", localPath, options)) {
+            state.SkipWithError("Multipart upload failed");
+            break;
+        }
+    }
+    std::remove(localPath.c_str());
+    state.SetBytesProcessed(state.iterations() * kMacroObjectSize);
+}
+BENCHMARK(BM_S3MultipartUpload)->ArgName("concurrency")->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Argument: ranges fetched in parallel
+void BM_S3RangedDownload(benchmark::State& state) {
+    const std::string localPath = ScratchPath("download");
+    if (!WriteScratchFile(localPath, kMacroObjectSize) ||
+        !backends->s3->UploadFile(backends->bucketName, "macro/download", localPath,
+                                  awsexamples::MultipartUploadOptions())) {
+        state.SkipWithError("Could not upload the object to download");
+        return;
+    }
+    awsexamples::RangedDownloadOptions options;
+    options.concurrency = static_cast<unsigned>(state.range(0));
+    options.resume = false;
+    for (auto _ : state) {
+        if (!backends->s3->DownloadFile(backends->bucketName, "macro/download", localPath, options)) {
+            state.SkipWithError("Ranged download failed");
+            break;
+        }
+    }
+    std::remove(localPath.c_str());
+    state.SetBytesProcessed(state.iterations() * kMacroObjectSize);
+}
+BENCHMARK(BM_S3RangedDownload)->ArgName("concurrency")->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_S3ListObjectsParallel(benchmark::State& state) {
+    awsexamples::ParallelListOptions options;
+    options.prefix = "list/";
+    std::atomic<std::int64_t> listed{0};
+    for (auto _ : state) {
+        auto result = backends->s3->ListObjectsParallel(backends->bucketName, options,
+                                                        [&listed](const Aws::S3::Model::Object&) {
+                                                            listed.fetch_add(1, std::memory_order_relaxed);
+                                                            return true;
+                                                        });
+        if (!result) {
+            state.SkipWithError("Parallel listing failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(listed.load());
+}
+BENCHMARK(BM_S3ListObjectsParallel)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // Stand-ins accept any signature; credentials already in the environment are kept
+    setenv("AWS_ACCESS_KEY_ID", "AKIDSTANDIN", 0);
+    setenv("AWS_SECRET_ACCESS_KEY", "stand-in", 0);
+    setenv("AWS_EC2_METADATA_DISABLED", "true", 1);
+
+    awsexamples::utils::AwsApiInitializer awsInitializer(
+        awsexamples::utils::CreateDefaultSDKOptions(Aws::Utils::Logging::LogLevel::Error));
+    int exitCode = 0;
+    {
+        Backends services;
+        const std::string s3Endpoint = Endpoint("AWSEXAMPLES_S3_ENDPOINT", services.s3StandIn, services.s3Server);
+        const std::string dynamoEndpoint =
+            Endpoint("AWSEXAMPLES_DYNAMODB_ENDPOINT", services.dynamoStandIn, services.dynamoServer);
+        const std::string ec2Endpoint = Endpoint("AWSEXAMPLES_EC2_ENDPOINT", services.ec2StandIn, services.ec2Server);
+        if (s3Endpoint.empty() || dynamoEndpoint.empty() || ec2Endpoint.empty()) {
+            std::cerr << "Could not start the stand-in endpoints" << std::endl;
+            return 1;
+        }
+        benchmark::AddCustomContext("s3_endpoint", services.s3Server ? "in-process stand-in" : s3Endpoint);
+        benchmark::AddCustomContext("dynamodb_endpoint",
+                                    services.dynamoServer ? "in-process stand-in" : dynamoEndpoint);
+        benchmark::AddCustomContext("ec2_endpoint", services.ec2Server ? "in-process stand-in" : ec2Endpoint);
+
+        // Path-style addressing works with any host, including MinIO on localhost
+        services.s3 = std::make_unique<awsexamples::S3Manager>(ClientConfig(s3Endpoint), false);
+        services.dynamo = std::make_unique<awsexamples::DynamoDBManager>(ClientConfig(dynamoEndpoint));
+        services.ec2 = std::make_unique<awsexamples::EC2Manager>(ClientConfig(ec2Endpoint));
+
+        const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        services.bucketName = "awsexamples-benchmark-" + std::to_string(timestamp);
+        services.tableName = "ManagerBenchmark_" + std::to_string(timestamp);
+
+        if (!Seed(services)) {
+            std::cerr << "Could not create the benchmark bucket and table" << std::endl;
+            exitCode = 1;
+        } else {
+            backends = &services;
+            benchmark::RunSpecifiedBenchmarks();
+            backends = nullptr;
+        }
+        CleanUp(services);
+    }
+    benchmark::Shutdown();
+    return exitCode;
+}
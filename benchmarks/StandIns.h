@@ -0,0 +1,414 @@
+/**
+ * @file StandIns.h
+ * @brief In-memory S3, DynamoDB and EC2 request handlers for MockHttpServer
+ *
+ * Each stand-in implements only what the managers call, with the wire format
+ * the SDK expects, so benchmarks measure the client side rather than a service:
+ *  - S3 (path-style): buckets, objects with ranged GET and HEAD, ListObjectsV2
+ *    with prefixes, delimiters and continuation tokens, and multipart uploads
+ *  - DynamoDB: CreateTable, DescribeTable, PutItem, GetItem, DeleteItem and
+ *    Scan with Limit and ExclusiveStartKey, for tables keyed by a string "id"
+ *  - EC2: DescribeInstances over a generated fleet, paged by MaxResults
+ */
+
+#ifndef AWSEXAMPLES_BENCHMARKS_STANDINS_H
+#define AWSEXAMPLES_BENCHMARKS_STANDINS_H
+
+#include "MockHttpServer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace standins {
+
+/**
+ * @class S3StandIn
+ * @brief Path-style S3 endpoint keeping objects in memory
+ */
+class S3StandIn {
+public:
+    MockHttpServer::Response Handle(const MockHttpServer::Request& request) {
+        // The path is "/bucket" or "/bucket/key"
+        const std::size_t slash = request.path.find('/', 1);
+        const std::string bucket = request.path.substr(1, slash == std::string::npos ? std::string::npos : slash - 1);
+        const std::string key = slash == std::string::npos ? "" : request.path.substr(slash + 1);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (key.empty()) {
+            if (request.method == "PUT") {
+                buckets[bucket];
+                return {};
+            }
+            if (request.method == "DELETE") {
+                buckets.erase(bucket);
+                return Empty(204);
+            }
+            if (request.method == "GET" && request.query.count("list-type") != 0) {
+                return List(bucket, request.query);
+            }
+            return Error(400, "NotImplemented");
+        }
+
+        auto found = buckets.find(bucket);
+        if (found == buckets.end()) {
+            return Error(404, "NoSuchBucket");
+        }
+        auto& objects = found->second;
+        auto uploadId = request.query.find("uploadId");
+
+        if (request.method == "POST" && request.query.count("uploads") != 0) {
+            const std::string id = std::to_string(++nextVersion);
+            uploads[id];
+            MockHttpServer::Response response;
+            response.body = "<InitiateMultipartUploadResult><Bucket>" + bucket + "</Bucket><Key>" + key +
+                            "</Key><UploadId>" + id + "</UploadId></InitiateMultipartUploadResult>";
+            return response;
+        }
+        if (uploadId != request.query.end()) {
+            auto upload = uploads.find(uploadId->second);
+            if (upload == uploads.end()) {
+                return Error(404, "NoSuchUpload");
+            }
+            if (request.method == "PUT") {
+                const std::string eTag = "\"part-" + std::to_string(++nextVersion) + "\"";
+                upload->second[std::atoi(request.query.at("partNumber").c_str())] = request.body;
+                MockHttpServer::Response response;
+                response.headers.emplace_back("ETag", eTag);
+                return response;
+            }
+            if (request.method == "DELETE") {
+                uploads.erase(upload);
+                return Empty(204);
+            }
+            // CompleteMultipartUpload: concatenate the parts in part-number order
+            std::string content;
+            for (const auto& part : upload->second) {
+                content += part.second;
+            }
+            uploads.erase(upload);
+            const std::string eTag = Store(objects, key, std::move(content));
+            MockHttpServer::Response response;
+            response.body = "<CompleteMultipartUploadResult><Bucket>" + bucket + "</Bucket><Key>" + key +
+                            "</Key><ETag>" + eTag + "</ETag></CompleteMultipartUploadResult>";
+            return response;
+        }
+
+        if (request.method == "PUT") {
+            MockHttpServer::Response response;
+            response.headers.emplace_back("ETag", Store(objects, key, request.body));
+            return response;
+        }
+        if (request.method == "DELETE") {
+            objects.erase(key);
+            return Empty(204);
+        }
+
+        auto object = objects.find(key);
+        if (object == objects.end()) {
+            return Error(404, "NoSuchKey");
+        }
+        // Copy the data without holding the lock, so concurrent GETs proceed in parallel
+        const std::shared_ptr<const std::string> data = object->second.content;
+        const std::string eTag = object->second.eTag;
+        lock.unlock();
+        const std::string& content = *data;
+        MockHttpServer::Response response;
+        response.contentType = "application/octet-stream";
+        response.headers.emplace_back("ETag", eTag);
+        response.headers.emplace_back("Last-Modified", "Thu, 01 Jan 2026 00:00:00 GMT");
+        if (request.method == "HEAD") {
+            response.contentLength = static_cast<long long>(content.size());
+            return response;
+        }
+
+        // Ranges have the form "bytes=first-last"
+        auto range = request.headers.find("range");
+        if (range != request.headers.end() && range->second.rfind("bytes=", 0) == 0) {
+            std::size_t first = std::strtoull(range->second.c_str() + 6, nullptr, 10);
+            const std::size_t dash = range->second.find('-');
+            std::size_t last = content.empty() ? 0 : content.size() - 1;
+            if (dash != std::string::npos && dash + 1 < range->second.size()) {
+                last = std::min<std::size_t>(last, std::strtoull(range->second.c_str() + dash + 1, nullptr, 10));
+            }
+            if (first >= content.size()) {
+                return Error(416, "InvalidRange");
+            }
+            response.status = 206;
+            response.headers.emplace_back("Content-Range", "bytes " + std::to_string(first) + "-" +
+                                                               std::to_string(last) + "/" +
+                                                               std::to_string(content.size()));
+            response.body = content.substr(first, last - first + 1);
+            return response;
+        }
+        response.body = content;
+        return response;
+    }
+
+private:
+    struct Object {
+        std::shared_ptr<const std::string> content;  ///< Object data
+        std::string eTag;                            ///< Quoted ETag, unique per write
+    };
+    using Bucket = std::map<std::string, Object>;
+
+    std::string Store(Bucket& objects, const std::string& key, std::string content) {
+        Object& object = objects[key];
+        object.content = std::make_shared<const std::string>(std::move(content));
+        object.eTag = "\"" + std::to_string(++nextVersion) + "\"";
+        return object.eTag;
+    }
+
+    MockHttpServer::Response List(const std::string& bucket, const std::map<std::string, std::string>& query) {
+        auto found = buckets.find(bucket);
+        if (found == buckets.end()) {
+            return Error(404, "NoSuchBucket");
+        }
+        const auto& objects = found->second;
+        auto Param = [&query](const std::string& name) {
+            auto value = query.find(name);
+            return value == query.end() ? std::string() : value->second;
+        };
+        const std::string prefix = Param("prefix");
+        const std::string delimiter = Param("delimiter");
+        const std::string token = Param("continuation-token");
+        const std::size_t maxKeys = query.count("max-keys") != 0 ? std::strtoul(Param("max-keys").c_str(), nullptr, 10)
+                                                                  : 1000;
+
+        // Continuation tokens are the last key or common prefix of the previous page
+        auto object = token.empty() ? objects.lower_bound(prefix) : objects.upper_bound(token);
+        auto SkipGroup = [&](const std::string& group) {
+            while (object != objects.end() && object->first.compare(0, group.size(), group) == 0) {
+                ++object;
+            }
+        };
+        if (!delimiter.empty() && token.size() >= delimiter.size() &&
+            token.compare(token.size() - delimiter.size(), delimiter.size(), delimiter) == 0) {
+            SkipGroup(token);
+        }
+
+        std::string contents;
+        std::string commonPrefixes;
+        std::string lastReturned;
+        std::size_t count = 0;
+        while (object != objects.end() && object->first.compare(0, prefix.size(), prefix) == 0 && count < maxKeys) {
+            const std::size_t split =
+                delimiter.empty() ? std::string::npos : object->first.find(delimiter, prefix.size());
+            if (split != std::string::npos) {
+                lastReturned = object->first.substr(0, split + delimiter.size());
+                commonPrefixes += "<CommonPrefixes><Prefix>" + lastReturned + "</Prefix></CommonPrefixes>";
+                SkipGroup(lastReturned);
+            } else {
+                lastReturned = object->first;
+                contents += "<Contents><Key>" + object->first + "</Key>"
+                            "<LastModified>2026-01-01T00:00:00.000Z</LastModified><ETag>" + object->second.eTag +
+                            "</ETag><Size>" + std::to_string(object->second.content->size()) +
+                            "</Size><StorageClass>STANDARD</StorageClass></Contents>";
+                ++object;
+            }
+            ++count;
+        }
+        const bool truncated = object != objects.end() && object->first.compare(0, prefix.size(), prefix) == 0;
+
+        MockHttpServer::Response response;
+        response.body = "<ListBucketResult><Name>" + bucket + "</Name><Prefix>" + prefix + "</Prefix><KeyCount>" +
+                        std::to_string(count) + "</KeyCount><MaxKeys>" + std::to_string(maxKeys) +
+                        "</MaxKeys><IsTruncated>" + (truncated ? "true" : "false") + "</IsTruncated>" + contents +
+                        commonPrefixes;
+        if (truncated) {
+            response.body += "<NextContinuationToken>" + lastReturned + "</NextContinuationToken>";
+        }
+        response.body += "</ListBucketResult>";
+        return response;
+    }
+
+    static MockHttpServer::Response Empty(int status) {
+        MockHttpServer::Response response;
+        response.status = status;
+        return response;
+    }
+
+    static MockHttpServer::Response Error(int status, const std::string& code) {
+        MockHttpServer::Response response;
+        response.status = status;
+        response.body = "<Error><Code>" + code + "</Code><Message>Stand-in error</Message></Error>";
+        return response;
+    }
+
+    std::mutex mutex;                                             ///< Guards the members below
+    std::map<std::string, Bucket> buckets;                        ///< Objects by bucket and key
+    std::map<std::string, std::map<int, std::string>> uploads;    ///< Parts of open multipart uploads
+    unsigned long long nextVersion = 0;                           ///< Source of ETags and upload IDs
+};
+
+/**
+ * @class DynamoDBStandIn
+ * @brief DynamoDB endpoint keeping items in memory as their JSON encoding
+ */
+class DynamoDBStandIn {
+public:
+    MockHttpServer::Response Handle(const MockHttpServer::Request& request) {
+        MockHttpServer::Response response;
+        response.contentType = "application/x-amz-json-1.0";
+        auto target = request.headers.find("x-amz-target");
+        const std::string operation = target == request.headers.end() ? "" : target->second;
+        const std::string tableName = JsonString(request.body, "TableName");
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (operation == "DynamoDB_20120810.CreateTable") {
+            tables[tableName];
+            response.body = "{\"TableDescription\":{\"TableName\":\"" + tableName + "\",\"TableStatus\":\"ACTIVE\"}}";
+            return response;
+        }
+        auto table = tables.find(tableName);
+        if (table == tables.end()) {
+            response.status = 400;
+            response.body = "{\"__type\":\"com.amazonaws.dynamodb.v20120810#ResourceNotFoundException\","
+                            "\"message\":\"Requested resource not found\"}";
+            return response;
+        }
+        auto& items = table->second;
+
+        if (operation == "DynamoDB_20120810.DescribeTable") {
+            response.body = "{\"Table\":{\"TableName\":\"" + tableName +
+                            "\",\"TableStatus\":\"ACTIVE\",\"ItemCount\":" + std::to_string(items.size()) + "}}";
+        } else if (operation == "DynamoDB_20120810.PutItem") {
+            const std::string item = JsonObject(request.body, "Item");
+            items[JsonString(item, "id")] = item;
+            response.body = "{}";
+        } else if (operation == "DynamoDB_20120810.GetItem") {
+            auto item = items.find(JsonString(JsonObject(request.body, "Key"), "id"));
+            response.body = item == items.end() ? "{}" : "{\"Item\":" + item->second + "}";
+        } else if (operation == "DynamoDB_20120810.DeleteItem") {
+            items.erase(JsonString(JsonObject(request.body, "Key"), "id"));
+            response.body = "{}";
+        } else if (operation == "DynamoDB_20120810.Scan") {
+            const std::string startKey = JsonString(JsonObject(request.body, "ExclusiveStartKey"), "id");
+            const std::size_t limitAt = request.body.find("\"Limit\":");
+            const std::size_t limit = limitAt == std::string::npos
+                                          ? items.size()
+                                          : std::strtoul(request.body.c_str() + limitAt + 8, nullptr, 10);
+            auto item = startKey.empty() ? items.begin() : items.upper_bound(startKey);
+            std::string page;
+            std::size_t count = 0;
+            std::string lastKey;
+            for (; item != items.end() && count < limit; ++item, ++count) {
+                page += (count == 0 ? "" : ",") + item->second;
+                lastKey = item->first;
+            }
+            response.body = "{\"Count\":" + std::to_string(count) + ",\"ScannedCount\":" + std::to_string(count) +
+                            ",\"Items\":[" + page + "]";
+            if (item != items.end()) {
+                response.body += ",\"LastEvaluatedKey\":{\"id\":{\"S\":\"" + lastKey + "\"}}";
+            }
+            response.body += "}";
+        } else {
+            response.status = 400;
+            response.body = "{\"__type\":\"com.amazon.coral.validate#ValidationException\","
+                            "\"message\":\"Unsupported\"}";
+        }
+        return response;
+    }
+
+private:
+    // Extract the object value of a member of a JSON body
+    static std::string JsonObject(const std::string& body, const std::string& name) {
+        std::size_t start = body.find("\"" + name + "\":{");
+        if (start == std::string::npos) {
+            return "";
+        }
+        start = body.find('{', start);
+        int depth = 0;
+        bool quoted = false;
+        for (std::size_t i = start; i < body.size(); ++i) {
+            if (body[i] == '\\') {
+                ++i;
+            } else if (body[i] == '"') {
+                quoted = !quoted;
+            } else if (!quoted && body[i] == '{') {
+                ++depth;
+            } else if (!quoted && body[i] == '}' && --depth == 0) {
+                return body.substr(start, i - start + 1);
+            }
+        }
+        return "";
+    }
+
+    // Extract a string value, either a plain member or a {"S": ...} attribute
+    static std::string JsonString(const std::string& body, const std::string& name) {
+        for (const std::string& pattern : {"\"" + name + "\":\"", "\"" + name + "\":{\"S\":\""}) {
+            const std::size_t start = body.find(pattern);
+            if (start != std::string::npos) {
+                const std::size_t end = body.find('"', start + pattern.size());
+                return body.substr(start + pattern.size(), end - start - pattern.size());
+            }
+        }
+        return "";
+    }
+
+    std::mutex mutex;                                                  ///< Guards the tables
+    std::map<std::string, std::map<std::string, std::string>> tables;  ///< Item JSON by table and id
+};
+
+/**
+ * @class EC2StandIn
+ * @brief EC2 endpoint describing a generated fleet of running instances
+ */
+class EC2StandIn {
+public:
+    /**
+     * @brief Set the number of instances DescribeInstances returns
+     */
+    void SetFleetSize(std::size_t size) { fleetSize = size; }
+
+    MockHttpServer::Response Handle(const MockHttpServer::Request& request) {
+        MockHttpServer::Response response;
+        auto action = request.params.find("Action");
+        if (action == request.params.end() || action->second != "DescribeInstances") {
+            response.status = 400;
+            response.body = "<Response><Errors><Error><Code>InvalidAction</Code><Message>Unsupported</Message>"
+                            "</Error></Errors><RequestID>stand-in</RequestID></Response>";
+            return response;
+        }
+
+        auto Param = [&request](const std::string& name, std::size_t fallback) {
+            auto value = request.params.find(name);
+            return value == request.params.end() ? fallback : std::strtoul(value->second.c_str(), nullptr, 10);
+        };
+        const std::size_t size = fleetSize;
+        const std::size_t offset = Param("NextToken", 0);
+        const std::size_t end = std::min(size, offset + Param("MaxResults", 1000));
+
+        std::string items;
+        char instanceId[32];
+        for (std::size_t i = offset; i < end; ++i) {
+            std::snprintf(instanceId, sizeof(instanceId), "i-%017zx", i);
+            items += std::string("<item><instanceId>") + instanceId + "</instanceId>"
+                     "<instanceState><code>16</code><name>" + (i % 10 == 0 ? "stopped" : "running") +
+                     "</name></instanceState><instanceType>" + (i % 3 == 0 ? "m5.large" : "t3.micro") +
+                     "</instanceType><launchTime>2026-01-01T00:00:00.000Z</launchTime>"
+                     "<tagSet><item><key>team</key><value>team-" + std::to_string(i % 8) +
+                     "</value></item></tagSet></item>";
+        }
+        response.body = "<DescribeInstancesResponse xmlns=\"http://ec2.amazonaws.com/doc/2016-11-15/\">"
+                        "<requestId>stand-in</requestId><reservationSet><item><reservationId>r-stand-in</reservationId>"
+                        "<instancesSet>" + items + "</instancesSet></item></reservationSet>";
+        if (end < size) {
+            response.body += "<nextToken>" + std::to_string(end) + "</nextToken>";
+        }
+        response.body += "</DescribeInstancesResponse>";
+        return response;
+    }
+
+private:
+    std::atomic<std::size_t> fleetSize{100};  ///< Instances in the fleet
+};
+
+}  // namespace standins
+
+#endif  // AWSEXAMPLES_BENCHMARKS_STANDINS_H
@@ -0,0 +1,36 @@
+/**
+ * @file AsyncTypes.h
+ * @brief Callback types shared by the asynchronous manager operations
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_ASYNCTYPES_H
+#define AWSEXAMPLES_ASYNCTYPES_H
+
+#include <functional>
+#include <string>
+
+namespace awsexamples {
+
+/**
+ * @brief Callback receiving whether an asynchronous operation succeeded
+ *
+ * Completion callbacks run on a thread of the client's executor (see
+ * utils::ConfigureClient), so they must be thread-safe and should return quickly.
+ * They must not block on another asynchronous call made with the same client:
+ * with a bounded thread pool that call may be queued behind the callback itself.
+ */
+using CompletionCallback = std::function<void(bool success)>;
+
+/**
+ * @brief Callback receiving the string result of an asynchronous operation
+ *
+ * The string is empty if the operation failed. The threading rules of
+ * CompletionCallback apply.
+ */
+using StringCallback = std::function<void(const std::string& result)>;
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_ASYNCTYPES_H
@@ -11,26 +11,138 @@
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProvider.h>
 #include <aws/core/client/ClientConfiguration.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 
 namespace awsexamples {
 namespace utils {
 
+/**
+ * @struct ClientOptions
+ * @brief Tuning knobs for SDK clients, loadable from a file or the environment
+ *
+ * Every field can be set in a configuration file as "name = value" or through an
+ * environment variable named AWSEXAMPLES_ followed by the upper-cased name, e.g.
+ * max_connections / AWSEXAMPLES_MAX_CONNECTIONS. Option names are listed next to
+ * each field.
+ *
+ * retry_mode and max_attempts only affect clients built directly from the
+ * configuration: the managers turn SDK retries off and retry through their
+ * RetryController.
+ */
+struct ClientOptions {
+    std::string region = "us-west-2";  ///< region: AWS region to use
+    Aws::Utils::Logging::LogLevel logLevel = Aws::Utils::Logging::LogLevel::Info;  ///< log_level: off, fatal, error, warn, info, debug or trace
+    long connectTimeoutMs = 30000;     ///< connect_timeout_ms: TCP connect timeout
+    long requestTimeoutMs = 30000;     ///< request_timeout_ms: Timeout waiting for data on an open connection
+    unsigned maxConnections = 25;      ///< max_connections: HTTP connection pool size
+    unsigned executorThreads = 0;      ///< executor_threads: Threads running async calls; 0 uses maxConnections
+    bool tcpKeepAlive = true;          ///< tcp_keep_alive: Send TCP keep-alive probes on idle connections
+    unsigned long tcpKeepAliveIntervalMs = 30000;  ///< tcp_keep_alive_interval_ms: Interval between probes
+    unsigned long lowSpeedLimit = 1;   ///< low_speed_limit: Abort transfers slower than this many bytes/s
+    std::int64_t readRateLimit = 0;    ///< read_rate_limit: Download bandwidth cap in bytes/s; 0 is unlimited
+    std::int64_t writeRateLimit = 0;   ///< write_rate_limit: Upload bandwidth cap in bytes/s; 0 is unlimited
+    std::string retryMode;             ///< retry_mode: legacy, standard, adaptive or none; empty keeps the SDK's choice
+    long maxAttempts = 3;              ///< max_attempts: Attempts per request, including the first, for retry_mode
+    bool verifySSL = true;             ///< verify_ssl: Verify server certificates
+    std::string endpointOverride;      ///< endpoint_override: Custom endpoint; an http:// URL selects plain HTTP
+    bool http2 = true;                 ///< http2: Negotiate HTTP/2 over TLS where the endpoint supports it
+};
+
 /**
  * @brief Configure client with custom settings
  * 
  * @param region AWS region to use
- * @param logLevel AWS SDK log level
  * @param timeoutMs Connection timeout in milliseconds
  * @param maxConnections Maximum number of connections to maintain
  * @return Aws::Client::ClientConfiguration Configured client settings
  */
 Aws::Client::ClientConfiguration ConfigureClient(
     const std::string& region = "us-west-2",
-    Aws::Utils::Logging::LogLevel logLevel = Aws::Utils::Logging::LogLevel::Info,
     long timeoutMs = 30000,
     unsigned maxConnections = 25);
 
+/**
+ * @brief Configure client with custom settings, ignoring a log level
+ * 
+ * @deprecated @p logLevel has no effect: logging is process-wide and follows the
+ * SDKOptions the AwsApiInitializer is given. Pass the level to
+ * CreateDefaultSDKOptions and call ConfigureClient(region, timeoutMs, maxConnections).
+ * 
+ * @param region AWS region to use
+ * @param logLevel Ignored
+ * @param timeoutMs Connection timeout in milliseconds
+ * @param maxConnections Maximum number of connections to maintain
+ * @return Aws::Client::ClientConfiguration Configured client settings
+ */
+[[deprecated("logLevel has no effect; pass it to CreateDefaultSDKOptions")]]
+Aws::Client::ClientConfiguration ConfigureClient(
+    const std::string& region,
+    Aws::Utils::Logging::LogLevel logLevel,
+    long timeoutMs = 30000,
+    unsigned maxConnections = 25);
+
+/**
+ * @brief Build a client configuration from a full set of tuning options
+ * 
+ * Asynchronous operations run on a pooled executor with options.executorThreads
+ * threads; the pool starts with the first asynchronous call, so a configuration
+ * that ends up sharing a cached client starts no threads. options.logLevel is
+ * not applied here, since logging is process-wide; pass it to
+ * CreateDefaultSDKOptions for the AwsApiInitializer instead.
+ * 
+ * @param options The tuning options to apply
+ * @return Aws::Client::ClientConfiguration Configured client settings
+ */
+Aws::Client::ClientConfiguration ConfigureClient(const ClientOptions& options);
+
+/**
+ * @brief Set one client option by name
+ * 
+ * @param options The options to update
+ * @param name Option name, e.g. "max_connections"
+ * @param value Option value as text
+ * @return bool True if the name is known and the value is valid, false otherwise
+ */
+bool SetClientOption(ClientOptions& options, const std::string& name, const std::string& value);
+
+/**
+ * @brief Apply the settings of a configuration file to client options
+ * 
+ * The file holds one "name = value" pair per line; blank lines and lines
+ * starting with '#' are ignored. Invalid lines are reported and skipped.
+ * 
+ * @param path Path of the configuration file
+ * @param options The options to update
+ * @return bool True if the file was read and every line was valid, false otherwise
+ */
+bool ApplyClientOptionsFile(const std::string& path, ClientOptions& options);
+
+/**
+ * @brief Apply AWSEXAMPLES_* environment variables to client options
+ * 
+ * @param options The options to update
+ * @return bool True if every variable that is set holds a valid value, false otherwise
+ */
+bool ApplyClientOptionsEnvironment(ClientOptions& options);
+
+/**
+ * @brief Load client options from defaults, a configuration file and the environment
+ * 
+ * Starts from the defaults, then applies the file named by AWSEXAMPLES_CONFIG_FILE
+ * (if set) and finally any AWSEXAMPLES_* variables, so the environment wins.
+ * 
+ * @return ClientOptions The resulting options
+ */
+ClientOptions LoadClientOptions();
+
 /**
  * @brief Create default SDK options
  * 
@@ -40,12 +152,119 @@ Aws::Client::ClientConfiguration ConfigureClient(
 Aws::SDKOptions CreateDefaultSDKOptions(
     Aws::Utils::Logging::LogLevel logLevel = Aws::Utils::Logging::LogLevel::Info);
 
+/**
+ * @class ClientRegistry
+ * @brief Process-wide cache of shared SDK clients keyed by client type and configuration
+ *
+ * SDK clients are thread-safe and expensive to build: each one resolves a
+ * credential provider chain and owns an HTTP connection pool with its own TLS
+ * sessions. The registry hands out one shared client per client type and
+ * configuration, so any number of managers built from the same settings share a
+ * single set of connections.
+ *
+ * Configurations are compared by value on every setting that changes how a client
+ * behaves (region, endpoint, FIPS and dual-stack, user agent, timeouts, connection
+ * limits, TLS, proxy including credentials, redirects, keep-alive, HTTP library,
+ * profile and IMDS settings) and on their retry strategy, executor and rate
+ * limiters. Those are compared by their settings (retry mode and attempts,
+ * executor threads, bandwidth) when they are the SDK's defaults or were made by
+ * ConfigureClient, and by identity otherwise.
+ *
+ * Clients must be released before Aws::ShutdownAPI. AwsApiInitializer clears the
+ * registry on destruction; code that calls ShutdownAPI itself must call Clear() first.
+ */
+class ClientRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     *
+     * @return ClientRegistry& The registry instance
+     */
+    static ClientRegistry& Instance();
+
+    /**
+     * @brief Get the shared client for a configuration, constructing it on first use
+     *
+     * @tparam ClientT SDK client type, constructible from a ClientConfiguration
+     * @param config Configuration the client is created with
+     * @return std::shared_ptr<ClientT> The shared client
+     */
+    template <typename ClientT>
+    std::shared_ptr<ClientT> Get(const Aws::Client::ClientConfiguration& config) {
+        return GetOrCreate<ClientT>(config, std::string(), [&config]() {
+            return Aws::MakeShared<ClientT>("ClientRegistry", config);
+        });
+    }
+
+    /**
+     * @brief Get a shared client, building it with a custom factory on first use
+     *
+     * Use this for clients that take constructor arguments beyond the configuration;
+     * @p variant must distinguish every combination of those arguments.
+     *
+     * @tparam ClientT SDK client type
+     * @tparam Factory Callable returning std::shared_ptr<ClientT>
+     * @param config Configuration the client is created with
+     * @param variant Key suffix describing the extra constructor arguments
+     * @param factory Builds the client if no matching one exists yet
+     * @return std::shared_ptr<ClientT> The shared client
+     */
+    template <typename ClientT, typename Factory>
+    std::shared_ptr<ClientT> GetOrCreate(const Aws::Client::ClientConfiguration& config,
+                                         const std::string& variant,
+                                         Factory&& factory) {
+        Key key(std::type_index(typeid(ClientT)), ConfigurationKey(config) + "|" + variant);
+
+        // Construct under the lock so concurrent callers never build duplicate clients
+        std::lock_guard<std::mutex> lock(mutex);
+        auto existing = clients.find(key);
+        if (existing != clients.end()) {
+            return std::static_pointer_cast<ClientT>(existing->second);
+        }
+        std::shared_ptr<ClientT> client = factory();
+        clients.emplace(std::move(key), client);
+        return client;
+    }
+
+    /**
+     * @brief Release every cached client
+     *
+     * Clients still referenced by managers stay alive until those managers are destroyed.
+     */
+    void Clear();
+
+    /**
+     * @brief Get the number of cached clients
+     *
+     * @return std::size_t Number of distinct clients currently held
+     */
+    std::size_t Size() const;
+
+private:
+    using Key = std::pair<std::type_index, std::string>;
+
+    mutable std::mutex mutex;                        ///< Guards clients
+    std::map<Key, std::shared_ptr<void>> clients;    ///< Cached clients by type and configuration
+
+    ClientRegistry() = default;
+
+    /**
+     * @brief Serialize the settings of a configuration that identify a client
+     *
+     * @param config The configuration to describe
+     * @return std::string Key string; equal for interchangeable configurations
+     */
+    static std::string ConfigurationKey(const Aws::Client::ClientConfiguration& config);
+};
+
 /**
  * @class AwsApiInitializer
  * @brief RAII wrapper for AWS SDK initialization/shutdown
  * 
  * This class handles the initialization and shutdown of the AWS SDK
- * automatically when it is constructed and destroyed.
+ * automatically when it is constructed and destroyed. It also sets the
+ * library's Logger to the SDK log level and flushes it on shutdown, and
+ * installs the monitoring hook that feeds HTTP request timings to the Tracer.
  */
 class AwsApiInitializer {
 public:
@@ -57,7 +276,7 @@ public:
     explicit AwsApiInitializer(const Aws::SDKOptions& options = CreateDefaultSDKOptions());
     
     /**
-     * @brief Destructor that shuts down AWS SDK
+     * @brief Destructor that releases the shared clients and shuts down AWS SDK
      */
     ~AwsApiInitializer();
     
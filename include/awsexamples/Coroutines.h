@@ -0,0 +1,265 @@
+/**
+ * @file Coroutines.h
+ * @brief C++20 co_await-able wrappers for the asynchronous manager operations
+ * @author AWS Example Team
+ * @date 2026-10-16
+ *
+ * This header is only active when compiled as C++20 (or later) with coroutine
+ * support; the rest of the library keeps building as C++17.
+ */
+
+#ifndef AWSEXAMPLES_COROUTINES_H
+#define AWSEXAMPLES_COROUTINES_H
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/EC2Manager.h"
+#include "awsexamples/S3Manager.h"
+#include <aws/core/utils/threading/Executor.h>
+#include <coroutine>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace awsexamples {
+namespace coro {
+
+/// Executor a coroutine is resumed on; nullptr resumes on the SDK thread that completed the request
+using ResumeExecutor = std::shared_ptr<Aws::Utils::Threading::Executor>;
+
+/**
+ * @class Awaitable
+ * @brief Awaitable that starts a callback-based operation when it is co_awaited
+ *
+ * The awaiting coroutine is suspended until the operation's completion callback
+ * fires; no thread is blocked in the meantime. The coroutine is then resumed on
+ * the given executor, or directly on the SDK's completion thread if none is given
+ * (or the executor rejects the task). Code resumed on the SDK's thread should not
+ * block, since it holds up one of the client's executor threads.
+ *
+ * @tparam T Result type passed to the completion callback
+ */
+template <typename T>
+class Awaitable {
+public:
+    /// Starts the operation, given the callback that must be invoked on completion
+    using Starter = std::function<void(std::function<void(const T&)>)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param start Callable that starts the operation
+     * @param executor Executor the awaiting coroutine is resumed on
+     */
+    Awaitable(Starter start, ResumeExecutor executor)
+        : start(std::move(start)), executor(std::move(executor)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The coroutine may be resumed, destroying this awaitable, on another thread
+        // before the starter returns; no member may be touched after calling it
+        Starter startOperation = std::move(start);
+        startOperation([this, handle, resumeOn = std::move(executor)](const T& value) {
+            result = value;
+            if (!resumeOn || !resumeOn->Submit([handle]() { handle.resume(); })) {
+                handle.resume();
+            }
+        });
+    }
+
+    T await_resume() { return std::move(result); }
+
+private:
+    Starter start;            ///< Starts the operation; moved out when awaited
+    ResumeExecutor executor;  ///< Where the awaiting coroutine is resumed
+    T result{};               ///< Value delivered by the completion callback
+};
+
+/**
+ * @brief Upload a file to S3 from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param bucketName The name of the bucket to upload to
+ * @param keyName The key (object name) to assign to the uploaded file
+ * @param filePath Local path to the file to be uploaded
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<bool> Yields true if the file was uploaded successfully
+ */
+inline Awaitable<bool> UploadFile(S3Manager& manager,
+                                  std::string bucketName,
+                                  std::string keyName,
+                                  std::string filePath,
+                                  ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, bucketName = std::move(bucketName), keyName = std::move(keyName),
+         filePath = std::move(filePath)](auto done) {
+            manager.UploadFileAsync(bucketName, keyName, filePath, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Upload text content to S3 from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param bucketName The name of the bucket to upload to
+ * @param keyName The key (object name) to assign to the uploaded content
+ * @param content The text content to upload
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<bool> Yields true if the content was uploaded successfully
+ */
+inline Awaitable<bool> UploadText(S3Manager& manager,
+                                  std::string bucketName,
+                                  std::string keyName,
+                                  std::string content,
+                                  ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, bucketName = std::move(bucketName), keyName = std::move(keyName),
+         content = std::move(content)](auto done) {
+            manager.UploadTextAsync(bucketName, keyName, content, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Download a file from S3 from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param bucketName The name of the bucket to download from
+ * @param keyName The key (object name) of the file to download
+ * @param localPath Local path where the file should be saved
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<bool> Yields true if the file was downloaded successfully
+ */
+inline Awaitable<bool> DownloadFile(S3Manager& manager,
+                                    std::string bucketName,
+                                    std::string keyName,
+                                    std::string localPath,
+                                    ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, bucketName = std::move(bucketName), keyName = std::move(keyName),
+         localPath = std::move(localPath)](auto done) {
+            manager.DownloadFileAsync(bucketName, keyName, localPath, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Add an item to a DynamoDB table from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param tableName The name of the table to add the item to
+ * @param id The ID to use as the hash key
+ * @param name A name value to store in the item
+ * @param age An age value to store in the item
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<bool> Yields true if the item was added successfully
+ */
+inline Awaitable<bool> PutItem(DynamoDBManager& manager,
+                               std::string tableName,
+                               std::string id,
+                               std::string name,
+                               int age,
+                               ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, tableName = std::move(tableName), id = std::move(id), name = std::move(name),
+         age](auto done) {
+            manager.PutItemAsync(tableName, id, name, age, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Retrieve an item from a DynamoDB table from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param tableName The name of the table to query
+ * @param id The ID of the item to retrieve
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<GetItemResult> Yields the request status and the item, if found
+ */
+inline Awaitable<GetItemResult> GetItem(DynamoDBManager& manager,
+                                        std::string tableName,
+                                        std::string id,
+                                        ResumeExecutor executor = nullptr) {
+    return Awaitable<GetItemResult>(
+        [&manager, tableName = std::move(tableName), id = std::move(id)](auto done) {
+            manager.GetItemAsync(tableName, id, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Describe EC2 instances from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param instanceIds The IDs of the instances to describe, or empty for all instances
+ * @param executor Executor to resume on, or nullptr to resume on the SDK's thread
+ * @return Awaitable<InstancesResult> Yields the request status and the instances found
+ */
+inline Awaitable<InstancesResult> DescribeInstances(EC2Manager& manager,
+                                                    std::vector<std::string> instanceIds,
+                                                    ResumeExecutor executor = nullptr) {
+    return Awaitable<InstancesResult>(
+        [&manager, instanceIds = std::move(instanceIds)](auto done) {
+            manager.DescribeInstancesAsync(instanceIds, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Wait for a DynamoDB table to reach a state from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param tableName The name of the table to check
+ * @param targetState The state to wait for (e.g. "ACTIVE", "DELETED")
+ * @param options Polling schedule and timeout
+ * @param executor Executor to resume on, or nullptr to resume on the thread that completed the wait
+ * @return Awaitable<bool> Yields true if the table reached the target state
+ */
+inline Awaitable<bool> WaitForTableState(DynamoDBManager& manager,
+                                         std::string tableName,
+                                         std::string targetState,
+                                         WaitOptions options = WaitOptions(),
+                                         ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, tableName = std::move(tableName), targetState = std::move(targetState),
+         options](auto done) {
+            manager.WaitForTableStateAsync(tableName, targetState, options, std::move(done));
+        },
+        std::move(executor));
+}
+
+/**
+ * @brief Wait for an EC2 instance to reach a state from a coroutine
+ *
+ * @param manager The manager to use; must outlive the operation
+ * @param instanceId The ID of the instance to check
+ * @param targetState The state to wait for (e.g. "running", "stopped")
+ * @param options Polling schedule and timeout
+ * @param executor Executor to resume on, or nullptr to resume on the thread that completed the wait
+ * @return Awaitable<bool> Yields true if the instance reached the target state
+ */
+inline Awaitable<bool> WaitForInstanceState(EC2Manager& manager,
+                                            std::string instanceId,
+                                            std::string targetState,
+                                            WaitOptions options = WaitOptions(),
+                                            ResumeExecutor executor = nullptr) {
+    return Awaitable<bool>(
+        [&manager, instanceId = std::move(instanceId), targetState = std::move(targetState),
+         options](auto done) {
+            manager.WaitForInstanceStateAsync(instanceId, targetState, options, std::move(done));
+        },
+        std::move(executor));
+}
+
+}  // namespace coro
+}  // namespace awsexamples
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // AWSEXAMPLES_COROUTINES_H
@@ -0,0 +1,164 @@
+/**
+ * @file DynamoDBBatchWriter.h
+ * @brief DynamoDBBatchWriter class declaration for bulk DynamoDB writes
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_DYNAMODBBATCHWRITER_H
+#define AWSEXAMPLES_DYNAMODBBATCHWRITER_H
+
+#include "awsexamples/DynamoDBManager.h"
+#include <aws/dynamodb/model/WriteRequest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @struct BatchWriterOptions
+ * @brief Tuning parameters for DynamoDBBatchWriter
+ */
+struct BatchWriterOptions {
+    unsigned maxInFlight = 4;  ///< Number of BatchWriteItem calls allowed in flight at once
+    int maxAttempts = 10;      ///< Submissions per batch, including resubmissions of unprocessed items
+    std::chrono::milliseconds baseBackoff{50};   ///< Backoff cap for the first resubmission
+    std::chrono::milliseconds maxBackoff{5000};  ///< Upper bound on any single resubmission backoff
+};
+
+/**
+ * @struct BatchWriterStats
+ * @brief Counters describing the work done by a DynamoDBBatchWriter
+ */
+struct BatchWriterStats {
+    std::uint64_t itemsWritten = 0;  ///< Puts and deletes acknowledged by DynamoDB
+    std::uint64_t itemsFailed = 0;   ///< Puts and deletes abandoned after errors or retries
+    std::uint64_t requests = 0;      ///< BatchWriteItem calls issued, including retries
+    std::uint64_t retries = 0;       ///< Calls that resubmitted unprocessed or throttled items
+    double elapsedSeconds = 0.0;     ///< Time from the first write to the last completion
+    double itemsPerSecond = 0.0;     ///< Average write throughput over elapsedSeconds
+};
+
+/**
+ * @class DynamoDBBatchWriter
+ * @brief Streams puts and deletes into 25-item BatchWriteItem calls
+ *
+ * Writes are buffered into batches of up to 25 requests, which a small pool of
+ * worker threads sends concurrently. Each request goes through the manager's
+ * RetryController, which retries rejected requests. Items DynamoDB returns as
+ * UnprocessedItems are reported to the controller as throttling, which slows
+ * every BatchWriteItem of the service, and are resubmitted after a jittered
+ * exponential backoff. Put() and Delete() block while maxInFlight batches are
+ * already queued, so memory use stays bounded however many items are written.
+ *
+ * BatchWriteItem rejects batches that touch the same key twice, so callers should
+ * not write the same key more than once in quick succession. The DynamoDBManager
+ * passed to the constructor must outlive the writer.
+ */
+class DynamoDBBatchWriter {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param manager The manager whose client is used for all requests
+     * @param tableName The name of the table to write to
+     * @param options Concurrency and retry settings
+     */
+    DynamoDBBatchWriter(DynamoDBManager& manager,
+                        const std::string& tableName,
+                        const BatchWriterOptions& options = BatchWriterOptions());
+
+    /**
+     * @brief Destructor that flushes outstanding writes and stops the workers
+     */
+    ~DynamoDBBatchWriter();
+
+    // Delete copy and move operations
+    DynamoDBBatchWriter(const DynamoDBBatchWriter&) = delete;
+    DynamoDBBatchWriter& operator=(const DynamoDBBatchWriter&) = delete;
+    DynamoDBBatchWriter(DynamoDBBatchWriter&&) = delete;
+    DynamoDBBatchWriter& operator=(DynamoDBBatchWriter&&) = delete;
+
+    /**
+     * @brief Queue an item to be put into the table
+     *
+     * @param item The complete item, including its key attributes
+     */
+    void Put(const AttributeMap& item);
+
+    /**
+     * @brief Queue an item to be deleted from the table
+     *
+     * @param key The key attributes of the item to delete
+     */
+    void Delete(const AttributeMap& key);
+
+    /**
+     * @brief Send any partially filled batch and wait for all queued writes to finish
+     *
+     * @return bool True if no write has failed since the writer was created, false otherwise
+     */
+    bool Flush();
+
+    /**
+     * @brief Get a snapshot of the writer's counters
+     *
+     * @return BatchWriterStats Items written and failed, request counts and throughput
+     */
+    BatchWriterStats GetStats() const;
+
+private:
+    using WriteBatch = Aws::Vector<Aws::DynamoDB::Model::WriteRequest>;
+
+    DynamoDBManager& manager;          ///< Owner of the client used for requests
+    std::string tableName;             ///< Table all writes go to
+    BatchWriterOptions options;        ///< Concurrency and retry settings
+
+    mutable std::mutex mutex;          ///< Guards every member below
+    std::condition_variable queueChanged; ///< Signalled when batches are queued or finished
+    WriteBatch pending;                ///< Batch currently being filled
+    std::deque<WriteBatch> queue;      ///< Full batches waiting for a worker
+    unsigned activeBatches = 0;        ///< Batches currently being sent by workers
+    bool stopping = false;             ///< Set when the workers should exit
+    BatchWriterStats stats;            ///< Running counters
+    std::chrono::steady_clock::time_point firstWrite; ///< Time of the first Put or Delete
+    std::chrono::steady_clock::time_point lastCompletion; ///< Time the last batch finished
+    std::vector<std::thread> workers;  ///< Threads sending batches
+
+    /**
+     * @brief Add a write request to the pending batch, queueing the batch once it is full
+     *
+     * @param request The put or delete to add
+     */
+    void Enqueue(Aws::DynamoDB::Model::WriteRequest request);
+
+    /**
+     * @brief Move the pending batch onto the queue, blocking while the queue is full
+     *
+     * @param lock Lock on mutex, held by the caller
+     */
+    void QueuePending(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * @brief Worker thread body: send queued batches until the writer stops
+     */
+    void WorkerLoop();
+
+    /**
+     * @brief Send one batch, resubmitting unprocessed items until done or out of attempts
+     *
+     * @param batch The write requests to send
+     * @return std::uint64_t Number of items that could not be written
+     */
+    std::uint64_t SendBatch(WriteBatch batch);
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_DYNAMODBBATCHWRITER_H
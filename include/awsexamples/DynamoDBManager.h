@@ -8,11 +8,165 @@
 #ifndef AWSEXAMPLES_DYNAMODBMANAGER_H
 #define AWSEXAMPLES_DYNAMODBMANAGER_H
 
+#include "awsexamples/AsyncTypes.h"
+#include "awsexamples/OperationResult.h"
+#include "awsexamples/RetryController.h"
+#include "awsexamples/Waiter.h"
 #include <aws/dynamodb/DynamoDBClient.h>
+#include <aws/dynamodb/model/AttributeValue.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace awsexamples {
 
+/// An item or key as a map from attribute name to value
+using AttributeMap = Aws::Map<Aws::String, Aws::DynamoDB::Model::AttributeValue>;
+
+/**
+ * @brief Callback receiving one item of a result stream
+ *
+ * Returning false stops the operation after the current item.
+ */
+using ItemCallback = std::function<bool(const AttributeMap& item)>;
+
+/**
+ * @struct ScanOptions
+ * @brief Options controlling a streaming table scan
+ */
+struct ScanOptions {
+    int totalSegments = 1;  ///< Parallel scan segments the table is divided into
+    unsigned concurrency = 0;  ///< Threads scanning segments; 0 uses one per segment, up to one per hardware thread
+    int pageSize = 0;       ///< Items per Scan request (Limit); 0 lets DynamoDB fill 1 MB pages
+    bool consistentRead = false;        ///< Use strongly consistent reads
+    std::string projectionExpression;   ///< Attributes to return; empty returns all attributes
+    std::string filterExpression;       ///< Server-side filter applied to each page; empty for none
+    Aws::Map<Aws::String, Aws::String> expressionAttributeNames;  ///< Placeholders such as "#n"
+    AttributeMap expressionAttributeValues;  ///< Placeholders such as ":v" used by the filter
+};
+
+/// Scalar type of a key attribute
+enum class KeyAttributeType { String, Number, Binary };
+
+/**
+ * @struct KeyAttribute
+ * @brief A hash or range key attribute of a table or index
+ */
+struct KeyAttribute {
+    std::string name;  ///< Attribute name; empty means the key has no such attribute
+    KeyAttributeType type = KeyAttributeType::String;  ///< Scalar type of the attribute
+};
+
+/**
+ * @struct ProvisionedCapacity
+ * @brief Read and write capacity units of a provisioned table or global index
+ */
+struct ProvisionedCapacity {
+    long long readUnits = 5;   ///< Strongly consistent 4 KB reads per second
+    long long writeUnits = 5;  ///< 1 KB writes per second
+};
+
+/// Which attributes a secondary index copies from the table
+enum class IndexProjection {
+    All,       ///< Every attribute
+    KeysOnly,  ///< The table and index keys only
+    Include    ///< The keys plus SecondaryIndexSpec::nonKeyAttributes
+};
+
+/**
+ * @struct SecondaryIndexSpec
+ * @brief Shape of a global or local secondary index
+ */
+struct SecondaryIndexSpec {
+    std::string name;        ///< Index name, as passed in QueryOptions::indexName
+    KeyAttribute hashKey;    ///< Partition key; a local index must use the table's hash key
+    KeyAttribute rangeKey;   ///< Sort key; required for a local index
+    IndexProjection projection = IndexProjection::All;  ///< Attributes copied into the index
+    std::vector<std::string> nonKeyAttributes;  ///< Attributes copied with IndexProjection::Include
+    ProvisionedCapacity capacity;  ///< Capacity of a global index on a provisioned table
+};
+
+/// How a table is billed
+enum class TableBilling {
+    Provisioned,  ///< Fixed read and write capacity; requests above it are throttled
+    OnDemand      ///< PAY_PER_REQUEST: capacity follows traffic, billed per request
+};
+
+/**
+ * @struct TableSpec
+ * @brief Key schema, billing and indexes of a table to create
+ *
+ * The defaults describe the table CreateTable(tableName) creates: a string hash
+ * key named "id" and 5 read and 5 write capacity units. GetItem, PutItem and the
+ * other single-item operations address items by "id"; tables with other keys are
+ * read with Query and ScanTable.
+ */
+struct TableSpec {
+    std::string name;                         ///< Table name
+    KeyAttribute hashKey{"id"};               ///< Partition key
+    KeyAttribute rangeKey;                    ///< Sort key; an empty name creates a hash-only key
+    TableBilling billing = TableBilling::Provisioned;  ///< Billing mode
+    ProvisionedCapacity capacity;             ///< Table capacity when billing is Provisioned
+    std::vector<SecondaryIndexSpec> globalIndexes;  ///< Global secondary indexes
+    std::vector<SecondaryIndexSpec> localIndexes;   ///< Local secondary indexes; need a range key
+};
+
+/**
+ * @struct QueryOptions
+ * @brief Options controlling a query of a table or secondary index
+ */
+struct QueryOptions {
+    std::string keyConditionExpression;  ///< Partition key condition, optionally with a sort key condition
+    std::string indexName;               ///< Global or local secondary index to query; empty queries the table
+    std::string projectionExpression;    ///< Attributes to return; empty returns all attributes
+    std::string filterExpression;        ///< Server-side filter applied after the key condition; empty for none
+    Aws::Map<Aws::String, Aws::String> expressionAttributeNames;  ///< Placeholders such as "#n"
+    AttributeMap expressionAttributeValues;  ///< Placeholders such as ":v" used by the expressions
+    int pageSize = 0;              ///< Items per Query request (Limit); 0 lets DynamoDB fill 1 MB pages
+    int limit = 0;                 ///< Items evaluated in total before stopping; 0 reads every matching item
+    bool consistentRead = false;   ///< Use strongly consistent reads; not supported on global indexes
+    bool scanIndexForward = true;  ///< Return items in ascending sort key order
+    AttributeMap exclusiveStartKey;  ///< Resume after this key, as returned by QueryPage
+};
+
+/// Items by their "id" hash key
+using ItemMap = std::map<std::string, AttributeMap>;
+
+/**
+ * @struct BatchGetOptions
+ * @brief Options controlling a multi-key lookup
+ */
+struct BatchGetOptions {
+    unsigned concurrency = 4;     ///< BatchGetItem calls in flight at once
+    bool consistentRead = false;  ///< Use strongly consistent reads
+    int maxAttempts = 10;         ///< Submissions per batch, including resubmissions of unprocessed keys
+    std::chrono::milliseconds baseBackoff{50};   ///< Backoff cap for the first resubmission
+    std::chrono::milliseconds maxBackoff{5000};  ///< Upper bound on any single resubmission backoff
+};
+
+/**
+ * @struct GetItemResult
+ * @brief Result of an asynchronous item lookup
+ */
+struct GetItemResult {
+    bool success = false;  ///< Whether the request succeeded
+    AttributeMap item;     ///< The item's attributes; empty if no item has the requested key
+};
+
+/**
+ * @brief Callback receiving the result of an asynchronous item lookup
+ *
+ * The threading rules of CompletionCallback apply.
+ */
+using GetItemCallback = std::function<void(const GetItemResult& result)>;
+
+class DynamoDBBatchWriter;
+class ItemCache;
+
 /**
  * @class DynamoDBManager
  * @brief A class to manage AWS DynamoDB operations
@@ -32,19 +186,88 @@ public:
     /**
      * @brief Constructor with custom client configuration
      * 
+     * The client is taken from utils::ClientRegistry, so managers built from
+     * equal configurations share one client and its connection pool. The
+     * client's own SDK retries are turned off; the manager's RetryController
+     * makes every retry instead.
+     * 
      * @param config A custom AWS client configuration
      */
     explicit DynamoDBManager(const Aws::Client::ClientConfiguration& config);
     
+    /**
+     * @brief Constructor using an existing, possibly shared, client
+     * 
+     * Calls are retried by the manager's RetryController, so the client should
+     * be built without SDK retries (e.g. retry_mode = none); otherwise every
+     * controller attempt may become several requests.
+     * 
+     * @param client The DynamoDB client to use for all operations
+     */
+    explicit DynamoDBManager(std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client);
+    
+    /**
+     * @brief Get the client used for all operations
+     * 
+     * @return std::shared_ptr<Aws::DynamoDB::DynamoDBClient> The (possibly shared) DynamoDB client
+     */
+    std::shared_ptr<Aws::DynamoDB::DynamoDBClient> GetClient() const { return client; }
+    
+    /**
+     * @brief Get the controller that rate limits and retries this manager's calls
+     * 
+     * @return std::shared_ptr<utils::RetryController> By default the controller shared by all DynamoDB managers
+     */
+    std::shared_ptr<utils::RetryController> GetRetryController() const { return retryController; }
+    
+    /**
+     * @brief Route this manager's calls through another controller
+     * 
+     * @param controller The controller to use, e.g. one with custom RetryOptions
+     */
+    void SetRetryController(std::shared_ptr<utils::RetryController> controller) { retryController = std::move(controller); }
+    
+    /**
+     * @brief Get the cache in front of GetItem
+     * 
+     * @return std::shared_ptr<ItemCache> The cache, or nullptr if items are always read from DynamoDB
+     */
+    std::shared_ptr<ItemCache> GetItemCache() const { return itemCache; }
+    
+    /**
+     * @brief Serve GetItem from a read-through cache
+     * 
+     * Lookups are answered from the cache while an entry is fresh and filled from
+     * DynamoDB otherwise. PutItem, DeleteItem and DynamoDBBatchWriter writes through
+     * this manager invalidate the items they write; writes made by other clients
+     * are seen once the entry's TTL passes. The cache may be shared by several
+     * managers. Set it before the manager is used from several threads.
+     * 
+     * @param cache The cache to use, or nullptr to disable caching
+     */
+    void SetItemCache(std::shared_ptr<ItemCache> cache) { itemCache = std::move(cache); }
+    
     /**
      * @brief Create a new DynamoDB table
      * 
      * Creates a table with a string hash key named "id"
      * 
      * @param tableName The name of the table to create
-     * @return bool True if the table was created successfully, false otherwise
+     * @return OperationResult Success if the table was created successfully, otherwise the error
      */
-    bool CreateTable(const std::string& tableName);
+    OperationResult CreateTable(const std::string& tableName);
+    
+    /**
+     * @brief Create a new DynamoDB table with the given keys, billing and indexes
+     * 
+     * Attribute definitions are derived from the table and index keys. Specs that
+     * DynamoDB would reject, such as an attribute used with two types or a local
+     * index on a hash-only table, fail before a request is sent.
+     * 
+     * @param spec The table's shape
+     * @return OperationResult Success if the table was created successfully, otherwise the error
+     */
+    OperationResult CreateTable(const TableSpec& spec);
     
     /**
      * @brief Add an item to a DynamoDB table
@@ -53,12 +276,24 @@ public:
      * @param id The ID to use as the hash key
      * @param name A name value to store in the item
      * @param age An age value to store in the item
-     * @return bool True if the item was added successfully, false otherwise
+     * @return OperationResult Success if the item was added successfully, otherwise the error
      */
-    bool PutItem(const std::string& tableName, 
-                const std::string& id, 
-                const std::string& name, 
-                int age);
+    OperationResult PutItem(const std::string& tableName, 
+                           const std::string& id, 
+                           const std::string& name, 
+                           int age);
+    
+    /**
+     * @brief Add an item with arbitrary attributes to a DynamoDB table
+     * 
+     * Typed records are written with PutRecord from ItemMapping.h, which builds the
+     * attribute map.
+     * 
+     * @param tableName The name of the table to add the item to
+     * @param item The item's attributes, including its "id" hash key
+     * @return OperationResult Success if the item was added successfully, otherwise the error
+     */
+    OperationResult PutItem(const std::string& tableName, const AttributeMap& item);
     
     /**
      * @brief Retrieve an item from a DynamoDB table by ID
@@ -68,6 +303,41 @@ public:
      */
     void GetItem(const std::string& tableName, const std::string& id);
     
+    /**
+     * @brief Retrieve an item from a DynamoDB table by ID without printing it
+     * 
+     * Served from the item cache when one is set and holds a fresh entry.
+     * 
+     * @param tableName The name of the table to query
+     * @param id The ID of the item to retrieve
+     * @param item Receives the item's attributes; left empty if no item has this ID
+     * @return OperationResult Success if the request succeeded, whether or not the item exists; otherwise the error
+     */
+    OperationResult GetItem(const std::string& tableName, const std::string& id, AttributeMap& item);
+    
+    /**
+     * @brief Retrieve many items from a DynamoDB table by ID
+     * 
+     * The IDs are deduplicated and looked up in 100-key BatchGetItem requests, up to
+     * options.concurrency of them at once. The requests run on the client's
+     * executor, so no threads are started per call, and failed requests are
+     * retried by the RetryController. Keys DynamoDB returns as UnprocessedKeys are
+     * reported to the controller as throttling and resubmitted after a jittered
+     * exponential backoff. With an item cache set, cached items are served from it
+     * and fetched items are added to it. Do not call this from a task running on
+     * the client's executor, which must be free to run the requests.
+     * 
+     * @param tableName The name of the table to query
+     * @param ids The IDs of the items to retrieve
+     * @param items Receives the items found, by ID; IDs without an item are left out
+     * @param options Concurrency, consistency and retry settings
+     * @return OperationResult Success if every ID was looked up, otherwise the error of the first failure
+     */
+    OperationResult GetItems(const std::string& tableName,
+                             const std::vector<std::string>& ids,
+                             ItemMap& items,
+                             const BatchGetOptions& options = BatchGetOptions());
+    
     /**
      * @brief Scan all items in a DynamoDB table
      * 
@@ -75,29 +345,80 @@ public:
      */
     void ScanTable(const std::string& tableName);
     
+    /**
+     * @brief Stream every item of a DynamoDB table to a callback
+     * 
+     * Follows LastEvaluatedKey until the table is exhausted, so results are not
+     * truncated at the 1 MB page limit. With options.totalSegments > 1 the table is
+     * read as a DynamoDB parallel scan: a pool of options.concurrency threads works
+     * through the segments and invokes the callback concurrently, so it must be
+     * thread-safe. Each thread holds at most one page in memory at a time.
+     * 
+     * @param tableName The name of the table to scan
+     * @param options Segmenting, paging and projection settings
+     * @param callback Invoked for each item; return false to stop the scan early
+     * @return OperationResult Success if the scan completed or was stopped by the callback, otherwise the error
+     */
+    OperationResult ScanTable(const std::string& tableName,
+                              const ScanOptions& options,
+                              const ItemCallback& callback);
+    
+    /**
+     * @brief Stream the items matching a key condition to a callback
+     * 
+     * Follows LastEvaluatedKey from page to page until the matching items are
+     * exhausted, options.limit items have been evaluated, or the callback returns
+     * false. Only one page is held in memory at a time.
+     * 
+     * @param tableName The name of the table to query
+     * @param options Key condition, index, projection and paging settings
+     * @param callback Invoked for each item in sort key order; return false to stop early
+     * @return OperationResult Success if the query completed or was stopped, otherwise the error
+     */
+    OperationResult Query(const std::string& tableName,
+                          const QueryOptions& options,
+                          const ItemCallback& callback);
+    
+    /**
+     * @brief Request a single page of query results
+     * 
+     * Lets callers page through results at their own pace, e.g. across requests
+     * of a web service: pass the returned key back as options.exclusiveStartKey
+     * to get the next page.
+     * 
+     * @param tableName The name of the table to query
+     * @param options Key condition, index, projection and paging settings
+     * @param items Receives the page's items
+     * @param lastEvaluatedKey Receives the key to resume after; empty once the results are exhausted
+     * @return OperationResult Success if the request succeeded, otherwise the error
+     */
+    OperationResult QueryPage(const std::string& tableName,
+                              const QueryOptions& options,
+                              std::vector<AttributeMap>& items,
+                              AttributeMap& lastEvaluatedKey);
+    
     /**
      * @brief Delete an item from a DynamoDB table
      * 
      * @param tableName The name of the table
      * @param id The ID of the item to delete
-     * @return bool True if the item was deleted successfully, false otherwise
+     * @return OperationResult Success if the item was deleted successfully, otherwise the error
      */
-    bool DeleteItem(const std::string& tableName, const std::string& id);
+    OperationResult DeleteItem(const std::string& tableName, const std::string& id);
     
     /**
      * @brief Delete a DynamoDB table
      * 
      * @param tableName The name of the table to delete
-     * @return bool True if the table was deleted successfully, false otherwise
+     * @return OperationResult Success if the table was deleted successfully, otherwise the error
      */
-    bool DeleteTable(const std::string& tableName);
-
-private:
-    Aws::DynamoDB::DynamoDBClient client; ///< AWS DynamoDB client used for all operations
+    OperationResult DeleteTable(const std::string& tableName);
     
     /**
      * @brief Wait for a table to be in a certain state
      * 
+     * Blocks the calling thread until WaitForTableStateAsync completes.
+     * 
      * @param tableName The name of the table to check
      * @param targetState The state to wait for (e.g. "ACTIVE", "DELETING")
      * @param maxWaitSeconds Maximum time to wait in seconds
@@ -107,6 +428,159 @@ private:
         const std::string& tableName, 
         const std::string& targetState, 
         int maxWaitSeconds = 60);
+    
+    /**
+     * @brief Create a new DynamoDB table without blocking the caller
+     * 
+     * The asynchronous variants run on the client's executor and report the same
+     * messages as their blocking counterparts; see CompletionCallback for the
+     * threading rules that apply to callbacks.
+     * 
+     * @param tableName The name of the table to create
+     * @param callback Invoked with true if the table was created successfully
+     */
+    void CreateTableAsync(const std::string& tableName, CompletionCallback callback);
+    
+    /**
+     * @brief Create a new DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table to create
+     * @return std::future<bool> Becomes true if the table was created successfully
+     */
+    std::future<bool> CreateTableAsync(const std::string& tableName);
+    
+    /**
+     * @brief Create a new DynamoDB table with the given keys, billing and indexes asynchronously
+     * 
+     * @param spec The table's shape
+     * @param callback Invoked with true if the table was created successfully
+     */
+    void CreateTableAsync(const TableSpec& spec, CompletionCallback callback);
+    
+    /**
+     * @brief Create a new DynamoDB table with the given keys, billing and indexes without blocking the caller
+     * 
+     * @param spec The table's shape
+     * @return std::future<bool> Becomes true if the table was created successfully
+     */
+    std::future<bool> CreateTableAsync(const TableSpec& spec);
+    
+    /**
+     * @brief Add an item to a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table to add the item to
+     * @param id The ID to use as the hash key
+     * @param name A name value to store in the item
+     * @param age An age value to store in the item
+     * @param callback Invoked with true if the item was added successfully
+     */
+    void PutItemAsync(const std::string& tableName,
+                      const std::string& id,
+                      const std::string& name,
+                      int age,
+                      CompletionCallback callback);
+    
+    /**
+     * @brief Add an item to a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table to add the item to
+     * @param id The ID to use as the hash key
+     * @param name A name value to store in the item
+     * @param age An age value to store in the item
+     * @return std::future<bool> Becomes true if the item was added successfully
+     */
+    std::future<bool> PutItemAsync(const std::string& tableName,
+                                   const std::string& id,
+                                   const std::string& name,
+                                   int age);
+    
+    /**
+     * @brief Retrieve an item from a DynamoDB table by ID without blocking the caller
+     * 
+     * @param tableName The name of the table to query
+     * @param id The ID of the item to retrieve
+     * @param callback Invoked with the request status and the item, if found
+     */
+    void GetItemAsync(const std::string& tableName, const std::string& id, GetItemCallback callback);
+    
+    /**
+     * @brief Retrieve an item from a DynamoDB table by ID without blocking the caller
+     * 
+     * @param tableName The name of the table to query
+     * @param id The ID of the item to retrieve
+     * @return std::future<GetItemResult> Becomes the request status and the item, if found
+     */
+    std::future<GetItemResult> GetItemAsync(const std::string& tableName, const std::string& id);
+    
+    /**
+     * @brief Delete an item from a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table
+     * @param id The ID of the item to delete
+     * @param callback Invoked with true if the item was deleted successfully
+     */
+    void DeleteItemAsync(const std::string& tableName, const std::string& id, CompletionCallback callback);
+    
+    /**
+     * @brief Delete an item from a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table
+     * @param id The ID of the item to delete
+     * @return std::future<bool> Becomes true if the item was deleted successfully
+     */
+    std::future<bool> DeleteItemAsync(const std::string& tableName, const std::string& id);
+    
+    /**
+     * @brief Delete a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table to delete
+     * @param callback Invoked with true if the table was deleted successfully
+     */
+    void DeleteTableAsync(const std::string& tableName, CompletionCallback callback);
+    
+    /**
+     * @brief Delete a DynamoDB table without blocking the caller
+     * 
+     * @param tableName The name of the table to delete
+     * @return std::future<bool> Becomes true if the table was deleted successfully
+     */
+    std::future<bool> DeleteTableAsync(const std::string& tableName);
+    
+    /**
+     * @brief Wait for a table to be in a certain state without blocking the caller
+     * 
+     * No thread is held while waiting: checks are scheduled on the shared Waiter
+     * and back off, with jitter, from options.initialDelay to options.maxDelay.
+     * A target state of "DELETED" is reached once the table no longer exists.
+     * 
+     * @param tableName The name of the table to check
+     * @param targetState The state to wait for (e.g. "ACTIVE", "DELETED")
+     * @param options Polling schedule and timeout
+     * @param callback Invoked with true if the table reached the target state
+     */
+    void WaitForTableStateAsync(const std::string& tableName,
+                                const std::string& targetState,
+                                const WaitOptions& options,
+                                CompletionCallback callback);
+    
+    /**
+     * @brief Wait for a table to be in a certain state without blocking the caller
+     * 
+     * @param tableName The name of the table to check
+     * @param targetState The state to wait for (e.g. "ACTIVE", "DELETED")
+     * @param options Polling schedule and timeout
+     * @return std::future<bool> Becomes true if the table reached the target state
+     */
+    std::future<bool> WaitForTableStateAsync(const std::string& tableName,
+                                             const std::string& targetState,
+                                             const WaitOptions& options = WaitOptions());
+
+private:
+    friend class DynamoDBBatchWriter;
+    
+    std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client; ///< AWS DynamoDB client used for all operations
+    std::shared_ptr<utils::RetryController> retryController; ///< Rate limits and retries every call
+    std::shared_ptr<ItemCache> itemCache; ///< Optional cache in front of GetItem
 };
 
 }  // namespace awsexamples
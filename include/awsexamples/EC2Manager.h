@@ -8,12 +8,49 @@
 #ifndef AWSEXAMPLES_EC2MANAGER_H
 #define AWSEXAMPLES_EC2MANAGER_H
 
+#include "awsexamples/AsyncTypes.h"
+#include "awsexamples/OperationResult.h"
+#include "awsexamples/FleetSnapshot.h"
+#include "awsexamples/RetryController.h"
+#include "awsexamples/Waiter.h"
 #include <aws/ec2/EC2Client.h>
+#include <aws/ec2/model/DescribeInstancesRequest.h>
+#include <aws/ec2/model/Instance.h>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace awsexamples {
 
+namespace detail {
+class InstanceStateWaiter;
+}
+
+/**
+ * @struct InstancesResult
+ * @brief Result of an asynchronous instance description
+ */
+struct InstancesResult {
+    bool success = false;                            ///< Whether every request succeeded
+    Aws::Vector<Aws::EC2::Model::Instance> instances; ///< The instances described
+};
+
+/// Whether a bulk operation succeeded for each instance, by instance ID
+using InstanceResultMap = std::map<std::string, bool>;
+
+/// Instance state names (e.g. "running"), by instance ID
+using InstanceStateMap = std::map<std::string, std::string>;
+
+/**
+ * @brief Callback receiving the result of an asynchronous instance description
+ *
+ * The threading rules of CompletionCallback apply.
+ */
+using InstancesCallback = std::function<void(const InstancesResult& result)>;
+
 /**
  * @class EC2Manager
  * @brief A class to manage AWS EC2 operations
@@ -33,30 +70,147 @@ public:
     /**
      * @brief Constructor with custom client configuration
      * 
+     * The client is taken from utils::ClientRegistry, so managers built from
+     * equal configurations share one client and its connection pool. The
+     * client's own SDK retries are turned off; the manager's RetryController
+     * makes every retry instead.
+     * 
      * @param config A custom AWS client configuration
      */
     explicit EC2Manager(const Aws::Client::ClientConfiguration& config);
     
+    /**
+     * @brief Constructor using an existing, possibly shared, client
+     * 
+     * Calls are retried by the manager's RetryController, so the client should
+     * be built without SDK retries (e.g. retry_mode = none); otherwise every
+     * controller attempt may become several requests.
+     * 
+     * @param client The EC2 client to use for all operations
+     */
+    explicit EC2Manager(std::shared_ptr<Aws::EC2::EC2Client> client);
+    
+    /**
+     * @brief Get the client used for all operations
+     * 
+     * @return std::shared_ptr<Aws::EC2::EC2Client> The (possibly shared) EC2 client
+     */
+    std::shared_ptr<Aws::EC2::EC2Client> GetClient() const { return ec2Client; }
+    
+    /**
+     * @brief Get the controller that rate limits and retries this manager's calls
+     * 
+     * @return std::shared_ptr<utils::RetryController> By default the controller shared by all EC2 managers
+     */
+    std::shared_ptr<utils::RetryController> GetRetryController() const { return retryController; }
+    
+    /**
+     * @brief Route this manager's calls through another controller
+     * 
+     * LaunchInstance is never retried, since a repeated RunInstances call could
+     * launch a second instance.
+     * 
+     * @param controller The controller to use, e.g. one with custom RetryOptions
+     */
+    void SetRetryController(std::shared_ptr<utils::RetryController> controller) { retryController = std::move(controller); }
+    
     /**
      * @brief List all EC2 instances available to the user
+     * 
+     * Follows pagination, so every instance is listed however large the fleet.
      */
     void ListInstances();
     
+    /**
+     * @brief Take a snapshot of all instances visible to this manager's client
+     * 
+     * Pages of up to 1000 instances are requested one after another, with the next
+     * page in flight while the current one is added to the snapshot. The region
+     * column is left empty.
+     * 
+     * @param snapshot Receives the instances; existing rows are kept
+     * @return OperationResult Success if every page was received, otherwise the error
+     */
+    OperationResult DescribeFleet(FleetSnapshot& snapshot);
+    
+    /**
+     * @brief Take a snapshot of all instances in several regions
+     * 
+     * The regions are described concurrently, each with a client for @p config
+     * and that region taken from utils::ClientRegistry. Pages are retried through
+     * the shared EC2 RetryController.
+     * 
+     * @param regions The regions to describe, e.g. {"us-east-1", "eu-west-1"}
+     * @param config Client configuration to use; its region is replaced
+     * @param snapshot Receives the instances; existing rows are kept
+     * @return OperationResult Success if every region was described completely, otherwise the error
+     */
+    static OperationResult DescribeFleet(const std::vector<std::string>& regions,
+                                         const Aws::Client::ClientConfiguration& config,
+                                         FleetSnapshot& snapshot);
+    
     /**
      * @brief Start an EC2 instance
      * 
      * @param instanceId The ID of the instance to start
-     * @return bool True if the start request was successful, false otherwise
+     * @return OperationResult Success if the start request was successful, otherwise the error
      */
-    bool StartInstance(const std::string& instanceId);
+    OperationResult StartInstance(const std::string& instanceId);
     
     /**
      * @brief Stop an EC2 instance
      * 
      * @param instanceId The ID of the instance to stop
-     * @return bool True if the stop request was successful, false otherwise
+     * @return OperationResult Success if the stop request was successful, otherwise the error
+     */
+    OperationResult StopInstance(const std::string& instanceId);
+    
+    /**
+     * @brief Start several EC2 instances
+     * 
+     * The IDs are sent in batches of up to 100 per StartInstances request, with all
+     * batches in flight at once on the client's executor. A request fails as a
+     * whole if any of its instances cannot be started, so the instances of a
+     * batch that failed on a bad ID or state are retried one by one to find out
+     * which ones succeed. Throttled batches are retried whole, with backoff.
+     * 
+     * @param instanceIds The IDs of the instances to start; duplicates are ignored
+     * @return InstanceResultMap True for each instance whose start was initiated
+     */
+    InstanceResultMap StartInstances(const std::vector<std::string>& instanceIds);
+    
+    /**
+     * @brief Stop several EC2 instances
+     * 
+     * Batched like StartInstances.
+     * 
+     * @param instanceIds The IDs of the instances to stop; duplicates are ignored
+     * @return InstanceResultMap True for each instance whose stop was initiated
+     */
+    InstanceResultMap StopInstances(const std::vector<std::string>& instanceIds);
+    
+    /**
+     * @brief Terminate several EC2 instances
+     * 
+     * Batched like StartInstances.
+     * 
+     * @param instanceIds The IDs of the instances to terminate; duplicates are ignored
+     * @return InstanceResultMap True for each instance whose termination was initiated
      */
-    bool StopInstance(const std::string& instanceId);
+    InstanceResultMap TerminateInstances(const std::vector<std::string>& instanceIds);
+    
+    /**
+     * @brief Get the current state of several EC2 instances
+     * 
+     * Uses one DescribeInstances request, filtered by instance ID, per 200
+     * instances, with all requests in flight at once. Unknown IDs do not fail
+     * the request; they are simply missing from the result.
+     * 
+     * @param instanceIds The IDs of the instances to check
+     * @param states Receives the state of each instance that was found
+     * @return OperationResult Success if every request succeeded, otherwise the error
+     */
+    OperationResult GetInstanceStates(const std::vector<std::string>& instanceIds, InstanceStateMap& states);
     
     /**
      * @brief Launch a new EC2 instance
@@ -75,13 +229,15 @@ public:
      * @brief Terminate an EC2 instance
      * 
      * @param instanceId The ID of the instance to terminate
-     * @return bool True if the terminate request was successful, false otherwise
+     * @return OperationResult Success if the terminate request was successful, otherwise the error
      */
-    bool TerminateInstance(const std::string& instanceId);
+    OperationResult TerminateInstance(const std::string& instanceId);
     
     /**
      * @brief Wait for an instance to reach a specific state
      * 
+     * Blocks the calling thread until WaitForInstanceStateAsync completes.
+     * 
      * @param instanceId The ID of the instance to check
      * @param targetState The state to wait for (e.g., "running", "stopped")
      * @param maxWaitSeconds Maximum time to wait in seconds
@@ -91,17 +247,176 @@ public:
         const std::string& instanceId, 
         const std::string& targetState, 
         int maxWaitSeconds = 120);
-
-private:
-    Aws::EC2::EC2Client ec2Client; ///< AWS EC2 client used for all operations
     
     /**
-     * @brief Get the current state of an EC2 instance
+     * @brief Wait for several instances to reach a specific state
+     * 
+     * @param instanceIds The IDs of the instances to check
+     * @param targetState The state to wait for (e.g., "running", "stopped")
+     * @param maxWaitSeconds Maximum time to wait in seconds
+     * @return bool True if every instance reached the target state, false otherwise
+     */
+    bool WaitForInstancesState(
+        const std::vector<std::string>& instanceIds,
+        const std::string& targetState,
+        int maxWaitSeconds = 120);
+    
+    /**
+     * @brief Start an EC2 instance without blocking the caller
+     * 
+     * The asynchronous variants run on the client's executor and report the same
+     * messages as their blocking counterparts; see CompletionCallback for the
+     * threading rules that apply to callbacks.
+     * 
+     * @param instanceId The ID of the instance to start
+     * @param callback Invoked with true if the start request was successful
+     */
+    void StartInstanceAsync(const std::string& instanceId, CompletionCallback callback);
+    
+    /**
+     * @brief Start an EC2 instance without blocking the caller
+     * 
+     * @param instanceId The ID of the instance to start
+     * @return std::future<bool> Becomes true if the start request was successful
+     */
+    std::future<bool> StartInstanceAsync(const std::string& instanceId);
+    
+    /**
+     * @brief Stop an EC2 instance without blocking the caller
+     * 
+     * @param instanceId The ID of the instance to stop
+     * @param callback Invoked with true if the stop request was successful
+     */
+    void StopInstanceAsync(const std::string& instanceId, CompletionCallback callback);
+    
+    /**
+     * @brief Stop an EC2 instance without blocking the caller
+     * 
+     * @param instanceId The ID of the instance to stop
+     * @return std::future<bool> Becomes true if the stop request was successful
+     */
+    std::future<bool> StopInstanceAsync(const std::string& instanceId);
+    
+    /**
+     * @brief Launch a new EC2 instance without blocking the caller
+     * 
+     * @param amiId The ID of the AMI to use
+     * @param instanceType The EC2 instance type to launch
+     * @param keyName SSH key name to associate with the instance, or empty for none
+     * @param callback Invoked with the ID of the new instance, or an empty string on failure
+     */
+    void LaunchInstanceAsync(const std::string& amiId,
+                             const std::string& instanceType,
+                             const std::string& keyName,
+                             StringCallback callback);
+    
+    /**
+     * @brief Launch a new EC2 instance without blocking the caller
+     * 
+     * @param amiId The ID of the AMI to use
+     * @param instanceType The EC2 instance type to launch
+     * @param keyName Optional SSH key name to associate with the instance
+     * @return std::future<std::string> Becomes the ID of the new instance, or empty on failure
+     */
+    std::future<std::string> LaunchInstanceAsync(const std::string& amiId,
+                                                 const std::string& instanceType,
+                                                 const std::string& keyName = "");
+    
+    /**
+     * @brief Terminate an EC2 instance without blocking the caller
+     * 
+     * @param instanceId The ID of the instance to terminate
+     * @param callback Invoked with true if the terminate request was successful
+     */
+    void TerminateInstanceAsync(const std::string& instanceId, CompletionCallback callback);
+    
+    /**
+     * @brief Terminate an EC2 instance without blocking the caller
+     * 
+     * @param instanceId The ID of the instance to terminate
+     * @return std::future<bool> Becomes true if the terminate request was successful
+     */
+    std::future<bool> TerminateInstanceAsync(const std::string& instanceId);
+    
+    /**
+     * @brief Describe EC2 instances without blocking the caller
+     * 
+     * Follows NextToken until every page has been received; each page is requested
+     * from the completion handler of the previous one, so no thread waits in between.
+     * 
+     * @param instanceIds The IDs of the instances to describe, or empty for all instances
+     * @param callback Invoked with the request status and the instances found
+     */
+    void DescribeInstancesAsync(const std::vector<std::string>& instanceIds, InstancesCallback callback);
+    
+    /**
+     * @brief Describe EC2 instances without blocking the caller
+     * 
+     * @param instanceIds The IDs of the instances to describe, or empty for all instances
+     * @return std::future<InstancesResult> Becomes the request status and the instances found
+     */
+    std::future<InstancesResult> DescribeInstancesAsync(const std::vector<std::string>& instanceIds);
+    
+    /**
+     * @brief Wait for an instance to reach a specific state without blocking the caller
+     * 
+     * No thread is held while waiting. Checks back off, with jitter, from
+     * options.initialDelay to options.maxDelay, and the checks of all pending
+     * waits of this manager are combined into one DescribeInstances call per 200
+     * instances. The wait fails early if the instance is terminated (or shutting
+     * down) and cannot reach the target state.
+     * 
+     * @param instanceId The ID of the instance to check
+     * @param targetState The state to wait for (e.g., "running", "stopped")
+     * @param options Polling schedule and timeout
+     * @param callback Invoked with true if the instance reached the target state
+     */
+    void WaitForInstanceStateAsync(const std::string& instanceId,
+                                   const std::string& targetState,
+                                   const WaitOptions& options,
+                                   CompletionCallback callback);
+    
+    /**
+     * @brief Wait for an instance to reach a specific state without blocking the caller
      * 
      * @param instanceId The ID of the instance to check
-     * @return std::string The current state of the instance
+     * @param targetState The state to wait for (e.g., "running", "stopped")
+     * @param options Polling schedule and timeout
+     * @return std::future<bool> Becomes true if the instance reached the target state
+     */
+    std::future<bool> WaitForInstanceStateAsync(const std::string& instanceId,
+                                                const std::string& targetState,
+                                                const WaitOptions& options = WaitOptions());
+    
+    /**
+     * @brief Wait for several instances to reach a specific state without blocking the caller
+     * 
+     * @param instanceIds The IDs of the instances to check
+     * @param targetState The state to wait for (e.g., "running", "stopped")
+     * @param options Polling schedule and timeout
+     * @param callback Invoked once every wait has finished, with true if all succeeded
      */
-    std::string GetInstanceState(const std::string& instanceId);
+    void WaitForInstancesStateAsync(const std::vector<std::string>& instanceIds,
+                                    const std::string& targetState,
+                                    const WaitOptions& options,
+                                    CompletionCallback callback);
+    
+    /**
+     * @brief Wait for several instances to reach a specific state without blocking the caller
+     * 
+     * @param instanceIds The IDs of the instances to check
+     * @param targetState The state to wait for (e.g., "running", "stopped")
+     * @param options Polling schedule and timeout
+     * @return std::future<bool> Becomes true if every instance reached the target state
+     */
+    std::future<bool> WaitForInstancesStateAsync(const std::vector<std::string>& instanceIds,
+                                                 const std::string& targetState,
+                                                 const WaitOptions& options = WaitOptions());
+
+private:
+    std::shared_ptr<Aws::EC2::EC2Client> ec2Client; ///< AWS EC2 client used for all operations
+    std::shared_ptr<utils::RetryController> retryController; ///< Rate limits and retries every call
+    std::shared_ptr<detail::InstanceStateWaiter> instanceWaiter; ///< Coalesces instance state checks
 };
 
 }  // namespace awsexamples
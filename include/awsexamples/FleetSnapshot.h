@@ -0,0 +1,214 @@
+/**
+ * @file FleetSnapshot.h
+ * @brief Compact, columnar in-memory view of a fleet of EC2 instances
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_FLEETSNAPSHOT_H
+#define AWSEXAMPLES_FLEETSNAPSHOT_H
+
+#include <aws/ec2/model/Instance.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @class StringPool
+ * @brief Stores each distinct string once and refers to it by a small integer
+ *
+ * Strings are never moved once interned, so references returned by Get stay
+ * valid for the lifetime of the pool (including after the pool is moved).
+ */
+class StringPool {
+public:
+    /// Identifier of an interned string
+    using Id = std::uint32_t;
+
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    StringPool(StringPool&&) = default;
+    StringPool& operator=(StringPool&&) = default;
+
+    /**
+     * @brief Intern a string
+     *
+     * @param value The string to intern
+     * @return Id The identifier of the string, the same for equal strings
+     */
+    Id Intern(std::string_view value);
+
+    /**
+     * @brief Look up a string without interning it
+     *
+     * @param value The string to look up
+     * @param id Receives the identifier if the string has been interned
+     * @return bool True if the string has been interned, false otherwise
+     */
+    bool Find(std::string_view value, Id& id) const;
+
+    /**
+     * @brief Get an interned string
+     *
+     * @param id Identifier returned by Intern
+     * @return const std::string& The string
+     */
+    const std::string& Get(Id id) const { return strings[id]; }
+
+    /**
+     * @brief Get the number of distinct strings
+     *
+     * @return std::size_t The number of interned strings
+     */
+    std::size_t Size() const { return strings.size(); }
+
+private:
+    std::deque<std::string> strings;                 ///< Interned strings by identifier
+    std::unordered_map<std::string_view, Id> ids;    ///< Identifiers by string, viewing strings
+};
+
+/**
+ * @struct FleetFilter
+ * @brief Criteria for selecting instances from a FleetSnapshot
+ *
+ * Empty fields match any instance. A tag key with an empty tag value matches
+ * every instance that carries the tag.
+ */
+struct FleetFilter {
+    std::string state;          ///< Instance state name, e.g. "running"
+    std::string instanceType;   ///< Instance type, e.g. "t2.micro"
+    std::string region;         ///< Region the instance was found in
+    std::string tagKey;         ///< Tag the instance must carry
+    std::string tagValue;       ///< Value the tag must have
+};
+
+/**
+ * @class FleetSnapshot
+ * @brief Columnar snapshot of EC2 instances, built once and filtered in-process
+ *
+ * Each instance is a row. State, type, region and tag strings are interned, so
+ * a row is a few integers plus its ID, and filters compare integers instead of
+ * strings. Rows are numbered from 0 in the order instances were added.
+ */
+class FleetSnapshot {
+public:
+    FleetSnapshot() = default;
+    FleetSnapshot(const FleetSnapshot&) = delete;
+    FleetSnapshot& operator=(const FleetSnapshot&) = delete;
+    FleetSnapshot(FleetSnapshot&&) = default;
+    FleetSnapshot& operator=(FleetSnapshot&&) = default;
+
+    /**
+     * @brief Add an instance as a new row
+     *
+     * An instance that is already in the snapshot is ignored.
+     *
+     * @param instance The instance as returned by DescribeInstances
+     * @param region The region the instance was found in
+     */
+    void Add(const Aws::EC2::Model::Instance& instance, const std::string& region);
+
+    /**
+     * @brief Add every instance of another snapshot
+     *
+     * Instances that are already in this snapshot are ignored.
+     *
+     * @param other The snapshot to copy rows from
+     */
+    void Append(const FleetSnapshot& other);
+
+    /**
+     * @brief Reserve space for a number of instances
+     *
+     * @param rows The expected number of instances
+     */
+    void Reserve(std::size_t rows);
+
+    /**
+     * @brief Get the number of instances
+     *
+     * @return std::size_t The number of rows
+     */
+    std::size_t Size() const { return instanceIds.size(); }
+
+    /**
+     * @brief Find the row of an instance
+     *
+     * @param instanceId The ID of the instance
+     * @param row Receives the row of the instance
+     * @return bool True if the instance is in the snapshot, false otherwise
+     */
+    bool Find(const std::string& instanceId, std::size_t& row) const;
+
+    /**
+     * @brief Select the rows of all instances matching a filter
+     *
+     * @param filter The criteria to match
+     * @return std::vector<std::size_t> The matching rows, in ascending order
+     */
+    std::vector<std::size_t> Select(const FleetFilter& filter) const;
+
+    const std::string& InstanceId(std::size_t row) const { return instanceIds[row]; }       ///< ID of a row
+    const std::string& State(std::size_t row) const { return strings.Get(states[row]); }     ///< State name of a row
+    const std::string& InstanceType(std::size_t row) const { return strings.Get(types[row]); } ///< Type of a row
+    const std::string& Region(std::size_t row) const { return strings.Get(regions[row]); }   ///< Region of a row
+    std::int64_t LaunchTime(std::size_t row) const { return launchTimes[row]; }             ///< Launch time in ms since the epoch
+
+    /**
+     * @brief Get the value of one tag of an instance
+     *
+     * @param row The row of the instance
+     * @param key The tag key
+     * @param value Receives the tag value
+     * @return bool True if the instance carries the tag, false otherwise
+     */
+    bool GetTag(std::size_t row, const std::string& key, std::string& value) const;
+
+    /**
+     * @brief Get all tags of an instance
+     *
+     * @param row The row of the instance
+     * @return std::vector<std::pair<std::string, std::string>> The tags as key/value pairs
+     */
+    std::vector<std::pair<std::string, std::string>> GetTags(std::size_t row) const;
+
+private:
+    using Id = StringPool::Id;
+
+    /// Index of the first tag of a row in tagPairs; tags of row r are [tagOffsets[r], tagOffsets[r + 1])
+    using TagRange = std::pair<std::size_t, std::size_t>;
+
+    TagRange Tags(std::size_t row) const { return {tagOffsets[row], tagOffsets[row + 1]}; }
+
+    /**
+     * @brief Append a row from interned values
+     */
+    void AddRow(const std::string& instanceId,
+                Id state,
+                Id type,
+                Id region,
+                std::int64_t launchTime,
+                const std::vector<std::pair<Id, Id>>& tags);
+
+    StringPool strings;                             ///< States, types, regions, tag keys and values
+    std::vector<std::string> instanceIds;           ///< Instance ID of each row
+    std::vector<Id> states;                         ///< State of each row
+    std::vector<Id> types;                          ///< Instance type of each row
+    std::vector<Id> regions;                        ///< Region of each row
+    std::vector<std::int64_t> launchTimes;          ///< Launch time of each row
+    std::vector<std::size_t> tagOffsets{0};         ///< Start of each row's tags in tagPairs, plus the end
+    std::vector<std::pair<Id, Id>> tagPairs;        ///< Tag key and value of all rows
+    std::unordered_map<std::string, std::size_t> rowsById; ///< Row of each instance ID
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_FLEETSNAPSHOT_H
@@ -0,0 +1,106 @@
+/**
+ * @file FleetTracker.h
+ * @brief Tracks an EC2 fleet across polls and reports what changed
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_FLEETTRACKER_H
+#define AWSEXAMPLES_FLEETTRACKER_H
+
+#include "awsexamples/EC2Manager.h"
+#include "awsexamples/FleetSnapshot.h"
+#include <aws/core/client/ClientConfiguration.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @struct FleetStateChange
+ * @brief An instance whose state differs between two polls
+ */
+struct FleetStateChange {
+    std::string instanceId;     ///< The instance that changed
+    std::string previousState;  ///< State at the previous poll
+    std::string currentState;   ///< State at this poll
+};
+
+/**
+ * @struct FleetDiff
+ * @brief Changes to a fleet between two polls
+ */
+struct FleetDiff {
+    std::vector<std::string> added;              ///< Instances that appeared
+    std::vector<std::string> removed;            ///< Instances that disappeared
+    std::vector<FleetStateChange> stateChanged;  ///< Instances whose state changed
+
+    /**
+     * @brief Check whether nothing changed
+     *
+     * @return bool True if there are no changes, false otherwise
+     */
+    bool Empty() const { return added.empty() && removed.empty() && stateChanged.empty(); }
+};
+
+/**
+ * @class FleetTracker
+ * @brief Polls a fleet and reports only the instances that changed
+ *
+ * Each refresh takes a new FleetSnapshot and compares it with the previous one
+ * through the snapshots' ID indexes, so callers only see the churn. The first
+ * refresh reports every instance as added.
+ */
+class FleetTracker {
+public:
+    /**
+     * @brief Track the instances visible to a manager's client
+     *
+     * @param manager The manager to poll with; must outlive the tracker
+     */
+    explicit FleetTracker(EC2Manager& manager);
+
+    /**
+     * @brief Track the instances of several regions
+     *
+     * @param regions The regions to poll
+     * @param config Client configuration to use; its region is replaced
+     */
+    FleetTracker(std::vector<std::string> regions, Aws::Client::ClientConfiguration config);
+
+    /**
+     * @brief Poll the fleet and report changes since the previous poll
+     *
+     * If the poll fails the previous snapshot is kept, so the next successful
+     * refresh reports everything that changed since the last complete one.
+     *
+     * @param diff Receives the changes; cleared first
+     * @return bool True if the fleet was polled completely, false otherwise
+     */
+    bool Refresh(FleetDiff& diff);
+
+    /**
+     * @brief Get the snapshot taken by the last successful refresh
+     *
+     * @return const FleetSnapshot& The current snapshot; empty before the first refresh
+     */
+    const FleetSnapshot& GetSnapshot() const { return snapshot; }
+
+    /**
+     * @brief Compare two snapshots
+     *
+     * @param previous The older snapshot
+     * @param current The newer snapshot
+     * @param diff Receives the changes; cleared first
+     */
+    static void Diff(const FleetSnapshot& previous, const FleetSnapshot& current, FleetDiff& diff);
+
+private:
+    std::function<bool(FleetSnapshot&)> describe;  ///< Takes a snapshot of the tracked fleet
+    FleetSnapshot snapshot;                        ///< Snapshot of the last successful refresh
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_FLEETTRACKER_H
@@ -0,0 +1,135 @@
+/**
+ * @file GetItemCoalescer.h
+ * @brief GetItemCoalescer class declaration for merging concurrent item lookups
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_GETITEMCOALESCER_H
+#define AWSEXAMPLES_GETITEMCOALESCER_H
+
+#include "awsexamples/DynamoDBManager.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @struct CoalescerOptions
+ * @brief Tuning parameters for GetItemCoalescer
+ */
+struct CoalescerOptions {
+    std::chrono::microseconds window{2000};  ///< How long the first lookup of a batch waits for others
+    std::size_t maxBatchSize = 100;          ///< Keys per batch; a full batch is sent at once
+    unsigned maxInFlight = 4;                ///< Number of batches looked up at once
+    BatchGetOptions batchOptions;            ///< Consistency and retry settings of each batch
+};
+
+/**
+ * @struct CoalescerStats
+ * @brief Counters describing the work done by a GetItemCoalescer
+ */
+struct CoalescerStats {
+    std::uint64_t lookups = 0;   ///< Calls to Get
+    std::uint64_t keys = 0;      ///< Distinct keys looked up, after merging duplicate lookups
+    std::uint64_t batches = 0;   ///< GetItems calls made
+};
+
+/**
+ * @class GetItemCoalescer
+ * @brief Merges single-key lookups from many threads into BatchGetItem calls
+ *
+ * The first lookup after a quiet period opens a batch that stays open for
+ * options.window or until it holds options.maxBatchSize keys; every lookup that
+ * arrives meanwhile joins it, and lookups of the same key share one result. A
+ * small pool of worker threads then fetches each batch with
+ * DynamoDBManager::GetItems, so the manager's item cache and retry controller
+ * apply. Callbacks run on a worker thread and must not block for long.
+ *
+ * The DynamoDBManager passed to the constructor must outlive the coalescer.
+ */
+class GetItemCoalescer {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param manager The manager used for all lookups
+     * @param tableName The name of the table to read from
+     * @param options Batching and concurrency settings
+     */
+    GetItemCoalescer(DynamoDBManager& manager,
+                     const std::string& tableName,
+                     const CoalescerOptions& options = CoalescerOptions());
+
+    /**
+     * @brief Destructor that completes outstanding lookups and stops the workers
+     */
+    ~GetItemCoalescer();
+
+    // Delete copy and move operations
+    GetItemCoalescer(const GetItemCoalescer&) = delete;
+    GetItemCoalescer& operator=(const GetItemCoalescer&) = delete;
+    GetItemCoalescer(GetItemCoalescer&&) = delete;
+    GetItemCoalescer& operator=(GetItemCoalescer&&) = delete;
+
+    /**
+     * @brief Look up an item as part of the next batch
+     *
+     * @param id The ID of the item to retrieve
+     * @param callback Invoked with the request status and the item, if found
+     */
+    void Get(const std::string& id, GetItemCallback callback);
+
+    /**
+     * @brief Look up an item as part of the next batch
+     *
+     * @param id The ID of the item to retrieve
+     * @return std::future<GetItemResult> Becomes the request status and the item, if found
+     */
+    std::future<GetItemResult> Get(const std::string& id);
+
+    /**
+     * @brief Get a snapshot of the coalescer's counters
+     *
+     * @return CoalescerStats Lookup, key and batch counts
+     */
+    CoalescerStats GetStats() const;
+
+private:
+    using Batch = std::map<std::string, std::vector<GetItemCallback>>;
+
+    DynamoDBManager& manager;          ///< Manager used for lookups
+    std::string tableName;             ///< Table all lookups go to
+    CoalescerOptions options;          ///< Batching and concurrency settings
+
+    mutable std::mutex mutex;          ///< Guards every member below
+    std::condition_variable pendingChanged; ///< Signalled when lookups arrive or the coalescer stops
+    Batch pending;                     ///< Callbacks waiting for the next batch, by ID
+    std::chrono::steady_clock::time_point windowEnd; ///< When the open batch is sent
+    bool stopping = false;             ///< Set when the workers should exit
+    CoalescerStats stats;              ///< Running counters
+    std::vector<std::thread> workers;  ///< Threads fetching batches
+
+    /**
+     * @brief Worker thread body: send batches until the coalescer stops
+     */
+    void WorkerLoop();
+
+    /**
+     * @brief Look up one batch and invoke its callbacks
+     *
+     * @param batch Callbacks by ID
+     */
+    void SendBatch(const Batch& batch);
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_GETITEMCOALESCER_H
@@ -0,0 +1,173 @@
+/**
+ * @file ItemCache.h
+ * @brief ItemCache class declaration, a sharded read-through cache of DynamoDB items
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_ITEMCACHE_H
+#define AWSEXAMPLES_ITEMCACHE_H
+
+#include "awsexamples/DynamoDBManager.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @struct ItemCacheOptions
+ * @brief Memory budget, expiry and sharding of an ItemCache
+ */
+struct ItemCacheOptions {
+    std::size_t maxBytes = 64 * 1024 * 1024;  ///< Approximate memory budget of all cached items
+    std::chrono::milliseconds ttl{60000};     ///< How long an item is served from the cache
+    std::chrono::milliseconds negativeTtl{5000};  ///< How long "no such item" is cached; 0 disables it
+    unsigned shards = 16;                     ///< Independently locked partitions of the cache
+};
+
+/**
+ * @struct ItemCacheStats
+ * @brief Counters of an ItemCache, used to size it
+ */
+struct ItemCacheStats {
+    std::uint64_t hits = 0;           ///< Lookups answered from the cache
+    std::uint64_t misses = 0;         ///< Lookups that had to go to DynamoDB
+    std::uint64_t evictions = 0;      ///< Entries dropped to stay within maxBytes
+    std::uint64_t expirations = 0;    ///< Entries dropped because their TTL had passed
+    std::uint64_t invalidations = 0;  ///< Entries dropped because the item was written
+    std::uint64_t entries = 0;        ///< Entries currently cached
+    std::uint64_t bytes = 0;          ///< Approximate memory used by the cached entries
+};
+
+/**
+ * @class ItemCache
+ * @brief Least-recently-used cache of DynamoDB items with a time to live
+ *
+ * Entries are keyed by table name and "id" hash key. The cache is split into
+ * shards, each with its own lock and an equal share of the memory budget, so
+ * lookups on different keys rarely contend.
+ *
+ * Filling the cache races with writes: an item read before a write may arrive
+ * after the write has invalidated it. Callers therefore take a generation
+ * before reading from DynamoDB and pass it to Put, which drops the fill if the
+ * key's shard has been invalidated since.
+ */
+class ItemCache {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param options Memory budget, expiry and sharding
+     */
+    explicit ItemCache(const ItemCacheOptions& options = ItemCacheOptions());
+
+    // Delete copy and move operations
+    ItemCache(const ItemCache&) = delete;
+    ItemCache& operator=(const ItemCache&) = delete;
+
+    /**
+     * @brief Look up an item
+     *
+     * @param tableName The item's table
+     * @param id The item's hash key
+     * @param item Receives the item's attributes; empty if the item is cached as missing
+     * @return bool True on a hit, false if the item must be read from DynamoDB
+     */
+    bool Get(const std::string& tableName, const std::string& id, AttributeMap& item);
+
+    /**
+     * @brief Get the invalidation generation of a key, to be passed to Put
+     *
+     * @param tableName The item's table
+     * @param id The item's hash key
+     * @return std::uint64_t The current generation of the key's shard
+     */
+    std::uint64_t Generation(const std::string& tableName, const std::string& id) const;
+
+    /**
+     * @brief Cache an item read from DynamoDB
+     *
+     * @param tableName The item's table
+     * @param id The item's hash key
+     * @param item The item's attributes; empty caches the item as missing
+     * @param generation The key's generation taken before the item was read
+     */
+    void Put(const std::string& tableName, const std::string& id, const AttributeMap& item, std::uint64_t generation);
+
+    /**
+     * @brief Drop an item, e.g. after it was written or deleted
+     *
+     * @param tableName The item's table
+     * @param id The item's hash key
+     */
+    void Invalidate(const std::string& tableName, const std::string& id);
+
+    /**
+     * @brief Get the ID an item is cached under
+     *
+     * The inverse of the key GetItem builds from an ID, so writers invalidate
+     * the entries lookups fill. Number keys map to their decimal text.
+     *
+     * @param item The item's attributes, or just its key
+     * @return std::string The "id" hash key as an ID; empty if it is missing or neither a string nor a number
+     */
+    static std::string ItemId(const AttributeMap& item);
+
+    /**
+     * @brief Drop every cached item
+     */
+    void Clear();
+
+    /**
+     * @brief Get the cache's counters
+     *
+     * @return ItemCacheStats Counters summed over all shards
+     */
+    ItemCacheStats GetStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// A cached item and its position in the shard's recency list
+    struct Entry {
+        AttributeMap item;                     ///< Cached attributes; empty for a missing item
+        Clock::time_point expires;             ///< When the entry stops being served
+        std::size_t bytes = 0;                 ///< Approximate memory used by the entry
+        std::list<std::string>::iterator lru;  ///< Position in Shard::recency
+    };
+
+    /// An independently locked partition of the cache
+    struct Shard {
+        mutable std::mutex mutex;                        ///< Guards all members below
+        std::unordered_map<std::string, Entry> entries;  ///< Entries by cache key
+        std::list<std::string> recency;                  ///< Cache keys, most recently used first
+        std::size_t bytes = 0;                           ///< Memory used by the entries
+        std::uint64_t generation = 0;                    ///< Bumped by every invalidation
+        ItemCacheStats stats;                            ///< Counters of this shard
+    };
+
+    /**
+     * @brief Get the shard holding a cache key
+     */
+    Shard& ShardFor(const std::string& key) const;
+
+    /**
+     * @brief Remove an entry from its shard; the shard's mutex must be held
+     */
+    static void Erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator entry);
+
+    ItemCacheOptions options;                        ///< Settings
+    std::size_t shardBytes;                          ///< Memory budget of each shard
+    std::vector<std::unique_ptr<Shard>> shards;      ///< The partitions
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_ITEMCACHE_H
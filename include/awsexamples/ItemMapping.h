@@ -0,0 +1,405 @@
+/**
+ * @file ItemMapping.h
+ * @brief Compile-time mapping between C++ record types and DynamoDB items
+ * @author AWS Example Team
+ * @date 2026-10-16
+ *
+ * A record type is mapped by specializing ItemTraits with a tuple of
+ * attributes, each naming a data member:
+ * @code
+ * struct Person {
+ *     std::string id;
+ *     std::string name;
+ *     int age = 0;
+ *     std::optional<std::string> email;
+ * };
+ *
+ * namespace awsexamples {
+ * template <>
+ * struct ItemTraits<Person> {
+ *     static constexpr auto attributes = std::make_tuple(
+ *         Attribute("id", &Person::id),
+ *         Attribute("name", &Person::name),
+ *         Attribute("age", &Person::age),
+ *         Attribute("email", &Person::email));
+ * };
+ * }  // namespace awsexamples
+ * @endcode
+ *
+ * ToItem and FromItem are then expanded per record type at compile time, with
+ * no per-field lookup tables or virtual calls. The record must have an "id"
+ * string attribute to be used with PutRecord and GetRecord.
+ */
+
+#ifndef AWSEXAMPLES_ITEMMAPPING_H
+#define AWSEXAMPLES_ITEMMAPPING_H
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/Logger.h"
+#include <atomic>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace awsexamples {
+
+/**
+ * @struct AttributeField
+ * @brief One mapped attribute: its name and the data member holding it
+ *
+ * @tparam Record The mapped record type
+ * @tparam Member The data member's type
+ */
+template <typename Record, typename Member>
+struct AttributeField {
+    const char* name;         ///< Attribute name in the item
+    Member Record::*member;   ///< Data member holding the attribute's value
+};
+
+/**
+ * @brief Map a data member to a named attribute
+ *
+ * @param name Attribute name in the item
+ * @param member Data member holding the attribute's value
+ * @return AttributeField<Record, Member> The mapping, for ItemTraits::attributes
+ */
+template <typename Record, typename Member>
+constexpr AttributeField<Record, Member> Attribute(const char* name, Member Record::*member) {
+    return {name, member};
+}
+
+/**
+ * @brief Mapping of a record type to item attributes; specialize for each record type
+ *
+ * A specialization declares `static constexpr auto attributes`, a tuple of
+ * Attribute() values.
+ */
+template <typename Record>
+struct ItemTraits;
+
+/**
+ * @brief Conversion of one member type to and from an AttributeValue
+ *
+ * Specializations provide Encode and Decode, plus Omit and Missing:
+ * Omit(value) says the attribute is left out of the item (DynamoDB rejects
+ * empty sets), and Missing(value) resets the member when the item lacks the
+ * attribute, returning false if the attribute is required.
+ */
+template <typename T, typename Enable = void>
+struct AttributeCodec;
+
+namespace detail {
+
+/// Omit and Missing for attributes that must always be present
+struct RequiredAttribute {
+    template <typename T>
+    static bool Omit(const T&) { return false; }
+
+    template <typename T>
+    static bool Missing(T&) { return false; }
+};
+
+/// Write a number into an N attribute; short numbers stay within the string's inline buffer
+template <typename T>
+void EncodeNumber(T value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    attribute.SetN(Aws::String(buffer, result.ptr));
+}
+
+/// Parse an N attribute in place, without copying its text
+template <typename T>
+bool DecodeNumber(const Aws::DynamoDB::Model::AttributeValue& attribute, T& value) {
+    if (attribute.GetType() != Aws::DynamoDB::Model::ValueType::NUMBER) {
+        return false;
+    }
+    const auto& text = attribute.GetN();
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+}  // namespace detail
+
+/// Strings map to S attributes
+template <>
+struct AttributeCodec<std::string> : detail::RequiredAttribute {
+    static void Encode(const std::string& value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+        attribute.SetS(value);
+    }
+
+    static bool Decode(const Aws::DynamoDB::Model::AttributeValue& attribute, std::string& value) {
+        if (attribute.GetType() != Aws::DynamoDB::Model::ValueType::STRING) {
+            return false;
+        }
+        // Assigning reuses the member's existing capacity
+        const auto& text = attribute.GetS();
+        value.assign(text.data(), text.size());
+        return true;
+    }
+};
+
+/// bool maps to BOOL attributes
+template <>
+struct AttributeCodec<bool> : detail::RequiredAttribute {
+    static void Encode(bool value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+        attribute.SetBOOL(value);
+    }
+
+    static bool Decode(const Aws::DynamoDB::Model::AttributeValue& attribute, bool& value) {
+        if (attribute.GetType() != Aws::DynamoDB::Model::ValueType::BOOL) {
+            return false;
+        }
+        value = attribute.GetBOOL();
+        return true;
+    }
+};
+
+/// Integer and floating-point types map to N attributes
+template <typename T>
+struct AttributeCodec<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+    : detail::RequiredAttribute {
+    static void Encode(T value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+        detail::EncodeNumber(value, attribute);
+    }
+
+    static bool Decode(const Aws::DynamoDB::Model::AttributeValue& attribute, T& value) {
+        return detail::DecodeNumber(attribute, value);
+    }
+};
+
+/// Vectors of strings map to SS attributes; an empty vector is stored as no attribute
+template <>
+struct AttributeCodec<std::vector<std::string>> {
+    static void Encode(const std::vector<std::string>& value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+        attribute.SetSS(Aws::Vector<Aws::String>(value.begin(), value.end()));
+    }
+
+    static bool Decode(const Aws::DynamoDB::Model::AttributeValue& attribute, std::vector<std::string>& value) {
+        if (attribute.GetType() != Aws::DynamoDB::Model::ValueType::STRING_SET) {
+            return false;
+        }
+        const auto& members = attribute.GetSS();
+        value.assign(members.begin(), members.end());
+        return true;
+    }
+
+    static bool Omit(const std::vector<std::string>& value) { return value.empty(); }
+
+    static bool Missing(std::vector<std::string>& value) {
+        value.clear();
+        return true;
+    }
+};
+
+/// std::optional members are stored as no attribute when empty
+template <typename T>
+struct AttributeCodec<std::optional<T>> {
+    static void Encode(const std::optional<T>& value, Aws::DynamoDB::Model::AttributeValue& attribute) {
+        AttributeCodec<T>::Encode(*value, attribute);
+    }
+
+    static bool Decode(const Aws::DynamoDB::Model::AttributeValue& attribute, std::optional<T>& value) {
+        if (!value) {
+            value.emplace();
+        }
+        return AttributeCodec<T>::Decode(attribute, *value);
+    }
+
+    static bool Omit(const std::optional<T>& value) { return !value || AttributeCodec<T>::Omit(*value); }
+
+    static bool Missing(std::optional<T>& value) {
+        value.reset();
+        return true;
+    }
+};
+
+/**
+ * @brief Write a record's mapped attributes into an item
+ *
+ * Attributes already in @p item are overwritten in place, so passing the same
+ * map for every record of a type reuses its nodes and key strings. Omitted
+ * attributes are erased; attributes the mapping does not name are left alone.
+ *
+ * @param record The record to marshal
+ * @param item Receives the record's attributes
+ */
+template <typename Record>
+void ToItem(const Record& record, AttributeMap& item) {
+    std::apply(
+        [&](const auto&... fields) {
+            auto encode = [&](const auto& field) {
+                const auto& value = record.*field.member;
+                using Codec = AttributeCodec<std::decay_t<decltype(value)>>;
+                if (Codec::Omit(value)) {
+                    item.erase(field.name);
+                } else {
+                    Codec::Encode(value, item[field.name]);
+                }
+            };
+            (encode(fields), ...);
+        },
+        ItemTraits<Record>::attributes);
+}
+
+/**
+ * @brief Read a record's mapped attributes from an item
+ *
+ * Stops at the first attribute that is missing without being optional, or has
+ * the wrong type or an unparseable number.
+ *
+ * @param item The item to unmarshal
+ * @param record Receives the attributes; members of a failed read are unspecified
+ * @param badAttribute If not null, receives the name of the attribute that could not be read
+ * @return bool True if every mapped attribute was read
+ */
+template <typename Record>
+bool FromItem(const AttributeMap& item, Record& record, const char** badAttribute = nullptr) {
+    return std::apply(
+        [&](const auto&... fields) {
+            auto decode = [&](const auto& field) {
+                auto& value = record.*field.member;
+                using Codec = AttributeCodec<std::decay_t<decltype(value)>>;
+                auto attribute = item.find(field.name);
+                bool read = attribute == item.end() ? Codec::Missing(value) : Codec::Decode(attribute->second, value);
+                if (!read && badAttribute) {
+                    *badAttribute = field.name;
+                }
+                return read;
+            };
+            return (decode(fields) && ...);
+        },
+        ItemTraits<Record>::attributes);
+}
+
+/**
+ * @brief Write a record to a table
+ *
+ * The item is marshalled into a per-thread map kept for the record type, so
+ * repeated writes reuse its nodes and attribute storage. PutItem still copies
+ * the map into the request it sends.
+ *
+ * @param manager The manager to write through
+ * @param tableName The name of the table
+ * @param record The record to write; must map an "id" string attribute
+ * @return OperationResult Success if the item was written, otherwise the error
+ */
+template <typename Record>
+OperationResult PutRecord(DynamoDBManager& manager, const std::string& tableName, const Record& record) {
+    thread_local AttributeMap item;
+    ToItem(record, item);
+    return manager.PutItem(tableName, item);
+}
+
+/**
+ * @brief Read a record from a table by ID
+ *
+ * @param manager The manager to read through; its item cache applies
+ * @param tableName The name of the table
+ * @param id The record's "id" hash key
+ * @param record Receives the record; left empty if no item has this ID
+ * @return OperationResult Success if the request succeeded and any item found
+ *         could be read; errors::kUnreadableItem if it could not
+ */
+template <typename Record>
+OperationResult GetRecord(DynamoDBManager& manager, const std::string& tableName, const std::string& id,
+                          std::optional<Record>& record) {
+    thread_local AttributeMap item;
+    item.clear();
+    record.reset();
+    OperationResult result = manager.GetItem(tableName, id, item);
+    if (!result || item.empty()) {
+        return result;
+    }
+
+    const char* badAttribute = "";
+    if (!FromItem(item, record.emplace(), &badAttribute)) {
+        AWSEXAMPLES_LOG(Error, "Cannot read attribute " << badAttribute << " of item " << id << " in " << tableName);
+        record.reset();
+        result.success = false;
+        result.errorType = errors::kUnreadableItem;
+        result.message = std::string("Cannot read attribute ") + badAttribute;
+    }
+    return result;
+}
+
+namespace detail {
+
+// Turn the result of a read that stopped on an unreadable item into an error
+inline OperationResult UnreadableResult(OperationResult result, const std::string& badAttribute) {
+    if (!badAttribute.empty() && result) {
+        result.success = false;
+        result.errorType = errors::kUnreadableItem;
+        result.message = "Cannot read attribute " + badAttribute;
+    }
+    return result;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Stream every record of a table to a callback
+ *
+ * One record per scanning thread is reused for all items it reads, so members
+ * keep their storage between items. Items that cannot be read end the scan.
+ *
+ * @param manager The manager to scan through
+ * @param tableName The name of the table
+ * @param options Segmenting, paging and projection settings; a projection must include every required attribute
+ * @param callback Invoked with each record; return false to stop the scan early
+ * @return OperationResult Success if the scan completed or was stopped by the
+ *         callback; otherwise the request error or errors::kUnreadableItem
+ */
+template <typename Record, typename Callback>
+OperationResult ScanRecords(DynamoDBManager& manager, const std::string& tableName, const ScanOptions& options,
+                            Callback callback) {
+    std::atomic<const char*> unreadable{nullptr};
+    OperationResult scanned = manager.ScanTable(tableName, options, [&](const AttributeMap& item) {
+        thread_local Record record;
+        const char* badAttribute = "";
+        if (!FromItem(item, record, &badAttribute)) {
+            AWSEXAMPLES_LOG(Error, "Cannot read attribute " << badAttribute << " of an item in " << tableName);
+            unreadable = badAttribute;
+            return false;
+        }
+        return static_cast<bool>(callback(static_cast<const Record&>(record)));
+    });
+    const char* badAttribute = unreadable.load();
+    return detail::UnreadableResult(std::move(scanned), badAttribute != nullptr ? badAttribute : "");
+}
+
+/**
+ * @brief Stream the records matching a key condition to a callback
+ *
+ * One record is reused for all items, so members keep their storage between
+ * items. Items that cannot be read end the query.
+ *
+ * @param manager The manager to query through
+ * @param tableName The name of the table
+ * @param options Key condition, index, projection and paging settings; a projection must include every required attribute
+ * @param callback Invoked with each record; return false to stop the query early
+ * @return OperationResult Success if the query completed or was stopped by the
+ *         callback; otherwise the request error or errors::kUnreadableItem
+ */
+template <typename Record, typename Callback>
+OperationResult QueryRecords(DynamoDBManager& manager, const std::string& tableName, const QueryOptions& options,
+                             Callback callback) {
+    const char* badAttribute = "";
+    Record record;
+    OperationResult queried = manager.Query(tableName, options, [&](const AttributeMap& item) {
+        if (!FromItem(item, record, &badAttribute)) {
+            AWSEXAMPLES_LOG(Error, "Cannot read attribute " << badAttribute << " of an item in " << tableName);
+            return false;
+        }
+        return static_cast<bool>(callback(static_cast<const Record&>(record)));
+    });
+    return detail::UnreadableResult(std::move(queried), badAttribute);
+}
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_ITEMMAPPING_H
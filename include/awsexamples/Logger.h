@@ -0,0 +1,174 @@
+/**
+ * @file Logger.h
+ * @brief Asynchronous, level-filtered logger used for the library's diagnostics
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_LOGGER_H
+#define AWSEXAMPLES_LOGGER_H
+
+#include <aws/core/utils/logging/LogLevel.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace awsexamples {
+namespace utils {
+
+/// Severity of a log message; the SDK's levels, so one setting controls both
+using LogLevel = Aws::Utils::Logging::LogLevel;
+
+/**
+ * @brief Destination of formatted log messages
+ *
+ * Called on the logger's writer thread only, one message at a time, so it need
+ * not be thread-safe. It should not call back into the logger.
+ */
+using LogSink = std::function<void(LogLevel level, const std::string& message)>;
+
+/**
+ * @class Logger
+ * @brief Process-wide logger that formats on the caller's thread and writes on its own
+ *
+ * A message below the current level costs one relaxed atomic load: the
+ * AWSEXAMPLES_LOG macro checks the level before evaluating its arguments.
+ * Enabled messages are queued and written by a background thread, so callers
+ * never wait on the console. If the queue is full, new messages are dropped and
+ * counted rather than blocking the caller.
+ *
+ * The level follows the SDK log level: AwsApiInitializer sets it from the
+ * SDKOptions it initializes the SDK with, and ConfigureClient from
+ * ClientOptions::logLevel. The default sink writes Info and more verbose
+ * messages to stdout and the rest to stderr.
+ */
+class Logger {
+public:
+    /**
+     * @brief Get the process-wide logger
+     *
+     * @return Logger& The logger instance
+     */
+    static Logger& Instance();
+
+    /**
+     * @brief Destructor that writes the queued messages and stops the writer thread
+     */
+    ~Logger();
+
+    // Delete copy and move operations
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Check whether messages of a level are written
+     *
+     * @param level The message's level
+     * @return bool True if the level is enabled
+     */
+    bool IsEnabled(LogLevel level) const {
+        return level != LogLevel::Off && static_cast<int>(level) <= threshold.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the most verbose level that is written
+     *
+     * @param level The new level; LogLevel::Off disables logging
+     */
+    void SetLevel(LogLevel level) { threshold.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the most verbose level that is written
+     *
+     * @return LogLevel The current level
+     */
+    LogLevel GetLevel() const { return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Replace the destination of log messages
+     *
+     * Messages already queued go to the new sink.
+     *
+     * @param sink The new destination, or nullptr to restore the console sink
+     */
+    void SetSink(LogSink sink);
+
+    /**
+     * @brief Queue a message for writing
+     *
+     * Does not check the level; use AWSEXAMPLES_LOG, which does so first.
+     *
+     * @param level The message's level
+     * @param message The formatted message, without a trailing newline
+     */
+    void Write(LogLevel level, std::string message);
+
+    /**
+     * @brief Wait until every queued message has been written
+     */
+    void Flush();
+
+    /**
+     * @brief Get the number of messages dropped because the queue was full
+     *
+     * @return std::uint64_t Messages dropped since the process started
+     */
+    std::uint64_t GetDropped() const;
+
+private:
+    /// A queued message
+    struct Entry {
+        LogLevel level;       ///< Severity
+        std::string message;  ///< Formatted text
+    };
+
+    Logger();
+
+    /**
+     * @brief Writer thread body: write queued messages until the logger is destroyed
+     */
+    void WriterLoop();
+
+    std::atomic<int> threshold;              ///< Most verbose enabled level, as an int
+    mutable std::mutex mutex;                ///< Guards every member below
+    std::condition_variable queueChanged;    ///< Signalled when messages are queued or written
+    std::deque<Entry> queue;                 ///< Messages waiting for the writer
+    LogSink sink;                            ///< Destination; null writes to the console
+    bool writing = false;                    ///< Set while the writer holds taken messages
+    bool stopping = false;                   ///< Set when the writer thread should exit
+    std::uint64_t dropped = 0;               ///< Messages rejected because the queue was full
+    std::thread writer;                      ///< Started by the first Write
+};
+
+}  // namespace utils
+}  // namespace awsexamples
+
+/**
+ * @brief Log a message built with stream insertions if its level is enabled
+ *
+ * The message expression is only evaluated when the level is enabled:
+ * @code
+ * AWSEXAMPLES_LOG(Error, "PutItem error: " << outcome.GetError().GetMessage());
+ * @endcode
+ *
+ * @param level A LogLevel enumerator name: Fatal, Error, Warn, Info, Debug or Trace
+ * @param message Values joined with <<, as for an std::ostream
+ */
+#define AWSEXAMPLES_LOG(level, message)                                                                        \
+    do {                                                                                                       \
+        auto& awsexamplesLogger = ::awsexamples::utils::Logger::Instance();                                   \
+        if (awsexamplesLogger.IsEnabled(::awsexamples::utils::LogLevel::level)) {                             \
+            std::ostringstream awsexamplesLogStream;                                                           \
+            awsexamplesLogStream << message;                                                                   \
+            awsexamplesLogger.Write(::awsexamples::utils::LogLevel::level, awsexamplesLogStream.str());        \
+        }                                                                                                      \
+    } while (false)
+
+#endif  // AWSEXAMPLES_LOGGER_H
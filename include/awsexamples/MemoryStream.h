@@ -0,0 +1,145 @@
+/**
+ * @file MemoryStream.h
+ * @brief Zero-copy request body streams backed by caller memory or a memory-mapped file
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_MEMORYSTREAM_H
+#define AWSEXAMPLES_MEMORYSTREAM_H
+
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace awsexamples {
+
+/**
+ * @class MappedFile
+ * @brief RAII read-only memory mapping of an entire file
+ *
+ * The mapping is shared between all streams created over it, so a large file can
+ * be uploaded as many parts without reading any of it into heap buffers.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map a file read-only
+     *
+     * @param filePath Path of the file to map; check IsOpen() for success
+     */
+    explicit MappedFile(const std::string& filePath);
+
+    /**
+     * @brief Destructor that unmaps the file
+     */
+    ~MappedFile();
+
+    // Delete copy and move operations
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /**
+     * @brief Check whether the file was opened and mapped
+     *
+     * @return bool True if the file is available, false otherwise
+     */
+    bool IsOpen() const { return open; }
+
+    /**
+     * @brief Get a pointer to the first byte of the mapping
+     *
+     * @return const char* Start of the file contents (nullptr for empty files)
+     */
+    const char* Data() const { return data; }
+
+    /**
+     * @brief Get the size of the mapped file
+     *
+     * @return std::size_t File size in bytes
+     */
+    std::size_t Size() const { return size; }
+
+private:
+    const char* data = nullptr; ///< Start of the mapping
+    std::size_t size = 0;       ///< Length of the mapping in bytes
+    bool open = false;          ///< Whether the file was opened successfully
+};
+
+/**
+ * @class MemoryViewStreamBuf
+ * @brief Read-only, seekable stream buffer over a contiguous range of memory
+ *
+ * The buffer never copies or owns the bytes it exposes. Seeking is supported so
+ * the SDK can compute content length and checksums and rewind for retries.
+ */
+class MemoryViewStreamBuf : public std::streambuf {
+public:
+    /**
+     * @brief Construct a view over [data, data + size)
+     *
+     * @param data First byte of the view
+     * @param size Number of bytes in the view
+     */
+    MemoryViewStreamBuf(const char* data, std::size_t size);
+
+protected:
+    std::streamsize showmanyc() override;
+    pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+};
+
+/**
+ * @class MemoryViewStream
+ * @brief Request body stream that reads caller memory or a MappedFile in place
+ *
+ * A view over caller memory does not extend the lifetime of that memory; the caller
+ * must keep it alive until the request using the stream has completed. A view over
+ * a MappedFile holds a reference that keeps the mapping alive.
+ */
+class MemoryViewStream : public Aws::IOStream {
+public:
+    /**
+     * @brief Construct a non-owning view of caller memory
+     *
+     * @param data First byte of the body
+     * @param size Number of bytes in the body
+     */
+    MemoryViewStream(const char* data, std::size_t size);
+
+    /**
+     * @brief Construct a view of part of a memory-mapped file
+     *
+     * @param file The mapping to read from
+     * @param offset Offset of the first byte of the view within the file
+     * @param length Number of bytes in the view
+     */
+    MemoryViewStream(std::shared_ptr<const MappedFile> file, std::size_t offset, std::size_t length);
+
+    /**
+     * @brief Construct a view of an entire memory-mapped file
+     *
+     * @param file The mapping to read from
+     */
+    explicit MemoryViewStream(std::shared_ptr<const MappedFile> file);
+
+    /**
+     * @brief Get the number of bytes in the view
+     *
+     * @return std::size_t Body size in bytes
+     */
+    std::size_t Size() const { return size; }
+
+private:
+    std::shared_ptr<const MappedFile> file; ///< Mapping kept alive by this view, if any
+    std::size_t size;                       ///< Number of bytes in the view
+    MemoryViewStreamBuf buffer;             ///< Stream buffer reading the viewed bytes
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_MEMORYSTREAM_H
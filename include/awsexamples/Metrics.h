@@ -0,0 +1,278 @@
+/**
+ * @file Metrics.h
+ * @brief Per-operation call counts, error classes, bytes and latency histograms
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_METRICS_H
+#define AWSEXAMPLES_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace awsexamples {
+namespace utils {
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of latencies in microseconds, in the style of HdrHistogram
+ *
+ * Values below 64 us are counted exactly; above that, every power of two is
+ * split into 32 equal buckets, so a reported quantile is at most 1/32 (about
+ * 3%) above the true value. Values up to 2^32 us (about 71 minutes) are kept;
+ * larger ones are counted in the last bucket. The counts take about 7 KB and
+ * do not grow with the number of values recorded.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;                                 ///< log2 of the buckets per power of two
+    static constexpr std::size_t kSubBucketCount = 1U << kSubBucketBits;     ///< Buckets per power of two
+    static constexpr int kMaxValueBits = 32;                                 ///< Values are kept up to 2^32 - 1
+    static constexpr std::size_t kBucketCount =
+        2 * kSubBucketCount + (kMaxValueBits - kSubBucketBits - 1) * kSubBucketCount;  ///< Number of buckets
+
+    /**
+     * @brief Get the bucket a value is counted in
+     *
+     * @param value The value in microseconds
+     * @return std::size_t The bucket index, below kBucketCount
+     */
+    static std::size_t BucketOf(std::uint64_t value);
+
+    /**
+     * @brief Get the largest value counted in a bucket
+     *
+     * @param bucket The bucket index
+     * @return std::uint64_t The bucket's upper bound in microseconds
+     */
+    static std::uint64_t BucketUpperBound(std::size_t bucket);
+
+    /**
+     * @brief Count a value
+     *
+     * @param value The latency in microseconds
+     * @param count How many times the value occurred
+     */
+    void Record(std::uint64_t value, std::uint64_t count = 1);
+
+    /**
+     * @brief Add the counts of another histogram
+     *
+     * @param other The histogram to add
+     */
+    void Merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Get the value below or at which a fraction of the values lie
+     *
+     * @param quantile The fraction, e.g. 0.99 for the 99th percentile
+     * @return std::uint64_t The upper bound of the bucket holding that value, capped at the maximum; 0 if empty
+     */
+    std::uint64_t ValueAtQuantile(double quantile) const;
+
+    std::uint64_t GetCount() const { return count; }  ///< Number of values recorded
+    std::uint64_t GetSum() const { return sum; }      ///< Sum of the values recorded
+    std::uint64_t GetMax() const { return max; }      ///< Largest value recorded
+
+    /**
+     * @brief Get the count of one bucket
+     *
+     * @param bucket The bucket index
+     * @return std::uint64_t Values counted in the bucket
+     */
+    std::uint64_t GetBucketCount(std::size_t bucket) const { return counts[bucket]; }
+
+private:
+    friend class MetricsRegistry;  // Merges per-thread bucket counts directly
+
+    std::array<std::uint64_t, kBucketCount> counts{};  ///< Values per bucket
+    std::uint64_t count = 0;                           ///< Values recorded
+    std::uint64_t sum = 0;                             ///< Sum of the values
+    std::uint64_t max = 0;                             ///< Largest value
+};
+
+/**
+ * @enum ErrorClass
+ * @brief Broad cause of a failed call, used to group errors in metrics
+ */
+enum class ErrorClass {
+    None,        ///< The call succeeded
+    Throttling,  ///< The service throttled the call
+    Client,      ///< Any other 4xx response, e.g. validation or access errors
+    Server,      ///< A 5xx response
+    Network      ///< No response: connection, DNS or timeout errors
+};
+
+/// Number of ErrorClass values
+constexpr std::size_t kErrorClassCount = 5;
+
+/**
+ * @brief Get the name of an error class as used in metric labels
+ *
+ * @param errorClass The error class
+ * @return const char* "none", "throttling", "client", "server" or "network"
+ */
+const char* ErrorClassName(ErrorClass errorClass);
+
+/**
+ * @struct OperationMetrics
+ * @brief Merged metrics of one operation, e.g. "PutItem"
+ */
+struct OperationMetrics {
+    std::uint64_t calls = 0;                                ///< Calls completed, including failed ones
+    std::uint64_t bytes = 0;                                ///< Payload bytes transferred by successful calls
+    std::array<std::uint64_t, kErrorClassCount> errors{};   ///< Failed calls by ErrorClass; index None is unused
+    LatencyHistogram latency;                               ///< Call latencies, including retries and backoff
+
+    /**
+     * @brief Get the failed calls of one class
+     *
+     * @param errorClass The error class
+     * @return std::uint64_t Failed calls of that class
+     */
+    std::uint64_t Errors(ErrorClass errorClass) const { return errors[static_cast<std::size_t>(errorClass)]; }
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Process-wide metrics of every call the managers make
+ *
+ * The managers record each call through the shared retry path: its latency
+ * including retries, and the class of its final error. S3 transfers also
+ * record their payload bytes.
+ *
+ * Recording takes no lock: each thread accumulates into its own counters,
+ * which only that thread writes, and Snapshot merges the counters of all
+ * threads when metrics are scraped. Counters of threads that have exited are
+ * kept and reused by new threads.
+ */
+class MetricsRegistry {
+public:
+    /// Operations tracked at most; calls of further operations are not recorded
+    static constexpr std::size_t kMaxOperations = 256;
+
+    /**
+     * @brief Get the process-wide registry
+     *
+     * @return MetricsRegistry& The registry instance
+     */
+    static MetricsRegistry& Instance();
+
+    /**
+     * @brief Destructor
+     */
+    ~MetricsRegistry();
+
+    // Delete copy and move operations
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Check whether calls are recorded
+     *
+     * @return bool True if recording is enabled (the default)
+     */
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable or disable recording
+     *
+     * @param enable Whether to record calls
+     */
+    void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a completed call, unless recording is disabled
+     *
+     * @param operation The operation name, e.g. "PutItem"
+     * @param latency The call's latency
+     * @param errorClass The class of its error, or ErrorClass::None on success
+     */
+    void Record(const std::string& operation, std::chrono::microseconds latency, ErrorClass errorClass);
+
+    /**
+     * @brief Add payload bytes transferred by a call, unless recording is disabled
+     *
+     * @param operation The operation name, e.g. "UploadPart"
+     * @param bytes The bytes sent or received
+     */
+    void AddBytes(const std::string& operation, std::uint64_t bytes);
+
+    /**
+     * @brief Merge the metrics of all threads
+     *
+     * @return std::map<std::string, OperationMetrics> Metrics by operation name
+     */
+    std::map<std::string, OperationMetrics> Snapshot() const;
+
+    /**
+     * @brief Write the metrics in the Prometheus text exposition format
+     *
+     * Call counts, error counts and bytes are counters; latencies are a summary
+     * in seconds with the 0.5, 0.9, 0.99 and 0.999 quantiles.
+     *
+     * @param out The stream to write to
+     */
+    void WritePrometheus(std::ostream& out) const;
+
+    /**
+     * @brief Write the metrics to a file for a textfile collector
+     *
+     * The file is written under a temporary name and renamed, so a scraper
+     * never reads a partial file.
+     *
+     * @param path The file to write, e.g. a node_exporter textfile directory entry ending in .prom
+     * @return bool True if the file was written
+     */
+    bool DumpToFile(const std::string& path) const;
+
+private:
+    struct Slot;
+    struct Shard;
+    friend struct ShardLease;
+
+    MetricsRegistry();
+
+    /**
+     * @brief Get the calling thread's counters of an operation, or nullptr past kMaxOperations
+     */
+    Slot* LocalSlot(const std::string& operation);
+
+    /**
+     * @brief Get the ID of an operation, assigning one on first use; kMaxOperations if none is left
+     */
+    std::size_t OperationId(const std::string& operation);
+
+    /**
+     * @brief Take a shard for the calling thread, reusing one released by an exited thread
+     */
+    Shard* AcquireShard();
+
+    /**
+     * @brief Give a shard back when its thread exits
+     */
+    void ReleaseShard(Shard* shard);
+
+    std::atomic<bool> enabled{true};                       ///< Whether calls are recorded
+    mutable std::mutex mutex;                              ///< Guards the members below
+    std::unordered_map<std::string, std::size_t> ids;      ///< Operation IDs by name
+    std::vector<std::string> names;                        ///< Operation names by ID
+    std::vector<std::unique_ptr<Shard>> shards;            ///< Every shard ever created
+    std::vector<Shard*> freeShards;                        ///< Shards of exited threads
+};
+
+}  // namespace utils
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_METRICS_H
@@ -0,0 +1,45 @@
+/**
+ * @file OperationResult.h
+ * @brief Structured outcome returned by the blocking manager operations
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_OPERATIONRESULT_H
+#define AWSEXAMPLES_OPERATIONRESULT_H
+
+#include <chrono>
+#include <string>
+
+namespace awsexamples {
+
+/**
+ * @struct OperationResult
+ * @brief What happened to an operation, for callers that handle errors instead of printing them
+ *
+ * Converts to true on success, so `if (manager.DeleteItem(table, id))` keeps
+ * working. For operations made of several requests (paged reads, multipart
+ * transfers, batches) the error is that of the first request that failed and
+ * the latency covers the whole operation.
+ */
+struct OperationResult {
+    bool success = false;      ///< Whether the operation completed
+    std::string errorType;     ///< SDK exception name, e.g. "ThrottlingException", or a client-side error; empty on success
+    std::string message;       ///< Error message; empty on success
+    bool retryable = false;    ///< Whether the error is transient, so the same call may succeed later
+    std::chrono::microseconds latency{0};  ///< Wall-clock time of the operation, including retries and backoff
+
+    explicit operator bool() const noexcept { return success; }
+};
+
+/// Client-side error types, reported without a request being sent or completed
+namespace errors {
+constexpr const char* kInvalidArgument = "InvalidArgument";  ///< The arguments cannot form a valid request
+constexpr const char* kIoError = "IoError";                  ///< A local file could not be read or written
+constexpr const char* kIncomplete = "Incomplete";            ///< Some parts of the operation gave up after retrying
+constexpr const char* kUnreadableItem = "UnreadableItem";    ///< An item did not match its record mapping
+}  // namespace errors
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_OPERATIONRESULT_H
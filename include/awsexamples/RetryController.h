@@ -0,0 +1,201 @@
+/**
+ * @file RetryController.h
+ * @brief Adaptive rate limiting, retry budget and backoff shared by the managers
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_RETRYCONTROLLER_H
+#define AWSEXAMPLES_RETRYCONTROLLER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace awsexamples {
+namespace utils {
+
+/**
+ * @struct RetryOptions
+ * @brief Tuning of a RetryController
+ */
+struct RetryOptions {
+    int maxAttempts = 3;                                  ///< Attempts per call, including the first
+    std::chrono::milliseconds baseDelay{50};              ///< Backoff cap of the first retry of a transient error
+    std::chrono::milliseconds throttleBaseDelay{500};     ///< Backoff cap of the first retry after throttling
+    std::chrono::milliseconds maxDelay{20000};            ///< Upper bound of any backoff
+    double retryBudget = 500;                             ///< Retry tokens available to the whole service
+    double retryCost = 5;                                 ///< Tokens taken by a retry of a transient error
+    double throttleRetryCost = 10;                        ///< Tokens taken by a retry after throttling
+    double successRefund = 1;                             ///< Tokens returned by a first-attempt success
+    double minRate = 1;                                   ///< Lowest admission rate, in calls per second
+    double decreaseFactor = 0.7;                          ///< Rate multiplier applied on throttling
+    double growthPerSecond = 0.05;                        ///< Relative rate increase per second of successes
+};
+
+/**
+ * @struct OperationCounters
+ * @brief Counters of one operation, e.g. "PutItem"
+ */
+struct OperationCounters {
+    std::uint64_t calls = 0;            ///< Calls made through the controller
+    std::uint64_t attempts = 0;         ///< Requests sent, including retries
+    std::uint64_t successes = 0;        ///< Calls that succeeded
+    std::uint64_t failures = 0;         ///< Calls that failed after all attempts
+    std::uint64_t throttled = 0;        ///< Attempts throttled, whole or in part (see OnThrottled)
+    std::uint64_t retries = 0;          ///< Retries made
+    std::uint64_t retriesDenied = 0;    ///< Retries refused because the budget was exhausted
+    std::uint64_t admissionDelayMs = 0; ///< Total time calls waited for admission
+    double admissionRate = 0;           ///< Current admission rate in calls per second; 0 when unlimited
+};
+
+/**
+ * @class RetryController
+ * @brief Admission control and retry decisions for the calls of one service
+ *
+ * Each operation has its own adaptive token bucket. It admits calls freely
+ * until the service first throttles that operation; from then on it admits
+ * calls at a rate that is cut by decreaseFactor on every throttling error and
+ * grows slowly while calls succeed, so sustained load settles just below the
+ * service limit. Retries use "full jitter" backoff and draw from a retry budget
+ * shared by all operations of the service, which stops retry storms when most
+ * calls are failing.
+ *
+ * The managers route their calls through the controller of their service (see
+ * ForService); all methods are thread-safe.
+ */
+class RetryController {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param options Retry and rate limiting settings
+     */
+    explicit RetryController(const RetryOptions& options = RetryOptions());
+
+    /**
+     * @brief Get the process-wide controller of a service
+     *
+     * @param service Service name, e.g. "s3", "dynamodb" or "ec2"
+     * @return std::shared_ptr<RetryController> The controller shared by all managers of the service
+     */
+    static std::shared_ptr<RetryController> ForService(const std::string& service);
+
+    /**
+     * @brief Check whether an error means the request was throttled
+     *
+     * @param exceptionName The error's exception name, e.g. "SlowDown"
+     * @param httpStatus The HTTP status code of the response
+     * @return bool True for throttling errors, false otherwise
+     */
+    static bool IsThrottlingError(const std::string& exceptionName, int httpStatus);
+
+    /**
+     * @brief Reserve a slot for the next attempt of an operation
+     *
+     * @param operation The operation name
+     * @return std::chrono::milliseconds How long the caller must wait before sending
+     */
+    std::chrono::milliseconds Admit(const std::string& operation);
+
+    /**
+     * @brief Record the start of a call
+     *
+     * @param operation The operation name
+     */
+    void OnCall(const std::string& operation);
+
+    /**
+     * @brief Record a successful attempt
+     *
+     * @param operation The operation name
+     * @param attempt The attempt number, starting at 1
+     */
+    void OnSuccess(const std::string& operation, int attempt);
+
+    /**
+     * @brief Record a failed attempt and decide whether to retry
+     *
+     * @param operation The operation name
+     * @param attempt The attempt number, starting at 1
+     * @param throttled Whether the error was a throttling error
+     * @param retryable Whether the error is worth retrying
+     * @param delay Receives the backoff before the retry
+     * @return bool True if the call should be retried, false otherwise
+     */
+    bool OnFailure(const std::string& operation,
+                   int attempt,
+                   bool throttled,
+                   bool retryable,
+                   std::chrono::milliseconds& delay);
+
+    /**
+     * @brief Record that a successful attempt left part of its work unprocessed
+     *
+     * Batch operations report throttling per item, e.g. the UnprocessedItems of
+     * BatchWriteItem, rather than failing the request. This lowers the admission
+     * rate of the operation as a throttling error would; the caller resubmits
+     * the remaining work itself.
+     *
+     * @param operation The operation name
+     */
+    void OnThrottled(const std::string& operation);
+
+    /**
+     * @brief Get the counters of every operation seen so far
+     *
+     * @return std::map<std::string, OperationCounters> Counters by operation name
+     */
+    std::map<std::string, OperationCounters> GetCounters() const;
+
+    /**
+     * @brief Get the retry tokens currently available
+     *
+     * @return double The remaining retry budget
+     */
+    double GetRetryBudget() const;
+
+    /**
+     * @brief Print the counters of every operation to stdout
+     */
+    void PrintCounters() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Rate limiter state and counters of one operation
+    struct OperationState {
+        OperationCounters counters;        ///< Exposed counters
+        bool limited = false;              ///< Whether admission is rate limited
+        double rate = 0;                   ///< Admission rate when limited
+        double tokens = 0;                 ///< Tokens in the bucket; negative when calls are queued
+        Clock::time_point lastRefill;      ///< Last time tokens were added
+        Clock::time_point lastGrowth;      ///< Last time the rate grew
+        double measuredRate = 0;           ///< Smoothed rate of attempts
+        Clock::time_point windowStart;     ///< Start of the current measuring window
+        std::uint64_t windowAttempts = 0;  ///< Attempts in the current measuring window
+    };
+
+    /**
+     * @brief Get the state of an operation, creating it if needed; mutex must be held
+     */
+    OperationState& State(const std::string& operation);
+
+    /**
+     * @brief Cut the admission rate of an operation after throttling; mutex must be held
+     */
+    void Throttle(OperationState& state, Clock::time_point now);
+
+    RetryOptions options;                           ///< Settings
+    mutable std::mutex mutex;                       ///< Guards all members below
+    double budget;                                  ///< Remaining retry tokens
+    std::map<std::string, OperationState> operations; ///< State by operation name
+};
+
+}  // namespace utils
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_RETRYCONTROLLER_H
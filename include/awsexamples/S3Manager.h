@@ -8,11 +8,70 @@
 #ifndef AWSEXAMPLES_S3MANAGER_H
 #define AWSEXAMPLES_S3MANAGER_H
 
+#include "awsexamples/AsyncTypes.h"
+#include "awsexamples/OperationResult.h"
+#include "awsexamples/RetryController.h"
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/Object.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
 #include <string>
 
 namespace awsexamples {
 
+/**
+ * @struct MultipartUploadOptions
+ * @brief Tuning parameters for multipart uploads
+ */
+struct MultipartUploadOptions {
+    std::size_t partSize = 8 * 1024 * 1024;  ///< Size of each part in bytes (S3 minimum is 5 MiB)
+    unsigned concurrency = 0;  ///< Parts uploaded in parallel; 0 uses the client's maxConnections
+};
+
+/**
+ * @struct RangedDownloadOptions
+ * @brief Tuning parameters for parallel ranged downloads
+ */
+struct RangedDownloadOptions {
+    std::size_t rangeSize = 8 * 1024 * 1024;  ///< Size of each byte range fetched with one GET
+    unsigned concurrency = 0;  ///< Ranges fetched in parallel; 0 uses the client's maxConnections
+    bool resume = true;        ///< Continue a previously interrupted download of the same object
+};
+
+/**
+ * @struct TransferStats
+ * @brief Summary of a completed (or failed) transfer
+ */
+struct TransferStats {
+    std::uint64_t bytesTransferred = 0;  ///< Number of payload bytes sent or received
+    std::size_t partCount = 0;           ///< Number of parts or ranges the transfer used
+    double elapsedSeconds = 0.0;         ///< Wall-clock duration of the transfer
+    double throughputMiBps = 0.0;        ///< Average throughput in MiB per second
+};
+
+/**
+ * @struct ParallelListOptions
+ * @brief Options for listing a bucket in parallel across key prefixes
+ */
+struct ParallelListOptions {
+    std::string prefix;         ///< Only list keys starting with this prefix
+    std::string delimiter = "/"; ///< Delimiter used to discover the prefixes to fan out over
+    int depth = 1;              ///< Delimiter levels to expand before listing each prefix in full
+    unsigned concurrency = 0;   ///< Prefixes listed in parallel; 0 uses the client's maxConnections
+};
+
+/**
+ * @brief Callback invoked for every listed object
+ *
+ * Return false to stop the listing early.
+ */
+using ObjectCallback = std::function<bool(const Aws::S3::Model::Object& object)>;
+
+class S3ObjectLister;
+
 /**
  * @class S3Manager
  * @brief A class to manage AWS S3 operations
@@ -32,10 +91,65 @@ public:
     /**
      * @brief Constructor with custom client configuration
      * 
+     * The client is taken from utils::ClientRegistry, so managers built from
+     * equal configurations share one client and its connection pool. The
+     * client's own SDK retries are turned off; the manager's RetryController
+     * makes every retry instead.
+     * 
      * @param config A custom AWS client configuration
      */
     explicit S3Manager(const Aws::Client::ClientConfiguration& config);
     
+    /**
+     * @brief Constructor with custom client configuration and addressing style
+     * 
+     * Path-style addressing (useVirtualAddressing = false) is required by most
+     * S3-compatible stand-ins such as MinIO when used with an endpoint override.
+     * As with the constructor above, SDK retries are turned off in favour of the
+     * manager's RetryController.
+     * 
+     * @param config A custom AWS client configuration
+     * @param useVirtualAddressing Whether to use virtual-hosted-style bucket addressing
+     */
+    S3Manager(const Aws::Client::ClientConfiguration& config, bool useVirtualAddressing);
+    
+    /**
+     * @brief Constructor using an existing, possibly shared, client
+     * 
+     * Calls are retried by the manager's RetryController, so the client should
+     * be built without SDK retries (e.g. retry_mode = none); otherwise every
+     * controller attempt may become several requests.
+     * 
+     * @param client The S3 client to use for all operations
+     * @param maxConnections Connection pool size of the client, used as default concurrency
+     */
+    explicit S3Manager(std::shared_ptr<Aws::S3::S3Client> client, unsigned maxConnections = 25);
+    
+    /**
+     * @brief Get the client used for all operations
+     * 
+     * @return std::shared_ptr<Aws::S3::S3Client> The (possibly shared) S3 client
+     */
+    std::shared_ptr<Aws::S3::S3Client> GetClient() const { return s3Client; }
+    
+    /**
+     * @brief Get the controller that rate limits and retries this manager's calls
+     * 
+     * @return std::shared_ptr<utils::RetryController> By default the controller shared by all S3 managers
+     */
+    std::shared_ptr<utils::RetryController> GetRetryController() const { return retryController; }
+    
+    /**
+     * @brief Route this manager's calls through another controller
+     * 
+     * Every call is admitted and retried by the controller except UploadStream
+     * and UploadStreamAsync: a caller-provided stream cannot be rewound for a
+     * retry, so those uploads are sent once, without admission control.
+     * 
+     * @param controller The controller to use, e.g. one with custom RetryOptions
+     */
+    void SetRetryController(std::shared_ptr<utils::RetryController> controller) { retryController = std::move(controller); }
+    
     /**
      * @brief List all S3 buckets available to the user
      */
@@ -46,17 +160,17 @@ public:
      * 
      * @param bucketName The name of the bucket to create
      * @param region The AWS region where the bucket should be created
-     * @return bool True if the bucket was created successfully, false otherwise
+     * @return OperationResult Success if the bucket was created successfully, otherwise the error
      */
-    bool CreateBucket(const std::string& bucketName, const std::string& region = "us-west-2");
+    OperationResult CreateBucket(const std::string& bucketName, const std::string& region = "us-west-2");
     
     /**
      * @brief Delete an S3 bucket
      * 
      * @param bucketName The name of the bucket to delete
-     * @return bool True if the bucket was deleted successfully, false otherwise
+     * @return OperationResult Success if the bucket was deleted successfully, otherwise the error
      */
-    bool DeleteBucket(const std::string& bucketName);
+    OperationResult DeleteBucket(const std::string& bucketName);
     
     /**
      * @brief Upload a file to S3
@@ -64,11 +178,32 @@ public:
      * @param bucketName The name of the bucket to upload to
      * @param keyName The key (object name) to assign to the uploaded file
      * @param filePath Local path to the file to be uploaded
-     * @return bool True if the file was uploaded successfully, false otherwise
+     * @return OperationResult Success if the file was uploaded successfully, otherwise the error
+     */
+    OperationResult UploadFile(const std::string& bucketName, 
+                              const std::string& keyName, 
+                              const std::string& filePath);
+    
+    /**
+     * @brief Upload a file to S3 using a parallel multipart upload
+     * 
+     * The file is split into parts of options.partSize bytes which are uploaded
+     * concurrently. Files no larger than a single part are sent with a plain
+     * PutObject request. If any part fails the multipart upload is aborted so
+     * no orphaned parts are left behind in the bucket.
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded file
+     * @param filePath Local path to the file to be uploaded
+     * @param options Part size and concurrency settings
+     * @param stats Optional output receiving size, duration and throughput of the upload
+     * @return OperationResult Success if the file was uploaded successfully, otherwise the error
      */
-    bool UploadFile(const std::string& bucketName, 
-                   const std::string& keyName, 
-                   const std::string& filePath);
+    OperationResult UploadFile(const std::string& bucketName, 
+                              const std::string& keyName, 
+                              const std::string& filePath,
+                              const MultipartUploadOptions& options,
+                              TransferStats* stats = nullptr);
     
     /**
      * @brief Upload text content to S3
@@ -76,11 +211,26 @@ public:
      * @param bucketName The name of the bucket to upload to
      * @param keyName The key (object name) to assign to the uploaded content
      * @param content The text content to upload
-     * @return bool True if the content was uploaded successfully, false otherwise
+     * @return OperationResult Success if the content was uploaded successfully, otherwise the error
      */
-    bool UploadText(const std::string& bucketName, 
-                   const std::string& keyName,
-                   const std::string& content);
+    OperationResult UploadText(const std::string& bucketName, 
+                              const std::string& keyName,
+                              const std::string& content);
+    
+    /**
+     * @brief Upload the contents of a stream to S3
+     * 
+     * Accepts any request body stream, including the zero-copy MemoryViewStream
+     * over caller memory or a MappedFile, which the SDK signs and sends in place.
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded content
+     * @param body Seekable stream positioned at the start of the content
+     * @return OperationResult Success if the content was uploaded successfully, otherwise the error
+     */
+    OperationResult UploadStream(const std::string& bucketName, 
+                                const std::string& keyName,
+                                const std::shared_ptr<Aws::IOStream>& body);
     
     /**
      * @brief Download a file from S3
@@ -88,20 +238,42 @@ public:
      * @param bucketName The name of the bucket to download from
      * @param keyName The key (object name) of the file to download
      * @param localPath Local path where the file should be saved
-     * @return bool True if the file was downloaded successfully, false otherwise
+     * @return OperationResult Success if the file was downloaded successfully, otherwise the error
      */
-    bool DownloadFile(const std::string& bucketName, 
-                     const std::string& keyName, 
-                     const std::string& localPath);
+    OperationResult DownloadFile(const std::string& bucketName, 
+                                const std::string& keyName, 
+                                const std::string& localPath);
+    
+    /**
+     * @brief Download a file from S3 using parallel ranged GET requests
+     * 
+     * The object size is read with a HEAD request, the local file is preallocated,
+     * and byte ranges are fetched concurrently, each written directly to its offset
+     * in the file with pwrite. Completed ranges are recorded in a "<localPath>.parts"
+     * journal; if the download is interrupted, calling this again with resume enabled
+     * fetches only the missing ranges, provided the object's ETag has not changed.
+     * 
+     * @param bucketName The name of the bucket to download from
+     * @param keyName The key (object name) of the file to download
+     * @param localPath Local path where the file should be saved
+     * @param options Range size, concurrency and resume settings
+     * @param stats Optional output receiving size, duration and throughput of the download
+     * @return OperationResult Success if the file was downloaded completely, otherwise the error
+     */
+    OperationResult DownloadFile(const std::string& bucketName, 
+                                const std::string& keyName, 
+                                const std::string& localPath,
+                                const RangedDownloadOptions& options,
+                                TransferStats* stats = nullptr);
     
     /**
      * @brief Delete an object from S3
      * 
      * @param bucketName The name of the bucket containing the object
      * @param keyName The key (object name) of the object to delete
-     * @return bool True if the object was deleted successfully, false otherwise
+     * @return OperationResult Success if the object was deleted successfully, otherwise the error
      */
-    bool DeleteObject(const std::string& bucketName, const std::string& keyName);
+    OperationResult DeleteObject(const std::string& bucketName, const std::string& keyName);
     
     /**
      * @brief List objects in an S3 bucket
@@ -109,9 +281,212 @@ public:
      * @param bucketName The name of the bucket to list objects from
      */
     void ListObjects(const std::string& bucketName);
+    
+    /**
+     * @brief List every object under a prefix, fanning out across sub-prefixes in parallel
+     * 
+     * The prefix is first listed with the delimiter to discover its sub-prefixes,
+     * repeated for @c depth levels; objects found along the way are passed to the
+     * callback directly. Each discovered prefix is then listed in full on its own
+     * thread, so large inventories are spread over many concurrent paginations.
+     * Objects arrive in no particular order and the callback is invoked concurrently
+     * from several threads, so it must be thread-safe.
+     * 
+     * @param bucketName The name of the bucket to list objects from
+     * @param options Root prefix, delimiter, expansion depth and concurrency
+     * @param callback Invoked for every object; returning false stops the listing
+     * @return OperationResult Success if the listing completed or was stopped by the callback, otherwise the error
+     */
+    OperationResult ListObjectsParallel(const std::string& bucketName,
+                                        const ParallelListOptions& options,
+                                        const ObjectCallback& callback);
+    
+    /**
+     * @brief Create a new S3 bucket without blocking the caller
+     * 
+     * The asynchronous variants run on the client's executor and report the same
+     * messages as their blocking counterparts; see CompletionCallback for the
+     * threading rules that apply to callbacks.
+     * 
+     * @param bucketName The name of the bucket to create
+     * @param region The AWS region where the bucket should be created
+     * @param callback Invoked with true if the bucket was created successfully
+     */
+    void CreateBucketAsync(const std::string& bucketName,
+                           const std::string& region,
+                           CompletionCallback callback);
+    
+    /**
+     * @brief Create a new S3 bucket without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to create
+     * @param region The AWS region where the bucket should be created
+     * @return std::future<bool> Becomes true if the bucket was created successfully
+     */
+    std::future<bool> CreateBucketAsync(const std::string& bucketName,
+                                        const std::string& region = "us-west-2");
+    
+    /**
+     * @brief Delete an S3 bucket without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to delete
+     * @param callback Invoked with true if the bucket was deleted successfully
+     */
+    void DeleteBucketAsync(const std::string& bucketName, CompletionCallback callback);
+    
+    /**
+     * @brief Delete an S3 bucket without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to delete
+     * @return std::future<bool> Becomes true if the bucket was deleted successfully
+     */
+    std::future<bool> DeleteBucketAsync(const std::string& bucketName);
+    
+    /**
+     * @brief Upload a file to S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded file
+     * @param filePath Local path to the file to be uploaded
+     * @param callback Invoked with true if the file was uploaded successfully
+     */
+    void UploadFileAsync(const std::string& bucketName,
+                         const std::string& keyName,
+                         const std::string& filePath,
+                         CompletionCallback callback);
+    
+    /**
+     * @brief Upload a file to S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded file
+     * @param filePath Local path to the file to be uploaded
+     * @return std::future<bool> Becomes true if the file was uploaded successfully
+     */
+    std::future<bool> UploadFileAsync(const std::string& bucketName,
+                                      const std::string& keyName,
+                                      const std::string& filePath);
+    
+    /**
+     * @brief Upload text content to S3 without blocking the caller
+     * 
+     * The content is copied once, so the caller's string may go away immediately.
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded content
+     * @param content The text content to upload
+     * @param callback Invoked with true if the content was uploaded successfully
+     */
+    void UploadTextAsync(const std::string& bucketName,
+                         const std::string& keyName,
+                         const std::string& content,
+                         CompletionCallback callback);
+    
+    /**
+     * @brief Upload text content to S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded content
+     * @param content The text content to upload
+     * @return std::future<bool> Becomes true if the content was uploaded successfully
+     */
+    std::future<bool> UploadTextAsync(const std::string& bucketName,
+                                      const std::string& keyName,
+                                      const std::string& content);
+    
+    /**
+     * @brief Upload the contents of a stream to S3 without blocking the caller
+     * 
+     * The stream is shared with the request and must not be used by the caller
+     * until the operation completes.
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded content
+     * @param body Seekable stream positioned at the start of the content
+     * @param callback Invoked with true if the content was uploaded successfully
+     */
+    void UploadStreamAsync(const std::string& bucketName,
+                           const std::string& keyName,
+                           const std::shared_ptr<Aws::IOStream>& body,
+                           CompletionCallback callback);
+    
+    /**
+     * @brief Upload the contents of a stream to S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to upload to
+     * @param keyName The key (object name) to assign to the uploaded content
+     * @param body Seekable stream positioned at the start of the content
+     * @return std::future<bool> Becomes true if the content was uploaded successfully
+     */
+    std::future<bool> UploadStreamAsync(const std::string& bucketName,
+                                        const std::string& keyName,
+                                        const std::shared_ptr<Aws::IOStream>& body);
+    
+    /**
+     * @brief Download a file from S3 without blocking the caller
+     * 
+     * The response body is streamed straight into the local file, which is
+     * removed again if the download fails.
+     * 
+     * @param bucketName The name of the bucket to download from
+     * @param keyName The key (object name) of the file to download
+     * @param localPath Local path where the file should be saved
+     * @param callback Invoked with true if the file was downloaded successfully
+     */
+    void DownloadFileAsync(const std::string& bucketName,
+                           const std::string& keyName,
+                           const std::string& localPath,
+                           CompletionCallback callback);
+    
+    /**
+     * @brief Download a file from S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket to download from
+     * @param keyName The key (object name) of the file to download
+     * @param localPath Local path where the file should be saved
+     * @return std::future<bool> Becomes true if the file was downloaded successfully
+     */
+    std::future<bool> DownloadFileAsync(const std::string& bucketName,
+                                        const std::string& keyName,
+                                        const std::string& localPath);
+    
+    /**
+     * @brief Delete an object from S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket containing the object
+     * @param keyName The key (object name) of the object to delete
+     * @param callback Invoked with true if the object was deleted successfully
+     */
+    void DeleteObjectAsync(const std::string& bucketName,
+                           const std::string& keyName,
+                           CompletionCallback callback);
+    
+    /**
+     * @brief Delete an object from S3 without blocking the caller
+     * 
+     * @param bucketName The name of the bucket containing the object
+     * @param keyName The key (object name) of the object to delete
+     * @return std::future<bool> Becomes true if the object was deleted successfully
+     */
+    std::future<bool> DeleteObjectAsync(const std::string& bucketName, const std::string& keyName);
 
 private:
-    Aws::S3::S3Client s3Client; ///< AWS S3 client used for all operations
+    friend class S3ObjectLister;
+    
+    std::shared_ptr<Aws::S3::S3Client> s3Client; ///< AWS S3 client used for all operations
+    unsigned maxConnections;    ///< Connection pool size of the client, used as default concurrency
+    std::shared_ptr<utils::RetryController> retryController; ///< Rate limits and retries every call
+    
+    /**
+     * @brief Abort a multipart upload and discard any parts already stored
+     * 
+     * @param bucketName The name of the bucket the upload targets
+     * @param keyName The key of the object being uploaded
+     * @param uploadId The ID returned by CreateMultipartUpload
+     */
+    void AbortMultipartUpload(const std::string& bucketName,
+                              const std::string& keyName,
+                              const std::string& uploadId);
 };
 
 }  // namespace awsexamples
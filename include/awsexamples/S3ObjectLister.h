@@ -0,0 +1,169 @@
+/**
+ * @file S3ObjectLister.h
+ * @brief S3ObjectLister class declaration for streaming S3 object listings
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_S3OBJECTLISTER_H
+#define AWSEXAMPLES_S3OBJECTLISTER_H
+
+#include "awsexamples/S3Manager.h"
+#include <aws/s3/model/ListObjectsV2Request.h>
+#include <aws/s3/model/Object.h>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace awsexamples {
+
+/**
+ * @struct ListObjectsOptions
+ * @brief Options controlling a streaming object listing
+ */
+struct ListObjectsOptions {
+    std::string prefix;      ///< Only list keys starting with this prefix
+    std::string delimiter;   ///< Group keys by this delimiter; grouped keys are not returned
+    int pageSize = 1000;     ///< Keys requested per ListObjectsV2 call (S3 maximum is 1000)
+    bool prefetch = true;    ///< Fetch the next page while the caller consumes the current one
+};
+
+/**
+ * @class S3ObjectLister
+ * @brief Lazy, paginated listing of the objects in a bucket
+ *
+ * Objects are produced one at a time with Next() or a range-based for loop,
+ * following continuation tokens until the listing is exhausted. Only the current
+ * page (and, with prefetching, the next one) is held in memory. With prefetching
+ * the request for the next page is issued as soon as the current page arrives,
+ * so network latency overlaps with the caller's processing.
+ *
+ * The lister shares the manager's client, so it may outlive the manager.
+ */
+class S3ObjectLister {
+public:
+    /**
+     * @class Iterator
+     * @brief Single-pass input iterator over the listed objects
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Aws::S3::Model::Object;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Aws::S3::Model::Object*;
+        using reference = const Aws::S3::Model::Object&;
+
+        Iterator() = default;
+        explicit Iterator(S3ObjectLister* lister) : lister(lister) { ++*this; }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        Iterator& operator++() {
+            if (lister != nullptr && !lister->Next(current)) {
+                lister = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return lister == other.lister; }
+        bool operator!=(const Iterator& other) const { return lister != other.lister; }
+
+    private:
+        S3ObjectLister* lister = nullptr;    ///< Source of objects; nullptr at the end
+        Aws::S3::Model::Object current;      ///< Object the iterator points at
+    };
+
+    /**
+     * @brief Constructor; with prefetching enabled the first page is requested immediately
+     *
+     * @param manager The manager whose client is used for all requests
+     * @param bucketName The name of the bucket to list
+     * @param options Prefix, delimiter, page size and prefetch settings
+     */
+    S3ObjectLister(S3Manager& manager,
+                   const std::string& bucketName,
+                   const ListObjectsOptions& options = ListObjectsOptions());
+
+    /**
+     * @brief Destructor that waits for an outstanding prefetch to finish
+     */
+    ~S3ObjectLister();
+
+    // Delete copy and move operations
+    S3ObjectLister(const S3ObjectLister&) = delete;
+    S3ObjectLister& operator=(const S3ObjectLister&) = delete;
+    S3ObjectLister(S3ObjectLister&&) = delete;
+    S3ObjectLister& operator=(S3ObjectLister&&) = delete;
+
+    /**
+     * @brief Get the next object of the listing
+     *
+     * @param object Receives the next object
+     * @return bool True if an object was produced, false at the end or on error
+     */
+    bool Next(Aws::S3::Model::Object& object);
+
+    /**
+     * @brief Get the common prefixes returned so far when a delimiter is set
+     *
+     * @return const Aws::Vector<Aws::String>& Prefixes from all pages fetched so far
+     */
+    const Aws::Vector<Aws::String>& GetCommonPrefixes() const { return commonPrefixes; }
+
+    /**
+     * @brief Check whether the listing stopped because of an error
+     *
+     * @return bool True if a ListObjectsV2 call failed, false otherwise
+     */
+    bool Failed() const { return failed; }
+
+    /**
+     * @brief Get the error of the failed ListObjectsV2 call
+     *
+     * @return const Aws::S3::S3Error& The error; only meaningful when Failed() is true
+     */
+    const Aws::S3::S3Error& GetError() const { return error; }
+
+    /**
+     * @brief Start iterating over the remaining objects
+     *
+     * @return Iterator Iterator positioned at the next object
+     */
+    Iterator begin() { return Iterator(this); }
+
+    /**
+     * @brief Get the end-of-listing sentinel
+     *
+     * @return Iterator Iterator that compares equal to exhausted iterators
+     */
+    Iterator end() { return Iterator(); }
+
+private:
+    std::shared_ptr<const Aws::S3::S3Client> s3Client; ///< Client used for all requests
+    std::shared_ptr<utils::RetryController> retryController; ///< Retries pages of the manager's service
+    Aws::S3::Model::ListObjectsV2Request request; ///< Request for the next page
+    bool prefetch;                        ///< Whether pages are requested ahead of time
+    Aws::S3::Model::ListObjectsV2Outcome currentPage; ///< Page objects are served from
+    std::future<Aws::S3::Model::ListObjectsV2Outcome> nextPage; ///< Page being prefetched
+    std::size_t position = 0;             ///< Index of the next object in currentPage
+    bool hasPage = false;                 ///< Whether currentPage holds a result
+    bool finished = false;                ///< Whether the last page has been fetched
+    bool failed = false;                  ///< Whether a request failed
+    Aws::S3::S3Error error;               ///< Error of the failed request
+    Aws::Vector<Aws::String> commonPrefixes; ///< Common prefixes collected so far
+
+    /**
+     * @brief Replace the current page with the next one
+     *
+     * @return bool True if a page was fetched, false at the end or on error
+     */
+    bool FetchNextPage();
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_S3OBJECTLISTER_H
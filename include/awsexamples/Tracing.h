@@ -0,0 +1,188 @@
+/**
+ * @file Tracing.h
+ * @brief Opt-in request tracing into a ring buffer, exported as a Chrome trace
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_TRACING_H
+#define AWSEXAMPLES_TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace awsexamples {
+namespace utils {
+
+/**
+ * @enum TraceKind
+ * @brief What a trace event spans
+ */
+enum class TraceKind {
+    Operation,  ///< One call through the retry path: every attempt, admission wait and backoff
+    Attempt,    ///< One HTTP request sent by the SDK
+    Scope       ///< A TraceScope, e.g. a whole multipart transfer
+};
+
+/**
+ * @struct TraceEvent
+ * @brief One completed span
+ *
+ * The phase timings of an attempt come from the SDK's HTTP client. They are in
+ * whole milliseconds since the attempt started, and -1 if the client did not
+ * report them. A reused connection reports no TLS time.
+ */
+struct TraceEvent {
+    TraceKind kind = TraceKind::Operation;                ///< What the event spans
+    std::string name;                                     ///< Operation, request or scope name
+    std::string service;                                  ///< Service of an attempt, e.g. "S3"
+    std::string errorType;                                ///< Error of a failed operation or attempt; empty on success
+    std::uint32_t thread = 0;                             ///< Small ID of the thread the span ended on
+    std::chrono::steady_clock::time_point start;          ///< When the span began
+    std::chrono::microseconds duration{0};                ///< How long it took
+    int attempts = 0;                                     ///< Operation: attempts sent
+    std::chrono::microseconds retryDelay{0};              ///< Operation: time spent in admission waits and backoff
+    int status = 0;                                       ///< Attempt: HTTP status, 0 if no response arrived
+    std::int64_t dnsMillis = -1;                          ///< Attempt: name lookup done
+    std::int64_t tlsMillis = -1;                          ///< Attempt: TCP connect and TLS handshake done
+    std::int64_t firstByteMillis = -1;                    ///< Attempt: first response byte received
+};
+
+/**
+ * @class Tracer
+ * @brief Process-wide ring buffer of the most recent trace events
+ *
+ * Tracing is off by default; a disabled tracer costs one relaxed atomic load
+ * per call. Once enabled, every call through the managers' retry path records
+ * an Operation event, and every HTTP request an Attempt event with its phase
+ * timings, reported through the SDK's monitoring interface that
+ * AwsApiInitializer installs. When the buffer is full the oldest events are
+ * overwritten.
+ */
+class Tracer {
+public:
+    /// Events kept by default
+    static constexpr std::size_t kDefaultCapacity = 16384;
+
+    /**
+     * @brief Get the process-wide tracer
+     *
+     * @return Tracer& The tracer instance
+     */
+    static Tracer& Instance();
+
+    // Delete copy and move operations
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * @brief Check whether events are recorded
+     *
+     * @return bool True if tracing is enabled
+     */
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start recording into an empty buffer
+     *
+     * @param capacity Events kept; older ones are overwritten
+     */
+    void Enable(std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Stop recording, keeping the events recorded so far
+     */
+    void Disable();
+
+    /**
+     * @brief Record a completed span, unless tracing is disabled
+     *
+     * @param event The span; its thread is set to the calling thread
+     */
+    void Record(const TraceEvent& event);
+
+    /**
+     * @brief Get the events in the buffer
+     *
+     * @return std::vector<TraceEvent> The events, oldest first
+     */
+    std::vector<TraceEvent> Events() const;
+
+    /**
+     * @brief Get the number of events overwritten because the buffer was full
+     *
+     * @return std::uint64_t Events lost since tracing was enabled
+     */
+    std::uint64_t GetOverwritten() const;
+
+    /**
+     * @brief Write the events in the Chrome trace event format
+     *
+     * The output loads in chrome://tracing and Perfetto. Spans of one thread
+     * nest: operations contain their attempts, and attempts contain slices for
+     * name lookup, connection setup, waiting for the first byte and transfer.
+     *
+     * @param out The stream to write to
+     */
+    void WriteChromeTrace(std::ostream& out) const;
+
+    /**
+     * @brief Write the events to a Chrome trace file
+     *
+     * @param path The file to write, e.g. "trace.json"
+     * @return bool True if the file was written
+     */
+    bool DumpToFile(const std::string& path) const;
+
+private:
+    Tracer() = default;
+
+    std::atomic<bool> enabled{false};  ///< Whether events are recorded
+    mutable std::mutex mutex;          ///< Guards the members below
+    std::vector<TraceEvent> ring;      ///< Event slots
+    std::size_t next = 0;              ///< Slot the next event goes to
+    std::uint64_t recorded = 0;        ///< Events recorded since enabled
+};
+
+/**
+ * @class TraceScope
+ * @brief Records a Scope event covering its lifetime
+ *
+ * Wraps operations made of several calls, so their calls nest under one span:
+ * @code
+ * utils::TraceScope scope("ImportTable");
+ * @endcode
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Start the span if tracing is enabled
+     *
+     * @param name The span name
+     */
+    explicit TraceScope(const char* name);
+
+    /**
+     * @brief Record the span
+     */
+    ~TraceScope();
+
+    // Delete copy and move operations
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;                             ///< Span name; nullptr if tracing was disabled
+    std::chrono::steady_clock::time_point start;  ///< When the span began
+};
+
+}  // namespace utils
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_TRACING_H
@@ -0,0 +1,116 @@
+/**
+ * @file Waiter.h
+ * @brief Shared timer thread that drives polling waits without blocking callers
+ * @author AWS Example Team
+ * @date 2026-10-16
+ */
+
+#ifndef AWSEXAMPLES_WAITER_H
+#define AWSEXAMPLES_WAITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace awsexamples {
+
+/**
+ * @struct WaitOptions
+ * @brief Polling schedule of a wait for a resource state
+ *
+ * The first check is made after initialDelay; each following delay doubles, up
+ * to maxDelay. Each delay is jittered to between half and all of that value, so
+ * waits that start together spread their checks. The wait fails once timeout has
+ * passed without the resource reaching the target state.
+ */
+struct WaitOptions {
+    std::chrono::milliseconds initialDelay{250};  ///< Delay before the first check
+    std::chrono::milliseconds maxDelay{15000};    ///< Upper bound of the delay between checks
+    std::chrono::milliseconds timeout{120000};    ///< Time after which the wait fails
+};
+
+/**
+ * @class Waiter
+ * @brief Runs delayed tasks for all pending waits on a single background thread
+ *
+ * Waits do not block a thread between checks: each check is a task scheduled
+ * on the waiter, which starts an asynchronous describe call and schedules the
+ * next check from its completion handler. Tasks run on the waiter thread, so
+ * they must not block; they should only start asynchronous work.
+ */
+class Waiter {
+public:
+    /**
+     * @brief Task run by the waiter
+     *
+     * Called with true when the task is due, or with false if the waiter shuts
+     * down first, in which case the task should report its wait as failed.
+     */
+    using Task = std::function<void(bool run)>;
+
+    /**
+     * @brief Get the process-wide waiter
+     *
+     * @return Waiter& The waiter shared by all managers
+     */
+    static Waiter& Instance();
+
+    Waiter(const Waiter&) = delete;
+    Waiter& operator=(const Waiter&) = delete;
+
+    /**
+     * @brief Destructor; cancels any pending tasks
+     */
+    ~Waiter();
+
+    /**
+     * @brief Run a task after a delay
+     *
+     * The waiter thread is started on first use. Tasks due at the same time run
+     * in the order they were scheduled.
+     *
+     * @param delay Time to wait before running the task
+     * @param task The task to run
+     */
+    void Schedule(std::chrono::milliseconds delay, Task task);
+
+    /**
+     * @brief Stop the waiter thread and cancel all pending tasks
+     *
+     * Called by utils::AwsApiInitializer before the SDK shuts down. The waiter
+     * starts again if another task is scheduled afterwards. Must not be called
+     * from a task.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Get the number of tasks that have not run yet
+     *
+     * @return std::size_t The number of pending tasks
+     */
+    std::size_t Pending() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Waiter() = default;
+
+    /**
+     * @brief Body of the waiter thread
+     */
+    void Run();
+
+    mutable std::mutex mutex;                       ///< Guards all members below
+    std::condition_variable wakeup;                 ///< Signalled when a task is added or on shutdown
+    std::multimap<Clock::time_point, Task> tasks;   ///< Pending tasks by due time
+    std::thread thread;                             ///< The waiter thread, once started
+    bool stopping = false;                          ///< Set while Shutdown is in progress
+};
+
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_WAITER_H
@@ -4,10 +4,12 @@
  */
 
 #include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/DynamoDBBatchWriter.h"
 #include "awsexamples/AwsUtils.h"
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <cstdlib>
 
 /**
  * This example demonstrates how to use the DynamoDBManager class to:
@@ -15,11 +17,17 @@
  * - Add items to the table
  * - Retrieve items from the table
  * - Scan the table for all items
+ * - Bulk-load items with the batch writer
  * - Delete items and the table
+ *
+ * Set AWSEXAMPLES_DYNAMODB_ENDPOINT (e.g. "http://localhost:8000") to run
+ * against DynamoDB Local instead of AWS.
  */
 int main(int argc, char** argv) {
-    // Initialize AWS SDK
-    awsexamples::utils::AwsApiInitializer awsInitializer;
+    // Initialize AWS SDK at the configured log level
+    awsexamples::utils::ClientOptions clientOptions = awsexamples::utils::LoadClientOptions();
+    awsexamples::utils::AwsApiInitializer awsInitializer(
+        awsexamples::utils::CreateDefaultSDKOptions(clientOptions.logLevel));
     
     try {
         // Generate a unique table name with timestamp to avoid conflicts
@@ -30,8 +38,16 @@ int main(int argc, char** argv) {
         
         std::cout << "DynamoDB Example - Using table name: " << tableName << std::endl;
         
-        // Create DynamoDB Manager
-        awsexamples::DynamoDBManager dynamodbManager;
+        // Create DynamoDB Manager, optionally pointed at DynamoDB Local
+        Aws::Client::ClientConfiguration config = awsexamples::utils::ConfigureClient(clientOptions);
+        if (const char* endpoint = std::getenv("AWSEXAMPLES_DYNAMODB_ENDPOINT")) {
+            std::cout << "Using DynamoDB endpoint override: " << endpoint << std::endl;
+            config.endpointOverride = endpoint;
+            if (std::string(endpoint).rfind("http://", 0) == 0) {
+                config.scheme = Aws::Http::Scheme::HTTP;
+            }
+        }
+        awsexamples::DynamoDBManager dynamodbManager(config);
         
         // Create table
         std::cout << "\n=== Creating DynamoDB Table ===" << std::endl;
@@ -63,6 +79,24 @@ int main(int argc, char** argv) {
                 std::cout << "\n=== Items After Deletion ===" << std::endl;
                 dynamodbManager.ScanTable(tableName);
                 
+                // Bulk-load items with the batch writer
+                std::cout << "\n=== Batch Loading Items ===" << std::endl;
+                {
+                    awsexamples::DynamoDBBatchWriter writer(dynamodbManager, tableName);
+                    for (int i = 0; i < 100; ++i) {
+                        awsexamples::AttributeMap item;
+                        item["id"].SetS("batch" + std::to_string(i));
+                        item["name"].SetS("Batch User " + std::to_string(i));
+                        item["age"].SetN(std::to_string(20 + i % 50));
+                        writer.Put(item);
+                    }
+                    writer.Flush();
+                    
+                    awsexamples::BatchWriterStats stats = writer.GetStats();
+                    std::cout << "Wrote " << stats.itemsWritten << " items in " << stats.requests
+                              << " requests (" << stats.itemsPerSecond << " items/s)" << std::endl;
+                }
+                
                 // Delete the table
                 std::cout << "\n=== Deleting Table ===" << std::endl;
                 if (dynamodbManager.DeleteTable(tableName)) {
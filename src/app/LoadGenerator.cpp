@@ -0,0 +1,701 @@
+/**
+ * @file LoadGenerator.cpp
+ * @brief Open-loop load generator for S3 and DynamoDB built on the managers
+ */
+
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/MemoryStream.h"
+#include "awsexamples/Metrics.h"
+#include "awsexamples/S3Manager.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using awsexamples::utils::LatencyHistogram;
+
+constexpr std::size_t kMaxItemSize = 399 * 1024;  // DynamoDB items are limited to 400 KB
+
+Clock::duration Seconds(double seconds) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+const char* const kUsage =
+    "Usage: load-generator <s3|dynamodb> [options]\n"
+    "\n"
+    "  --rate=N           Start N requests per second (open loop); 0 runs closed loop (default: 100)\n"
+    "  --concurrency=N    Requests in flight at most (default: 64)\n"
+    "  --duration=S       Seconds to measure (default: 30)\n"
+    "  --warmup=S         Seconds to run before measuring (default: 0)\n"
+    "  --read-ratio=F     Fraction of requests that are reads (default: 0.5)\n"
+    "  --size=DIST        Object or item size: N, uniform:MIN:MAX or lognormal:MEDIAN:SIGMA[:MAX],\n"
+    "                     with optional K, M or G suffixes (default: 4K)\n"
+    "  --keys=N           Keys read and written, chosen uniformly (default: 1000)\n"
+    "  --arrivals=KIND    Request spacing at --rate: uniform or poisson (default: uniform)\n"
+    "  --no-preload       Do not write every key before the run\n"
+    "  --bucket=NAME      Use an existing bucket instead of creating and deleting one\n"
+    "  --table=NAME       Use an existing table (hash key \"id\") instead of creating and deleting one\n"
+    "  --interval=S       Seconds between progress lines; 0 disables them (default: 1)\n"
+    "  --seed=N           Seed for sizes, keys and the read/write mix (default: 1)\n";
+
+/**
+ * Distribution of object or item sizes
+ */
+class SizeDistribution {
+public:
+    // Parse "N", "uniform:MIN:MAX" or "lognormal:MEDIAN:SIGMA[:MAX]"
+    bool Parse(const std::string& text) {
+        std::vector<std::string> fields;
+        for (std::size_t start = 0;;) {
+            const std::size_t colon = text.find(':', start);
+            fields.push_back(text.substr(start, colon == std::string::npos ? std::string::npos : colon - start));
+            if (colon == std::string::npos) {
+                break;
+            }
+            start = colon + 1;
+        }
+        if (fields.size() == 1) {
+            kind = Kind::Fixed;
+            return ParseBytes(fields[0], low) && (high = low) > 0;
+        }
+        if (fields[0] == "uniform" && fields.size() == 3) {
+            kind = Kind::Uniform;
+            return ParseBytes(fields[1], low) && ParseBytes(fields[2], high) && low > 0 && low <= high;
+        }
+        if (fields[0] == "lognormal" && (fields.size() == 3 || fields.size() == 4)) {
+            kind = Kind::LogNormal;
+            char* end = nullptr;
+            sigma = std::strtod(fields[2].c_str(), &end);
+            if (!ParseBytes(fields[1], low) || low == 0 || *end != '\0' || sigma < 0) {
+                return false;
+            }
+            high = low * 64;
+            return fields.size() == 3 || (ParseBytes(fields[3], high) && high >= low);
+        }
+        return false;
+    }
+
+    // Draw a size between 1 and Max()
+    std::size_t Draw(std::mt19937_64& random) const {
+        switch (kind) {
+            case Kind::Uniform:
+                return std::uniform_int_distribution<std::size_t>(low, high)(random);
+            case Kind::LogNormal: {
+                const double median = static_cast<double>(low);
+                const double size = std::lognormal_distribution<double>(std::log(median), sigma)(random);
+                return std::min(high, std::max<std::size_t>(1, static_cast<std::size_t>(size)));
+            }
+            default:
+                return low;
+        }
+    }
+
+    std::size_t Max() const { return high; }
+
+    std::string Describe() const {
+        switch (kind) {
+            case Kind::Uniform:
+                return "uniform " + std::to_string(low) + "-" + std::to_string(high) + " bytes";
+            case Kind::LogNormal:
+                return "lognormal, median " + std::to_string(low) + " bytes, sigma " + std::to_string(sigma) +
+                       ", at most " + std::to_string(high) + " bytes";
+            default:
+                return std::to_string(low) + " bytes";
+        }
+    }
+
+private:
+    enum class Kind { Fixed, Uniform, LogNormal };
+
+    // Parse a byte count with an optional K, M or G (binary) suffix
+    static bool ParseBytes(const std::string& text, std::size_t& bytes) {
+        char* end = nullptr;
+        const double value = std::strtod(text.c_str(), &end);
+        if (end == text.c_str() || value < 0) {
+            return false;
+        }
+        const std::string suffix = end;
+        double scale = 1;
+        if (suffix == "K") {
+            scale = 1024.0;
+        } else if (suffix == "M") {
+            scale = 1024.0 * 1024;
+        } else if (suffix == "G") {
+            scale = 1024.0 * 1024 * 1024;
+        } else if (!suffix.empty()) {
+            return false;
+        }
+        bytes = static_cast<std::size_t>(value * scale);
+        return true;
+    }
+
+    Kind kind = Kind::Fixed;
+    std::size_t low = 4096;   // Fixed size, uniform minimum or lognormal median
+    std::size_t high = 4096;  // Largest size drawn
+    double sigma = 0;         // Lognormal shape
+};
+
+struct LoadOptions {
+    std::string service;
+    double rate = 100;
+    unsigned concurrency = 64;
+    double durationSeconds = 30;
+    double warmupSeconds = 0;
+    double readRatio = 0.5;
+    SizeDistribution sizes;
+    std::size_t keys = 1000;
+    bool poisson = false;
+    bool preload = true;
+    std::string bucketName;
+    std::string tableName;
+    double intervalSeconds = 1;
+    std::uint64_t seed = 1;
+};
+
+bool ParseOptions(int argc, char** argv, LoadOptions& options) {
+    if (argc < 2) {
+        return false;
+    }
+    options.service = argv[1];
+    if (options.service != "s3" && options.service != "dynamodb") {
+        return false;
+    }
+    for (int i = 2; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const std::size_t equals = argument.find('=');
+        const std::string name = argument.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        char* end = nullptr;
+        const double number = std::strtod(value.c_str(), &end);
+        const bool isNumber = !value.empty() && *end == '\0' && number >= 0;
+
+        if (name == "--no-preload" && value.empty()) {
+            options.preload = false;
+        } else if (name == "--size") {
+            if (!options.sizes.Parse(value)) {
+                return false;
+            }
+        } else if (name == "--arrivals" && (value == "uniform" || value == "poisson")) {
+            options.poisson = value == "poisson";
+        } else if (name == "--bucket" && !value.empty()) {
+            options.bucketName = value;
+        } else if (name == "--table" && !value.empty()) {
+            options.tableName = value;
+        } else if (!isNumber) {
+            return false;
+        } else if (name == "--rate") {
+            options.rate = number;
+        } else if (name == "--concurrency" && number >= 1) {
+            options.concurrency = static_cast<unsigned>(number);
+        } else if (name == "--duration" && number > 0) {
+            options.durationSeconds = number;
+        } else if (name == "--warmup") {
+            options.warmupSeconds = number;
+        } else if (name == "--read-ratio" && number <= 1) {
+            options.readRatio = number;
+        } else if (name == "--keys" && number >= 1) {
+            options.keys = static_cast<std::size_t>(number);
+        } else if (name == "--interval") {
+            options.intervalSeconds = number;
+        } else if (name == "--seed") {
+            options.seed = static_cast<std::uint64_t>(number);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string KeyName(std::size_t index) {
+    return "load/" + std::to_string(index);
+}
+
+// Seconds since the epoch, to name the bucket or table of a run
+std::string Timestamp() {
+    return std::to_string(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Service the load is sent to, through its manager
+ */
+class LoadTarget {
+public:
+    virtual ~LoadTarget() = default;
+    virtual bool Prepare() = 0;
+    virtual awsexamples::OperationResult Read(const std::string& key) = 0;
+    virtual awsexamples::OperationResult Write(const std::string& key, const char* data, std::size_t size) = 0;
+    virtual bool Remove(const std::string& key) = 0;
+    virtual void CleanUp() = 0;
+    virtual bool OwnsContainer() const = 0;
+};
+
+class S3Target : public LoadTarget {
+public:
+    S3Target(const Aws::Client::ClientConfiguration& config, bool pathStyle, const std::string& region,
+             const std::string& bucketName)
+        : manager(config, !pathStyle),
+          region(region),
+          bucketName(bucketName.empty() ? "awsexamples-load-" + Timestamp() : bucketName),
+          ownsBucket(bucketName.empty()) {}
+
+    bool Prepare() override {
+        std::cout << "Bucket: " << bucketName << (ownsBucket ? " (created for this run)" : "") << std::endl;
+        return !ownsBucket || manager.CreateBucket(bucketName, region);
+    }
+
+    awsexamples::OperationResult Read(const std::string& key) override {
+        // The body is read in full and discarded
+        return manager.DownloadFile(bucketName, key, "/dev/null");
+    }
+
+    awsexamples::OperationResult Write(const std::string& key, const char* data, std::size_t size) override {
+        auto body = Aws::MakeShared<awsexamples::MemoryViewStream>("LoadGenerator", data, size);
+        return manager.UploadStream(bucketName, key, body);
+    }
+
+    bool Remove(const std::string& key) override {
+        return static_cast<bool>(manager.DeleteObject(bucketName, key));
+    }
+
+    void CleanUp() override {
+        if (ownsBucket) {
+            manager.DeleteBucket(bucketName);
+        }
+    }
+
+    bool OwnsContainer() const override { return ownsBucket; }
+
+private:
+    awsexamples::S3Manager manager;
+    std::string region;
+    std::string bucketName;
+    bool ownsBucket;
+};
+
+class DynamoDBTarget : public LoadTarget {
+public:
+    DynamoDBTarget(const Aws::Client::ClientConfiguration& config, const std::string& tableName)
+        : manager(config),
+          tableName(tableName.empty() ? "LoadGenerator_" + Timestamp() : tableName),
+          ownsTable(tableName.empty()) {}
+
+    bool Prepare() override {
+        std::cout << "Table: " << tableName << (ownsTable ? " (created on demand for this run)" : "") << std::endl;
+        if (!ownsTable) {
+            return true;
+        }
+        // On-demand capacity, so throughput is limited by the service rather than a provisioned setting
+        awsexamples::TableSpec spec;
+        spec.name = tableName;
+        spec.billing = awsexamples::TableBilling::OnDemand;
+        return manager.CreateTable(spec) && manager.WaitForTableState(tableName, "ACTIVE", 120);
+    }
+
+    awsexamples::OperationResult Read(const std::string& key) override {
+        awsexamples::AttributeMap item;
+        return manager.GetItem(tableName, key, item);
+    }
+
+    awsexamples::OperationResult Write(const std::string& key, const char* data, std::size_t size) override {
+        awsexamples::AttributeMap item;
+        item["id"].SetS(key);
+        item["payload"].SetS(Aws::String(data, size));
+        return manager.PutItem(tableName, item);
+    }
+
+    bool Remove(const std::string& key) override {
+        return static_cast<bool>(manager.DeleteItem(tableName, key));
+    }
+
+    void CleanUp() override {
+        if (ownsTable) {
+            manager.DeleteTable(tableName);
+        }
+    }
+
+    bool OwnsContainer() const override { return ownsTable; }
+
+private:
+    awsexamples::DynamoDBManager manager;
+    std::string tableName;
+    bool ownsTable;
+};
+
+/**
+ * Intended start times of requests
+ *
+ * At a target rate, requests are due at fixed intervals or, with Poisson
+ * arrivals, at exponentially distributed ones, whether or not earlier requests
+ * have completed. Without a rate, each request is due as soon as a worker asks.
+ */
+class Schedule {
+public:
+    Schedule(double rate, bool poisson, std::uint64_t seed, Clock::time_point start, Clock::time_point end)
+        : rate(rate), poisson(poisson), random(seed), start(start), next(start), end(end) {}
+
+    // Take the next intended start; false once the schedule has ended
+    bool Next(Clock::time_point& intended) {
+        if (rate <= 0) {
+            intended = Clock::now();
+            return intended < end;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (next >= end) {
+            return false;
+        }
+        intended = next;
+        ++index;
+        if (poisson) {
+            next += Seconds(std::exponential_distribution<double>(rate)(random));
+        } else {
+            // Computed from the start rather than accumulated, so rounding does not drift
+            next = start + Seconds(static_cast<double>(index) / rate);
+        }
+        return true;
+    }
+
+private:
+    const double rate;
+    const bool poisson;
+    std::mutex mutex;
+    std::mt19937_64 random;
+    const Clock::time_point start;
+    Clock::time_point next;
+    const Clock::time_point end;
+    std::uint64_t index = 0;
+};
+
+enum RequestKind { kRead = 0, kWrite = 1, kRequestKinds = 2 };
+
+/**
+ * Results of one worker, merged after the run
+ */
+struct WorkerStats {
+    LatencyHistogram latency[kRequestKinds];      // From the intended start: corrected for coordinated omission
+    LatencyHistogram serviceTime[kRequestKinds];  // From the actual start
+    std::uint64_t failed[kRequestKinds] = {};
+    std::uint64_t bytes[kRequestKinds] = {};
+    std::map<std::string, std::uint64_t> errors;  // Failures by error type
+
+    void Merge(const WorkerStats& other) {
+        for (int kind = 0; kind < kRequestKinds; ++kind) {
+            latency[kind].Merge(other.latency[kind]);
+            serviceTime[kind].Merge(other.serviceTime[kind]);
+            failed[kind] += other.failed[kind];
+            bytes[kind] += other.bytes[kind];
+        }
+        for (const auto& error : other.errors) {
+            errors[error.first] += error.second;
+        }
+    }
+};
+
+/**
+ * Counters the progress reporter samples while the run is going
+ */
+struct Progress {
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::int64_t> maxStartDelayMicros{0};  // Largest lag behind the schedule since the last sample
+};
+
+// Call fn for the indexes 0 to count - 1 from several threads; returns the number of calls that failed
+std::size_t ForEachKey(std::size_t count, unsigned threads, const std::function<bool(std::size_t)>& fn) {
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> failed{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (std::size_t index; (index = next.fetch_add(1)) < count;) {
+                if (!fn(index)) {
+                    failed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return failed.load();
+}
+
+// Print a line of latency percentiles in milliseconds
+void PrintPercentiles(const char* label, const LatencyHistogram& histogram) {
+    if (histogram.GetCount() == 0) {
+        return;
+    }
+    auto Millis = [](std::uint64_t micros) { return static_cast<double>(micros) / 1000.0; };
+    std::printf("  %-6s %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", label,
+                Millis(histogram.GetSum() / histogram.GetCount()), Millis(histogram.ValueAtQuantile(0.5)),
+                Millis(histogram.ValueAtQuantile(0.9)), Millis(histogram.ValueAtQuantile(0.99)),
+                Millis(histogram.ValueAtQuantile(0.999)), Millis(histogram.ValueAtQuantile(0.9999)),
+                Millis(histogram.GetMax()));
+}
+
+void PrintLatencyTable(const char* title, const LatencyHistogram (&histograms)[kRequestKinds]) {
+    LatencyHistogram all;
+    all.Merge(histograms[kRead]);
+    all.Merge(histograms[kWrite]);
+    std::printf("\n%s (ms):\n  %-6s %10s %10s %10s %10s %10s %10s %10s\n", title, "", "mean", "p50", "p90", "p99",
+                "p99.9", "p99.99", "max");
+    PrintPercentiles("read", histograms[kRead]);
+    PrintPercentiles("write", histograms[kWrite]);
+    PrintPercentiles("all", all);
+}
+
+}  // namespace
+
+/**
+ * Drives configurable load against S3 objects or DynamoDB items through
+ * S3Manager or DynamoDBManager, for capacity planning against local stand-ins
+ * and staging environments.
+ *
+ * With --rate the load is open loop: requests are started on a schedule
+ * whether or not earlier ones have completed, up to --concurrency at a time.
+ * Each latency is measured from the request's intended start, so time spent
+ * waiting behind slow requests is counted instead of silently omitted
+ * (coordinated-omission correction); the time from the actual start is
+ * reported separately as service time. Without --rate the load is closed loop:
+ * --concurrency workers send requests back to back, and the two coincide.
+ *
+ * Set AWSEXAMPLES_S3_ENDPOINT (e.g. "http://localhost:9000" for MinIO) or
+ * AWSEXAMPLES_DYNAMODB_ENDPOINT (e.g. "http://localhost:8000" for DynamoDB
+ * Local) to send the load to a local stand-in instead of AWS.
+ */
+int main(int argc, char** argv) {
+    LoadOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << kUsage;
+        return 1;
+    }
+    if (options.service == "dynamodb" && options.sizes.Max() > kMaxItemSize) {
+        std::cerr << "DynamoDB item sizes must be at most " << kMaxItemSize << " bytes" << std::endl;
+        return 1;
+    }
+
+    // Per-request success messages would flood the output, so log warnings and errors only by default
+    awsexamples::utils::ClientOptions clientOptions = awsexamples::utils::LoadClientOptions();
+    if (std::getenv("AWSEXAMPLES_LOG_LEVEL") == nullptr) {
+        clientOptions.logLevel = Aws::Utils::Logging::LogLevel::Warn;
+    }
+    clientOptions.maxConnections = std::max(clientOptions.maxConnections, options.concurrency);
+    const char* endpoint =
+        std::getenv(options.service == "s3" ? "AWSEXAMPLES_S3_ENDPOINT" : "AWSEXAMPLES_DYNAMODB_ENDPOINT");
+    if (endpoint != nullptr && *endpoint != '\0') {
+        clientOptions.endpointOverride = endpoint;
+    }
+
+    // Initialize AWS SDK
+    awsexamples::utils::AwsApiInitializer awsInitializer(
+        awsexamples::utils::CreateDefaultSDKOptions(clientOptions.logLevel));
+
+    const Aws::Client::ClientConfiguration config = awsexamples::utils::ConfigureClient(clientOptions);
+    std::unique_ptr<LoadTarget> target;
+    if (options.service == "s3") {
+        // Path-style addressing works with any host, including MinIO on localhost
+        target = std::make_unique<S3Target>(config, !clientOptions.endpointOverride.empty(), clientOptions.region,
+                                            options.bucketName);
+    } else {
+        target = std::make_unique<DynamoDBTarget>(config, options.tableName);
+    }
+
+    std::printf("Load generator: %s%s%s\n", options.service.c_str(),
+                clientOptions.endpointOverride.empty() ? "" : " at ", clientOptions.endpointOverride.c_str());
+    if (options.rate > 0) {
+        std::printf("  Open loop at %.1f req/s, %s arrivals, %u in flight at most\n", options.rate,
+                    options.poisson ? "poisson" : "uniform", options.concurrency);
+    } else {
+        std::printf("  Closed loop with %u workers\n", options.concurrency);
+    }
+    std::printf("  %.1f s measured after %.1f s warmup, %.0f%% reads, %zu keys, %s\n", options.durationSeconds,
+                options.warmupSeconds, options.readRatio * 100, options.keys, options.sizes.Describe().c_str());
+    std::fflush(stdout);
+
+    if (!target->Prepare()) {
+        std::cerr << "Could not prepare the " << options.service << " target" << std::endl;
+        return 1;
+    }
+
+    // Bodies are views of one buffer, so writing costs no copies on the generator side
+    std::string payload(options.sizes.Max(), '\0');
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<char>('a' + i % 26);
+    }
+    // Size last written to each key, to count the bytes a read returns
+    std::unique_ptr<std::atomic<std::uint64_t>[]> keySizes(new std::atomic<std::uint64_t>[options.keys]());
+
+    if (options.preload && options.readRatio > 0) {
+        std::cout << "\nPreloading " << options.keys << " keys..." << std::endl;
+        const std::size_t failures = ForEachKey(options.keys, options.concurrency, [&](std::size_t index) {
+            std::mt19937_64 random(options.seed + index);
+            const std::size_t size = options.sizes.Draw(random);
+            keySizes[index] = size;
+            return static_cast<bool>(target->Write(KeyName(index), payload.data(), size));
+        });
+        if (failures > 0) {
+            std::cerr << failures << " keys could not be preloaded" << std::endl;
+        }
+    }
+
+    const auto runStart = Clock::now() + std::chrono::milliseconds(100);
+    const auto measureStart = runStart + Seconds(options.warmupSeconds);
+    const auto measureEnd = measureStart + Seconds(options.durationSeconds);
+    Schedule schedule(options.rate, options.poisson, options.seed, runStart, measureEnd);
+    Progress progress;
+    std::vector<WorkerStats> stats(options.concurrency);
+
+    std::cout << "\nRunning..." << std::endl;
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < options.concurrency; ++w) {
+        workers.emplace_back([&, w]() {
+            WorkerStats& local = stats[w];
+            std::mt19937_64 random(options.seed * 7919 + w + 1);
+            std::uniform_int_distribution<std::size_t> keyDistribution(0, options.keys - 1);
+            std::bernoulli_distribution readDistribution(options.readRatio);
+            std::this_thread::sleep_until(runStart);
+
+            for (Clock::time_point intended; schedule.Next(intended);) {
+                std::this_thread::sleep_until(intended);
+                const auto started = Clock::now();
+                const std::size_t index = keyDistribution(random);
+                const RequestKind kind = readDistribution(random) ? kRead : kWrite;
+                std::uint64_t bytes = keySizes[index];
+                awsexamples::OperationResult result;
+                if (kind == kRead) {
+                    result = target->Read(KeyName(index));
+                } else {
+                    bytes = options.sizes.Draw(random);
+                    result = target->Write(KeyName(index), payload.data(), bytes);
+                    keySizes[index] = bytes;
+                }
+                const auto finished = Clock::now();
+
+                const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(started - intended).count();
+                for (auto seen = progress.maxStartDelayMicros.load();
+                     delay > seen && !progress.maxStartDelayMicros.compare_exchange_weak(seen, delay);) {
+                }
+                progress.completed.fetch_add(1, std::memory_order_relaxed);
+                if (!result) {
+                    progress.failed.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (intended < measureStart) {
+                    continue;
+                }
+                local.latency[kind].Record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(finished - intended).count()));
+                local.serviceTime[kind].Record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(finished - started).count()));
+                if (result) {
+                    local.bytes[kind] += bytes;
+                } else {
+                    ++local.failed[kind];
+                    ++local.errors[result.errorType.empty() ? "Unknown" : result.errorType];
+                }
+            }
+        });
+    }
+
+    // Print throughput, failures and the lag behind the schedule once per interval
+    std::mutex reporterMutex;
+    std::condition_variable reporterWake;
+    bool finished = false;
+    std::thread reporter([&]() {
+        if (options.intervalSeconds <= 0) {
+            return;
+        }
+        const auto interval = Seconds(options.intervalSeconds);
+        std::uint64_t lastCompleted = 0;
+        std::uint64_t lastFailed = 0;
+        std::unique_lock<std::mutex> lock(reporterMutex);
+        for (auto next = runStart + interval; !reporterWake.wait_until(lock, next, [&]() { return finished; });
+             next += interval) {
+            const std::uint64_t completed = progress.completed.load();
+            const std::uint64_t failed = progress.failed.load();
+            const double elapsed = std::chrono::duration<double>(next - runStart).count();
+            std::printf("  %7.1f s %s %10.1f req/s %8llu failed   max start delay %9.3f ms\n", elapsed,
+                        next <= measureStart ? "warmup  " : "measured",
+                        static_cast<double>(completed - lastCompleted) / options.intervalSeconds,
+                        static_cast<unsigned long long>(failed - lastFailed),
+                        static_cast<double>(progress.maxStartDelayMicros.exchange(0)) / 1000.0);
+            std::fflush(stdout);
+            lastCompleted = completed;
+            lastFailed = failed;
+        }
+    });
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    // Requests due before the end may complete after it; throughput counts the time they took
+    const double elapsed = std::chrono::duration<double>(std::max(Clock::now(), measureEnd) - measureStart).count();
+    {
+        std::lock_guard<std::mutex> lock(reporterMutex);
+        finished = true;
+    }
+    reporterWake.notify_one();
+    reporter.join();
+
+    WorkerStats total;
+    for (const auto& local : stats) {
+        total.Merge(local);
+    }
+    const std::uint64_t completed = total.latency[kRead].GetCount() + total.latency[kWrite].GetCount();
+    const std::uint64_t failed = total.failed[kRead] + total.failed[kWrite];
+
+    std::printf("\n=== Results ===\n");
+    std::printf("Requests:   %llu completed in %.1f s, %llu failed\n", static_cast<unsigned long long>(completed),
+                elapsed, static_cast<unsigned long long>(failed));
+    std::printf("Throughput: %.1f req/s (reads %.1f, writes %.1f)", static_cast<double>(completed) / elapsed,
+                static_cast<double>(total.latency[kRead].GetCount()) / elapsed,
+                static_cast<double>(total.latency[kWrite].GetCount()) / elapsed);
+    if (options.rate > 0) {
+        std::printf(", target %.1f req/s", options.rate);
+    }
+    std::printf("\nBandwidth:  %.2f MiB/s read, %.2f MiB/s written\n",
+                static_cast<double>(total.bytes[kRead]) / elapsed / (1024 * 1024),
+                static_cast<double>(total.bytes[kWrite]) / elapsed / (1024 * 1024));
+    for (const auto& error : total.errors) {
+        std::printf("Errors:     %s: %llu\n", error.first.c_str(), static_cast<unsigned long long>(error.second));
+    }
+
+    if (options.rate > 0) {
+        PrintLatencyTable("Latency from intended start, corrected for coordinated omission", total.latency);
+        PrintLatencyTable("Service time from actual start", total.serviceTime);
+        if (static_cast<double>(completed) < 0.95 * options.rate * options.durationSeconds) {
+            std::printf("\nThe target rate was not reached: raise --concurrency, or the service is saturated.\n");
+        }
+    } else {
+        PrintLatencyTable("Latency", total.serviceTime);
+        std::printf("\nClosed loop: requests are only sent once a worker is free, so time the service kept\n"
+                    "them waiting is not measured. Use --rate for latencies corrected for coordinated omission.\n");
+    }
+
+    if (target->OwnsContainer()) {
+        std::cout << "\nCleaning up..." << std::endl;
+        if (options.service == "s3") {
+            ForEachKey(options.keys, options.concurrency, [&](std::size_t index) {
+                return target->Remove(KeyName(index));
+            });
+        }
+        target->CleanUp();
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file AsyncSupport.h
+ * @brief Internal helper for turning callback-style asynchronous operations into futures
+ */
+
+#ifndef AWSEXAMPLES_ASYNCSUPPORT_H
+#define AWSEXAMPLES_ASYNCSUPPORT_H
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @brief Run a callback-style operation and return a future for its result
+ *
+ * @p start is invoked immediately with a completion callback; the returned future
+ * becomes ready when that callback is called. If the callback is destroyed without
+ * being called (e.g. the executor rejected the task) the future reports a broken promise.
+ *
+ * @param start Callable that starts the operation, given the completion callback
+ * @return std::future<T> Future receiving the value passed to the completion callback
+ */
+template <typename T, typename Start>
+std::future<T> ToFuture(Start&& start) {
+    auto promise = std::make_shared<std::promise<T>>();
+    std::future<T> future = promise->get_future();
+    start(std::function<void(const T&)>([promise](const T& value) { promise->set_value(value); }));
+    return future;
+}
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_ASYNCSUPPORT_H
@@ -4,40 +4,405 @@
  */
 
 #include "awsexamples/AwsUtils.h"
-#include <iostream>
+#include "awsexamples/Logger.h"
+#include "awsexamples/Waiter.h"
+#include "TraceMonitoring.h"
+#include <aws/core/client/AdaptiveRetryStrategy.h>
+#include <aws/core/client/DefaultRetryStrategy.h>
+#include <aws/core/utils/Array.h>
+#include <aws/core/utils/ratelimiter/DefaultRateLimiter.h>
+#include <aws/core/utils/threading/Executor.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <typeinfo>
 
 namespace awsexamples {
 namespace utils {
 
+namespace {
+
+constexpr const char* kEnvironmentPrefix = "AWSEXAMPLES_";
+
+std::string Trim(const std::string& text) {
+    auto begin = std::find_if_not(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c); });
+    auto end = std::find_if_not(text.rbegin(), text.rend(), [](unsigned char c) { return std::isspace(c); }).base();
+    return begin < end ? std::string(begin, end) : std::string();
+}
+
+std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+bool ParseBool(const std::string& text, bool& value) {
+    std::string lower = ToLower(text);
+    if (lower == "1" || lower == "true" || lower == "yes" || lower == "on") {
+        value = true;
+        return true;
+    }
+    if (lower == "0" || lower == "false" || lower == "no" || lower == "off") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool ParseNumber(const std::string& text, T& value) {
+    if (std::is_unsigned<T>::value && text.find('-') != std::string::npos) {
+        return false;
+    }
+    std::istringstream stream(text);
+    T parsed {};
+    if (!(stream >> parsed) || !(stream >> std::ws).eof() || parsed < 0) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+bool ParseLogLevel(const std::string& text, Aws::Utils::Logging::LogLevel& value) {
+    using Aws::Utils::Logging::LogLevel;
+    static const std::map<std::string, LogLevel> levels = {
+        {"off", LogLevel::Off},   {"fatal", LogLevel::Fatal}, {"error", LogLevel::Error},
+        {"warn", LogLevel::Warn}, {"info", LogLevel::Info},   {"debug", LogLevel::Debug},
+        {"trace", LogLevel::Trace}};
+    auto level = levels.find(ToLower(text));
+    if (level == levels.end()) {
+        return false;
+    }
+    value = level->second;
+    return true;
+}
+
+using OptionSetter = std::function<bool(ClientOptions&, const std::string&)>;
+
+// Every option that can be set from a file or the environment, by name
+const std::map<std::string, OptionSetter>& OptionSetters() {
+    static const std::map<std::string, OptionSetter> setters = {
+        {"region", [](ClientOptions& o, const std::string& v) { o.region = v; return !v.empty(); }},
+        {"log_level", [](ClientOptions& o, const std::string& v) { return ParseLogLevel(v, o.logLevel); }},
+        {"connect_timeout_ms", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.connectTimeoutMs); }},
+        {"request_timeout_ms", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.requestTimeoutMs); }},
+        {"max_connections", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.maxConnections); }},
+        {"executor_threads", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.executorThreads); }},
+        {"tcp_keep_alive", [](ClientOptions& o, const std::string& v) { return ParseBool(v, o.tcpKeepAlive); }},
+        {"tcp_keep_alive_interval_ms",
+         [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.tcpKeepAliveIntervalMs); }},
+        {"low_speed_limit", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.lowSpeedLimit); }},
+        {"read_rate_limit", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.readRateLimit); }},
+        {"write_rate_limit", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.writeRateLimit); }},
+        {"retry_mode",
+         [](ClientOptions& o, const std::string& v) {
+             std::string mode = ToLower(v);
+             if (mode != "legacy" && mode != "standard" && mode != "adaptive" && mode != "none") {
+                 return false;
+             }
+             o.retryMode = mode;
+             return true;
+         }},
+        {"max_attempts", [](ClientOptions& o, const std::string& v) { return ParseNumber(v, o.maxAttempts); }},
+        {"verify_ssl", [](ClientOptions& o, const std::string& v) { return ParseBool(v, o.verifySSL); }},
+        {"endpoint_override", [](ClientOptions& o, const std::string& v) { o.endpointOverride = v; return true; }},
+        {"http2", [](ClientOptions& o, const std::string& v) { return ParseBool(v, o.http2); }},
+    };
+    return setters;
+}
+
+std::shared_ptr<Aws::Client::RetryStrategy> MakeRetryStrategy(const std::string& mode, long maxAttempts) {
+    long attempts = std::max(maxAttempts, 1L);
+    if (mode == "legacy") {
+        return Aws::MakeShared<Aws::Client::DefaultRetryStrategy>("AwsUtils", attempts - 1);
+    }
+    if (mode == "standard") {
+        return Aws::MakeShared<Aws::Client::StandardRetryStrategy>("AwsUtils", attempts);
+    }
+    if (mode == "adaptive") {
+        return Aws::MakeShared<Aws::Client::AdaptiveRetryStrategy>("AwsUtils", attempts);
+    }
+    if (mode == "none") {
+        return Aws::MakeShared<Aws::Client::DefaultRetryStrategy>("AwsUtils", 0);
+    }
+    return nullptr;
+}
+
+// Runs a client's asynchronous calls on a thread pool started by the first call, so
+// configurations that are discarded, or answered by a cached client, start no threads
+class ClientExecutor : public Aws::Utils::Threading::Executor {
+public:
+    explicit ClientExecutor(std::size_t threads) : threads(threads) {}
+
+    std::size_t Threads() const { return threads; }
+
+protected:
+    bool SubmitToThread(std::function<void()>&& task) override {
+        std::call_once(started, [this]() {
+            pool = Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>("AwsUtils", threads);
+        });
+        return pool->Submit(std::move(task));
+    }
+
+private:
+    std::size_t threads;
+    std::once_flag started;
+    std::shared_ptr<Aws::Utils::Threading::PooledThreadExecutor> pool;
+};
+
+// Bandwidth limiter that keeps the rate it was created with, for the registry key
+class BandwidthLimiter : public Aws::Utils::RateLimits::DefaultRateLimiter<> {
+public:
+    explicit BandwidthLimiter(std::int64_t rate) : Aws::Utils::RateLimits::DefaultRateLimiter<>(rate), rate(rate) {}
+
+    std::int64_t Rate() const { return rate; }
+
+private:
+    std::int64_t rate;
+};
+
+// Key part for a member that is only interchangeable with itself
+std::string Identity(const void* member) {
+    std::ostringstream key;
+    key << '@' << member;
+    return key.str();
+}
+
+// The pointer members of a configuration are keyed by their settings when
+// ConfigureClient or the SDK's defaults made them, and by identity otherwise
+
+std::string DescribeExecutor(const std::shared_ptr<Aws::Utils::Threading::Executor>& executor) {
+    if (!executor) {
+        return "none";
+    }
+    if (const auto* pool = dynamic_cast<const ClientExecutor*>(executor.get())) {
+        return "pool" + std::to_string(pool->Threads());
+    }
+    if (dynamic_cast<const Aws::Utils::Threading::DefaultExecutor*>(executor.get()) != nullptr) {
+        return "default";
+    }
+    return Identity(executor.get());
+}
+
+std::string DescribeRateLimiter(const std::shared_ptr<Aws::Utils::RateLimits::RateLimiterInterface>& limiter) {
+    if (!limiter) {
+        return "0";
+    }
+    if (const auto* bandwidth = dynamic_cast<const BandwidthLimiter*>(limiter.get())) {
+        return std::to_string(bandwidth->Rate());
+    }
+    return Identity(limiter.get());
+}
+
+std::string DescribeRetryStrategy(const std::shared_ptr<Aws::Client::RetryStrategy>& strategy) {
+    if (!strategy) {
+        return "none";
+    }
+    const std::type_info& type = typeid(*strategy);
+    if (type == typeid(Aws::Client::DefaultRetryStrategy) || type == typeid(Aws::Client::StandardRetryStrategy) ||
+        type == typeid(Aws::Client::AdaptiveRetryStrategy)) {
+        return std::string(type.name()) + ":" + std::to_string(strategy->GetMaxAttempts());
+    }
+    return Identity(strategy.get());
+}
+
+// Length-prefix a free-form setting, so that a '|' inside it cannot make two keys equal
+std::string DescribeText(const Aws::String& text) {
+    return std::to_string(text.size()) + ":" + std::string(text.c_str(), text.size());
+}
+
+std::string DescribeHosts(const Aws::Utils::Array<Aws::String>& hosts) {
+    std::string description = std::to_string(hosts.GetLength());
+    for (std::size_t i = 0; i < hosts.GetLength(); ++i) {
+        description += "," + DescribeText(hosts[i]);
+    }
+    return description;
+}
+
+}  // namespace
+
 Aws::Client::ClientConfiguration ConfigureClient(
     const std::string& region,
-    Aws::Utils::Logging::LogLevel logLevel,
     long timeoutMs,
     unsigned maxConnections) {
     
+    ClientOptions options;
+    options.region = region;
+    options.connectTimeoutMs = timeoutMs;
+    options.requestTimeoutMs = timeoutMs;
+    options.maxConnections = maxConnections;
+    return ConfigureClient(options);
+}
+
+Aws::Client::ClientConfiguration ConfigureClient(
+    const std::string& region,
+    Aws::Utils::Logging::LogLevel,
+    long timeoutMs,
+    unsigned maxConnections) {
+    
+    return ConfigureClient(region, timeoutMs, maxConnections);
+}
+
+Aws::Client::ClientConfiguration ConfigureClient(const ClientOptions& options) {
     Aws::Client::ClientConfiguration config;
-    config.region = region;
-    config.connectTimeoutMs = timeoutMs;
-    config.requestTimeoutMs = timeoutMs;
-    config.maxConnections = maxConnections;
+    config.region = options.region;
+    config.connectTimeoutMs = options.connectTimeoutMs;
+    config.requestTimeoutMs = options.requestTimeoutMs;
+    config.maxConnections = options.maxConnections;
+    config.enableTcpKeepAlive = options.tcpKeepAlive;
+    config.tcpKeepAliveIntervalMs = options.tcpKeepAliveIntervalMs;
+    config.lowSpeedLimit = options.lowSpeedLimit;
+    config.verifySSL = options.verifySSL;
+    config.version = options.http2 ? Aws::Http::Version::HTTP_VERSION_2TLS : Aws::Http::Version::HTTP_VERSION_1_1;
+    
+    if (!options.endpointOverride.empty()) {
+        config.endpointOverride = options.endpointOverride;
+        if (options.endpointOverride.rfind("http://", 0) == 0) {
+            config.scheme = Aws::Http::Scheme::HTTP;
+        }
+    }
+    
+    // The SDK's default executor starts a detached thread per asynchronous call; a pool
+    // runs the *Async operations on a fixed set of threads
+    unsigned executorThreads = options.executorThreads > 0 ? options.executorThreads : options.maxConnections;
+    config.executor = Aws::MakeShared<ClientExecutor>("AwsUtils", std::max(executorThreads, 1U));
+    
+    if (options.readRateLimit > 0) {
+        config.readRateLimiter = Aws::MakeShared<BandwidthLimiter>("AwsUtils", options.readRateLimit);
+    }
+    if (options.writeRateLimit > 0) {
+        config.writeRateLimiter = Aws::MakeShared<BandwidthLimiter>("AwsUtils", options.writeRateLimit);
+    }
+    if (auto retryStrategy = MakeRetryStrategy(options.retryMode, options.maxAttempts)) {
+        config.retryStrategy = retryStrategy;
+    }
     
     return config;
 }
 
+bool SetClientOption(ClientOptions& options, const std::string& name, const std::string& value) {
+    const auto& setters = OptionSetters();
+    auto setter = setters.find(ToLower(name));
+    return setter != setters.end() && setter->second(options, value);
+}
+
+bool ApplyClientOptionsFile(const std::string& path, ClientOptions& options) {
+    std::ifstream file(path);
+    if (!file) {
+        AWSEXAMPLES_LOG(Error, "Failed to open client configuration: " << path);
+        return false;
+    }
+    
+    bool valid = true;
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        auto separator = line.find('=');
+        if (separator == std::string::npos ||
+            !SetClientOption(options, Trim(line.substr(0, separator)), Trim(line.substr(separator + 1)))) {
+            AWSEXAMPLES_LOG(Error, path << ":" << lineNumber << ": invalid client option: " << line);
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool ApplyClientOptionsEnvironment(ClientOptions& options) {
+    bool valid = true;
+    for (const auto& setter : OptionSetters()) {
+        std::string variable = kEnvironmentPrefix + setter.first;
+        std::transform(variable.begin(), variable.end(), variable.begin(),
+                       [](unsigned char c) { return std::toupper(c); });
+        
+        const char* value = std::getenv(variable.c_str());
+        if (value != nullptr && !setter.second(options, value)) {
+            AWSEXAMPLES_LOG(Error, "Invalid value for " << variable << ": " << value);
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+ClientOptions LoadClientOptions() {
+    ClientOptions options;
+    if (const char* path = std::getenv("AWSEXAMPLES_CONFIG_FILE")) {
+        ApplyClientOptionsFile(path, options);
+    }
+    ApplyClientOptionsEnvironment(options);
+    return options;
+}
+
 Aws::SDKOptions CreateDefaultSDKOptions(Aws::Utils::Logging::LogLevel logLevel) {
     Aws::SDKOptions options;
     options.loggingOptions.logLevel = logLevel;
     return options;
 }
 
+ClientRegistry& ClientRegistry::Instance() {
+    static ClientRegistry registry;
+    return registry;
+}
+
+void ClientRegistry::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    clients.clear();
+}
+
+std::size_t ClientRegistry::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return clients.size();
+}
+
+std::string ClientRegistry::ConfigurationKey(const Aws::Client::ClientConfiguration& config) {
+    // -1 while unset, so the SDK's per-service default stays distinct from an explicit choice
+    const int endpointDiscovery =
+        config.enableEndpointDiscovery.has_value() ? static_cast<int>(config.enableEndpointDiscovery.value()) : -1;
+    std::ostringstream key;
+    key << config.region << '|' << config.endpointOverride << '|' << static_cast<int>(config.scheme)
+        << '|' << config.connectTimeoutMs << '|' << config.requestTimeoutMs
+        << '|' << config.httpRequestTimeoutMs << '|' << config.maxConnections
+        << '|' << config.verifySSL << '|' << config.caFile << '|' << config.caPath
+        << '|' << config.proxyHost << ':' << config.proxyPort
+        << '|' << config.enableTcpKeepAlive << '|' << config.tcpKeepAliveIntervalMs
+        << '|' << config.lowSpeedLimit << '|' << static_cast<int>(config.version)
+        << '|' << config.useDualStack << '|' << config.useFIPS << '|' << DescribeText(config.userAgent)
+        << '|' << static_cast<int>(config.proxyScheme) << '|' << DescribeText(config.proxyUserName)
+        << '|' << DescribeText(config.proxyPassword) << '|' << DescribeHosts(config.nonProxyHosts)
+        << '|' << DescribeText(config.proxySSLCertPath) << '|' << DescribeText(config.proxySSLCertType)
+        << '|' << DescribeText(config.proxySSLKeyPath) << '|' << DescribeText(config.proxySSLKeyType)
+        << '|' << DescribeText(config.proxySSLKeyPassword)
+        << '|' << DescribeText(config.proxyCaFile) << '|' << DescribeText(config.proxyCaPath)
+        << '|' << static_cast<int>(config.followRedirects) << '|' << config.disableExpectHeader
+        << '|' << config.enableClockSkewAdjustment << '|' << config.enableHostPrefixInjection
+        << '|' << endpointDiscovery
+        << '|' << config.enableHttpClientTrace << '|' << static_cast<int>(config.httpLibOverride)
+        << '|' << DescribeText(config.profileName) << '|' << config.disableIMDS
+        << '|' << DescribeRetryStrategy(config.retryStrategy) << '|' << DescribeExecutor(config.executor)
+        << '|' << DescribeRateLimiter(config.readRateLimiter) << '|' << DescribeRateLimiter(config.writeRateLimiter);
+    return key.str();
+}
+
 AwsApiInitializer::AwsApiInitializer(const Aws::SDKOptions& options) : options(options) {
+    Logger::Instance().SetLevel(this->options.loggingOptions.logLevel);
+    detail::InstallTraceMonitoring(this->options);
     Aws::InitAPI(this->options);
-    std::cout << "AWS SDK initialized" << std::endl;
+    AWSEXAMPLES_LOG(Info, "AWS SDK initialized");
 }
 
 AwsApiInitializer::~AwsApiInitializer() {
+    // Pending waits and shared clients must not outlive the SDK
+    Waiter::Instance().Shutdown();
+    ClientRegistry::Instance().Clear();
     Aws::ShutdownAPI(options);
-    std::cout << "AWS SDK shutdown complete" << std::endl;
+    AWSEXAMPLES_LOG(Info, "AWS SDK shutdown complete");
+    Logger::Instance().Flush();
 }
 
 } // namespace utils
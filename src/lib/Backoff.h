@@ -0,0 +1,56 @@
+/**
+ * @file Backoff.h
+ * @brief Internal helper computing jittered exponential backoff delays
+ */
+
+#ifndef AWSEXAMPLES_BACKOFF_H
+#define AWSEXAMPLES_BACKOFF_H
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @brief Compute a "full jitter" backoff delay for a retry attempt
+ *
+ * The delay is drawn uniformly from [0, min(maxDelay, baseDelay * 2^(attempt - 1))],
+ * which spreads retries from many clients over time instead of synchronising them.
+ *
+ * @param attempt The retry number, starting at 1
+ * @param baseDelay Upper bound of the delay for the first retry
+ * @param maxDelay Upper bound of the delay for any retry
+ * @return std::chrono::milliseconds The delay to wait before retrying
+ */
+inline std::chrono::milliseconds JitteredBackoff(int attempt,
+                                                 std::chrono::milliseconds baseDelay,
+                                                 std::chrono::milliseconds maxDelay) {
+    thread_local std::mt19937 generator{std::random_device{}()};
+
+    const int exponent = std::min(std::max(attempt - 1, 0), 20);
+    const auto cap = std::min<long long>(maxDelay.count(), baseDelay.count() << exponent);
+    std::uniform_int_distribution<long long> distribution(0, std::max<long long>(cap, 0));
+    return std::chrono::milliseconds(distribution(generator));
+}
+
+/**
+ * @brief Compute an exponential delay without jitter
+ *
+ * @param attempt The attempt number, starting at 1
+ * @param baseDelay Delay for the first attempt
+ * @param maxDelay Upper bound of the delay for any attempt
+ * @return std::chrono::milliseconds min(maxDelay, baseDelay * 2^(attempt - 1))
+ */
+inline std::chrono::milliseconds ExponentialDelay(int attempt,
+                                                  std::chrono::milliseconds baseDelay,
+                                                  std::chrono::milliseconds maxDelay) {
+    const int exponent = std::min(std::max(attempt - 1, 0), 20);
+    return std::chrono::milliseconds(std::min<long long>(maxDelay.count(), baseDelay.count() << exponent));
+}
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_BACKOFF_H
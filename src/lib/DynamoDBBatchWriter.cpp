@@ -0,0 +1,199 @@
+/**
+ * @file DynamoDBBatchWriter.cpp
+ * @brief Implementation of the DynamoDBBatchWriter class
+ */
+
+#include "awsexamples/DynamoDBBatchWriter.h"
+#include "awsexamples/ItemCache.h"
+#include "awsexamples/Logger.h"
+#include "Backoff.h"
+#include "RetrySupport.h"
+#include <aws/dynamodb/model/BatchWriteItemRequest.h>
+#include <aws/dynamodb/model/DeleteRequest.h>
+#include <aws/dynamodb/model/PutRequest.h>
+#include <algorithm>
+
+namespace awsexamples {
+
+namespace {
+
+constexpr std::size_t kMaxBatchSize = 25;  // BatchWriteItem limit per request
+
+// Get the "id" hash key of a put or delete, or "" if it has none
+std::string WrittenId(const Aws::DynamoDB::Model::WriteRequest& request) {
+    const AttributeMap& key = request.PutRequestHasBeenSet() ? request.GetPutRequest().GetItem()
+                                                             : request.GetDeleteRequest().GetKey();
+    return ItemCache::ItemId(key);
+}
+
+}  // namespace
+
+DynamoDBBatchWriter::DynamoDBBatchWriter(DynamoDBManager& manager,
+                                         const std::string& tableName,
+                                         const BatchWriterOptions& options)
+    : manager(manager), tableName(tableName), options(options) {
+    pending.reserve(kMaxBatchSize);
+    unsigned workerCount = std::max(options.maxInFlight, 1U);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&DynamoDBBatchWriter::WorkerLoop, this);
+    }
+}
+
+DynamoDBBatchWriter::~DynamoDBBatchWriter() {
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void DynamoDBBatchWriter::Put(const AttributeMap& item) {
+    Aws::DynamoDB::Model::PutRequest putRequest;
+    putRequest.SetItem(item);
+
+    Aws::DynamoDB::Model::WriteRequest request;
+    request.SetPutRequest(putRequest);
+    Enqueue(std::move(request));
+}
+
+void DynamoDBBatchWriter::Delete(const AttributeMap& key) {
+    Aws::DynamoDB::Model::DeleteRequest deleteRequest;
+    deleteRequest.SetKey(key);
+
+    Aws::DynamoDB::Model::WriteRequest request;
+    request.SetDeleteRequest(deleteRequest);
+    Enqueue(std::move(request));
+}
+
+bool DynamoDBBatchWriter::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!pending.empty()) {
+        QueuePending(lock);
+    }
+    queueChanged.wait(lock, [this]() { return queue.empty() && activeBatches == 0; });
+    return stats.itemsFailed == 0;
+}
+
+BatchWriterStats DynamoDBBatchWriter::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    BatchWriterStats snapshot = stats;
+    if (lastCompletion > firstWrite) {
+        std::chrono::duration<double> elapsed = lastCompletion - firstWrite;
+        snapshot.elapsedSeconds = elapsed.count();
+        snapshot.itemsPerSecond = snapshot.itemsWritten / snapshot.elapsedSeconds;
+    }
+    return snapshot;
+}
+
+void DynamoDBBatchWriter::Enqueue(Aws::DynamoDB::Model::WriteRequest request) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stats.requests == 0 && pending.empty() && queue.empty() && activeBatches == 0) {
+        firstWrite = std::chrono::steady_clock::now();
+    }
+    pending.push_back(std::move(request));
+    if (pending.size() >= kMaxBatchSize) {
+        QueuePending(lock);
+    }
+}
+
+void DynamoDBBatchWriter::QueuePending(std::unique_lock<std::mutex>& lock) {
+    // Back-pressure: hold the caller until a worker frees a queue slot
+    queueChanged.wait(lock, [this]() { return queue.size() < std::max(options.maxInFlight, 1U); });
+    queue.push_back(std::move(pending));
+    pending.clear();
+    pending.reserve(kMaxBatchSize);
+    queueChanged.notify_all();
+}
+
+void DynamoDBBatchWriter::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+
+        WriteBatch batch = std::move(queue.front());
+        queue.pop_front();
+        ++activeBatches;
+        queueChanged.notify_all();
+
+        lock.unlock();
+        std::vector<std::string> ids;
+        auto cache = manager.itemCache;
+        if (cache) {
+            ids.reserve(batch.size());
+            for (const auto& request : batch) {
+                ids.push_back(WrittenId(request));
+            }
+        }
+        std::uint64_t failed = SendBatch(std::move(batch));
+
+        // Invalidate once the writes have landed, so no read in between can re-cache old items
+        for (const auto& id : ids) {
+            cache->Invalidate(tableName, id);
+        }
+        lock.lock();
+
+        --activeBatches;
+        stats.itemsFailed += failed;
+        lastCompletion = std::chrono::steady_clock::now();
+        queueChanged.notify_all();
+    }
+}
+
+std::uint64_t DynamoDBBatchWriter::SendBatch(WriteBatch batch) {
+    bool resent = false;
+    for (int attempt = 0; attempt < options.maxAttempts && !batch.empty(); ++attempt) {
+        if (attempt > 0) {
+            std::this_thread::sleep_for(
+                detail::JitteredBackoff(attempt, options.baseBackoff, options.maxBackoff));
+        }
+
+        Aws::DynamoDB::Model::BatchWriteItemRequest request;
+        request.AddRequestItems(tableName, batch);
+
+        // Batches share the manager's controller, which admits, retries and paces them with other writers
+        auto outcome = detail::Execute(*manager.retryController, "BatchWriteItem", [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.requests;
+            if (resent) {
+                ++stats.retries;
+            }
+            resent = true;
+            return manager.client->BatchWriteItem(request);
+        });
+
+        if (!outcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "BatchWriteItem error: " << outcome.GetError().GetMessage());
+            return batch.size();
+        }
+
+        const auto& unprocessedItems = outcome.GetResult().GetUnprocessedItems();
+        auto unprocessed = unprocessedItems.find(tableName);
+        std::size_t remaining = unprocessed == unprocessedItems.end() ? 0 : unprocessed->second.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.itemsWritten += batch.size() - remaining;
+        }
+        if (remaining == 0) {
+            return 0;
+        }
+
+        // Unprocessed items mean the table is throttling writes
+        manager.retryController->OnThrottled("BatchWriteItem");
+        batch = unprocessed->second;
+    }
+
+    if (!batch.empty()) {
+        AWSEXAMPLES_LOG(Warn, "BatchWriteItem gave up on " << batch.size() << " items in " << tableName
+                              << " after " << options.maxAttempts << " attempts");
+    }
+    return batch.size();
+}
+
+}  // namespace awsexamples
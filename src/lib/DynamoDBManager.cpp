@@ -4,66 +4,199 @@
  */
 
 #include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/ItemCache.h"
+#include "awsexamples/Logger.h"
+#include "awsexamples/Tracing.h"
+#include "AsyncSupport.h"
+#include "Backoff.h"
+#include "ParallelFor.h"
+#include "PollSchedule.h"
+#include "ResultSupport.h"
+#include "RetrySupport.h"
 #include <aws/dynamodb/model/CreateTableRequest.h>
 #include <aws/dynamodb/model/DeleteTableRequest.h>
 #include <aws/dynamodb/model/AttributeDefinition.h>
 #include <aws/dynamodb/model/KeySchemaElement.h>
 #include <aws/dynamodb/model/ProvisionedThroughput.h>
+#include <aws/dynamodb/model/GlobalSecondaryIndex.h>
+#include <aws/dynamodb/model/LocalSecondaryIndex.h>
+#include <aws/dynamodb/model/Projection.h>
 #include <aws/dynamodb/model/PutItemRequest.h>
 #include <aws/dynamodb/model/GetItemRequest.h>
 #include <aws/dynamodb/model/DeleteItemRequest.h>
 #include <aws/dynamodb/model/ScanRequest.h>
+#include <aws/dynamodb/model/QueryRequest.h>
+#include <aws/dynamodb/model/BatchGetItemRequest.h>
+#include <aws/dynamodb/model/KeysAndAttributes.h>
 #include <aws/dynamodb/model/DescribeTableRequest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
-#include <chrono>
 
 namespace awsexamples {
 
-DynamoDBManager::DynamoDBManager() : client() {}
+namespace {
+
+Aws::DynamoDB::Model::ScalarAttributeType ToScalarAttributeType(KeyAttributeType type) {
+    switch (type) {
+    case KeyAttributeType::Number:
+        return Aws::DynamoDB::Model::ScalarAttributeType::N;
+    case KeyAttributeType::Binary:
+        return Aws::DynamoDB::Model::ScalarAttributeType::B;
+    default:
+        return Aws::DynamoDB::Model::ScalarAttributeType::S;
+    }
+}
 
-DynamoDBManager::DynamoDBManager(const Aws::Client::ClientConfiguration& config) : client(config) {}
+Aws::DynamoDB::Model::KeySchemaElement MakeKeySchemaElement(const KeyAttribute& key,
+                                                            Aws::DynamoDB::Model::KeyType keyType) {
+    Aws::DynamoDB::Model::KeySchemaElement element;
+    element.SetAttributeName(key.name);
+    element.SetKeyType(keyType);
+    return element;
+}
 
-bool DynamoDBManager::CreateTable(const std::string& tableName) {
-    Aws::DynamoDB::Model::CreateTableRequest request;
+Aws::DynamoDB::Model::ProvisionedThroughput MakeThroughput(const ProvisionedCapacity& capacity) {
+    Aws::DynamoDB::Model::ProvisionedThroughput throughput;
+    throughput.SetReadCapacityUnits(capacity.readUnits);
+    throughput.SetWriteCapacityUnits(capacity.writeUnits);
+    return throughput;
+}
+
+Aws::DynamoDB::Model::Projection MakeProjection(const SecondaryIndexSpec& index) {
+    Aws::DynamoDB::Model::Projection projection;
+    switch (index.projection) {
+    case IndexProjection::KeysOnly:
+        projection.SetProjectionType(Aws::DynamoDB::Model::ProjectionType::KEYS_ONLY);
+        break;
+    case IndexProjection::Include:
+        projection.SetProjectionType(Aws::DynamoDB::Model::ProjectionType::INCLUDE);
+        for (const auto& attribute : index.nonKeyAttributes) {
+            projection.AddNonKeyAttributes(attribute);
+        }
+        break;
+    default:
+        projection.SetProjectionType(Aws::DynamoDB::Model::ProjectionType::ALL);
+        break;
+    }
+    return projection;
+}
+
+// Describe why DynamoDB would reject a spec, or return "" if it is valid
+std::string ValidateTableSpec(const TableSpec& spec) {
+    if (spec.hashKey.name.empty()) {
+        return spec.name + " has no hash key";
+    }
     
-    // Set table name
-    request.SetTableName(tableName);
+    std::map<std::string, KeyAttributeType> attributeTypes;
+    std::string problem;
+    auto addKey = [&](const KeyAttribute& key, const std::string& owner) {
+        if (key.name.empty() || !problem.empty()) {
+            return;
+        }
+        auto defined = attributeTypes.emplace(key.name, key.type);
+        if (!defined.second && defined.first->second != key.type) {
+            problem = "key attribute " + key.name + " of " + owner + " has a different type elsewhere in " + spec.name;
+        }
+    };
+    addKey(spec.hashKey, "the table");
+    addKey(spec.rangeKey, "the table");
     
-    // Define attributes
-    Aws::DynamoDB::Model::AttributeDefinition hashKey;
-    hashKey.SetAttributeName("id");
-    hashKey.SetAttributeType(Aws::DynamoDB::Model::ScalarAttributeType::S);
-    request.AddAttributeDefinitions(hashKey);
+    for (const auto& index : spec.globalIndexes) {
+        if (index.hashKey.name.empty()) {
+            return "global index " + index.name + " has no hash key";
+        }
+        addKey(index.hashKey, index.name);
+        addKey(index.rangeKey, index.name);
+    }
+    for (const auto& index : spec.localIndexes) {
+        if (spec.rangeKey.name.empty() || index.rangeKey.name.empty() ||
+            (!index.hashKey.name.empty() && index.hashKey.name != spec.hashKey.name)) {
+            return "local index " + index.name +
+                   " needs a table with a range key, the table's hash key and its own range key";
+        }
+        addKey(index.rangeKey, index.name);
+    }
+    return problem;
+}
+
+Aws::DynamoDB::Model::CreateTableRequest MakeCreateTableRequest(const TableSpec& spec) {
+    using Aws::DynamoDB::Model::KeyType;
     
-    // Define key schema
-    Aws::DynamoDB::Model::KeySchemaElement keySchema;
-    keySchema.SetAttributeName("id");
-    keySchema.SetKeyType(Aws::DynamoDB::Model::KeyType::HASH);
-    request.AddKeySchema(keySchema);
+    Aws::DynamoDB::Model::CreateTableRequest request;
+    request.SetTableName(spec.name);
     
-    // Set provisioned throughput
-    Aws::DynamoDB::Model::ProvisionedThroughput throughput;
-    throughput.SetReadCapacityUnits(5);
-    throughput.SetWriteCapacityUnits(5);
-    request.SetProvisionedThroughput(throughput);
+    // Define every key attribute of the table and its indexes once
+    std::set<std::string> definedAttributes;
+    auto defineAttribute = [&](const KeyAttribute& key) {
+        if (key.name.empty() || !definedAttributes.insert(key.name).second) {
+            return;
+        }
+        Aws::DynamoDB::Model::AttributeDefinition definition;
+        definition.SetAttributeName(key.name);
+        definition.SetAttributeType(ToScalarAttributeType(key.type));
+        request.AddAttributeDefinitions(definition);
+    };
+    defineAttribute(spec.hashKey);
+    defineAttribute(spec.rangeKey);
     
-    auto outcome = client.CreateTable(request);
+    // Define key schema
+    request.AddKeySchema(MakeKeySchemaElement(spec.hashKey, KeyType::HASH));
+    if (!spec.rangeKey.name.empty()) {
+        request.AddKeySchema(MakeKeySchemaElement(spec.rangeKey, KeyType::RANGE));
+    }
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Table " << tableName << " created successfully!" << std::endl;
-        return true;
+    const bool provisioned = spec.billing == TableBilling::Provisioned;
+    if (provisioned) {
+        request.SetBillingMode(Aws::DynamoDB::Model::BillingMode::PROVISIONED);
+        request.SetProvisionedThroughput(MakeThroughput(spec.capacity));
     } else {
-        std::cerr << "Error creating table: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+        request.SetBillingMode(Aws::DynamoDB::Model::BillingMode::PAY_PER_REQUEST);
+    }
+    
+    for (const auto& indexSpec : spec.globalIndexes) {
+        defineAttribute(indexSpec.hashKey);
+        defineAttribute(indexSpec.rangeKey);
+        
+        Aws::DynamoDB::Model::GlobalSecondaryIndex index;
+        index.SetIndexName(indexSpec.name);
+        index.AddKeySchema(MakeKeySchemaElement(indexSpec.hashKey, KeyType::HASH));
+        if (!indexSpec.rangeKey.name.empty()) {
+            index.AddKeySchema(MakeKeySchemaElement(indexSpec.rangeKey, KeyType::RANGE));
+        }
+        index.SetProjection(MakeProjection(indexSpec));
+        // On-demand tables reject index throughput; their indexes scale with the table
+        if (provisioned) {
+            index.SetProvisionedThroughput(MakeThroughput(indexSpec.capacity));
+        }
+        request.AddGlobalSecondaryIndexes(index);
     }
+    
+    for (const auto& indexSpec : spec.localIndexes) {
+        defineAttribute(indexSpec.rangeKey);
+        
+        Aws::DynamoDB::Model::LocalSecondaryIndex index;
+        index.SetIndexName(indexSpec.name);
+        index.AddKeySchema(MakeKeySchemaElement(spec.hashKey, KeyType::HASH));
+        index.AddKeySchema(MakeKeySchemaElement(indexSpec.rangeKey, KeyType::RANGE));
+        index.SetProjection(MakeProjection(indexSpec));
+        request.AddLocalSecondaryIndexes(index);
+    }
+    return request;
 }
 
-bool DynamoDBManager::PutItem(const std::string& tableName, 
-                            const std::string& id, 
-                            const std::string& name, 
-                            int age) {
-    
+Aws::DynamoDB::Model::PutItemRequest MakePutItemRequest(const std::string& tableName,
+                                                        const std::string& id,
+                                                        const std::string& name,
+                                                        int age) {
     Aws::DynamoDB::Model::PutItemRequest request;
     
     request.SetTableName(tableName);
@@ -80,19 +213,10 @@ bool DynamoDBManager::PutItem(const std::string& tableName,
     Aws::DynamoDB::Model::AttributeValue ageAttr;
     ageAttr.SetN(std::to_string(age));
     request.AddItem("age", ageAttr);
-    
-    auto outcome = client.PutItem(request);
-    
-    if (outcome.IsSuccess()) {
-        std::cout << "Item added successfully!" << std::endl;
-        return true;
-    } else {
-        std::cerr << "Error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
-    }
+    return request;
 }
 
-void DynamoDBManager::GetItem(const std::string& tableName, const std::string& id) {
+Aws::DynamoDB::Model::GetItemRequest MakeGetItemRequest(const std::string& tableName, const std::string& id) {
     Aws::DynamoDB::Model::GetItemRequest request;
     
     request.SetTableName(tableName);
@@ -101,83 +225,690 @@ void DynamoDBManager::GetItem(const std::string& tableName, const std::string& i
     Aws::DynamoDB::Model::AttributeValue keyAttr;
     keyAttr.SetS(id);
     request.AddKey("id", keyAttr);
+    return request;
+}
+
+Aws::DynamoDB::Model::DeleteItemRequest MakeDeleteItemRequest(const std::string& tableName,
+                                                              const std::string& id) {
+    Aws::DynamoDB::Model::DeleteItemRequest request;
+    
+    request.SetTableName(tableName);
+    
+    // Set key to delete
+    Aws::DynamoDB::Model::AttributeValue keyAttr;
+    keyAttr.SetS(id);
+    request.AddKey("id", keyAttr);
+    return request;
+}
+
+Aws::DynamoDB::Model::QueryRequest MakeQueryRequest(const std::string& tableName, const QueryOptions& options) {
+    Aws::DynamoDB::Model::QueryRequest request;
     
-    auto outcome = client.GetItem(request);
+    request.SetTableName(tableName);
+    request.SetKeyConditionExpression(options.keyConditionExpression);
+    if (!options.indexName.empty()) {
+        request.SetIndexName(options.indexName);
+    }
+    if (options.pageSize > 0) {
+        request.SetLimit(options.pageSize);
+    }
+    if (options.consistentRead) {
+        request.SetConsistentRead(true);
+    }
+    if (!options.scanIndexForward) {
+        request.SetScanIndexForward(false);
+    }
+    
+    // Only the requested attributes leave the table
+    if (!options.projectionExpression.empty()) {
+        request.SetProjectionExpression(options.projectionExpression);
+    }
+    if (!options.filterExpression.empty()) {
+        request.SetFilterExpression(options.filterExpression);
+    }
+    if (!options.expressionAttributeNames.empty()) {
+        request.SetExpressionAttributeNames(options.expressionAttributeNames);
+    }
+    if (!options.expressionAttributeValues.empty()) {
+        request.SetExpressionAttributeValues(options.expressionAttributeValues);
+    }
+    if (!options.exclusiveStartKey.empty()) {
+        request.SetExclusiveStartKey(options.exclusiveStartKey);
+    }
+    return request;
+}
+
+// Keys per BatchGetItem request
+constexpr std::size_t kMaxBatchGetKeys = 100;
+
+// State of one WaitForTableStateAsync call, shared by its checks
+struct TableWait {
+    std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client;
+    Aws::DynamoDB::Model::DescribeTableRequest request;
+    std::string targetState;
+    detail::PollSchedule schedule;
+    CompletionCallback callback;
+};
+
+void CheckTableState(const std::shared_ptr<TableWait>& wait);
+
+// Schedule the next check of a table wait, or fail it if it timed out
+void ScheduleTableCheck(const std::shared_ptr<TableWait>& wait) {
+    std::chrono::milliseconds delay;
+    if (!wait->schedule.NextDelay(delay)) {
+        AWSEXAMPLES_LOG(Error, "Timed out waiting for table " << wait->request.GetTableName()
+                                   << " to reach state " << wait->targetState);
+        wait->callback(false);
+        return;
+    }
     
-    if (outcome.IsSuccess()) {
-        const auto& item = outcome.GetResult().GetItem();
-        if (!item.empty()) {
-            std::cout << "Item found:\n";
-            std::cout << "ID: " << item.at("id").GetS() << std::endl;
-            std::cout << "Name: " << item.at("name").GetS() << std::endl;
-            std::cout << "Age: " << item.at("age").GetN() << std::endl;
+    Waiter::Instance().Schedule(delay, [wait](bool run) {
+        if (run) {
+            CheckTableState(wait);
         } else {
-            std::cout << "Item not found" << std::endl;
+            wait->callback(false);
         }
-    } else {
-        std::cerr << "Error: " << outcome.GetError().GetMessage() << std::endl;
+    });
+}
+
+void CheckTableState(const std::shared_ptr<TableWait>& wait) {
+    wait->client->DescribeTableAsync(
+        wait->request,
+        [wait](const auto*, const auto&, const auto& outcome, const auto&) {
+            if (outcome.IsSuccess()) {
+                const auto& tableStatus = outcome.GetResult().GetTable().GetTableStatus();
+                const auto status = Aws::DynamoDB::Model::TableStatusMapper::GetNameForTableStatus(tableStatus);
+                
+                AWSEXAMPLES_LOG(Info, "Table status: " << status);
+                
+                if (status == wait->targetState) {
+                    wait->callback(true);
+                    return;
+                }
+            } else if (wait->targetState == "DELETED" &&
+                       outcome.GetError().GetErrorType() == Aws::DynamoDB::DynamoDBErrors::RESOURCE_NOT_FOUND) {
+                wait->callback(true);
+                return;
+            } else if (!outcome.GetError().ShouldRetry()) {
+                AWSEXAMPLES_LOG(Error, "Error checking table status: " << outcome.GetError().GetMessage());
+                wait->callback(false);
+                return;
+            }
+            ScheduleTableCheck(wait);
+        });
+}
+
+}  // namespace
+
+DynamoDBManager::DynamoDBManager() : DynamoDBManager(Aws::Client::ClientConfiguration()) {}
+
+DynamoDBManager::DynamoDBManager(const Aws::Client::ClientConfiguration& config)
+    : DynamoDBManager(
+          utils::ClientRegistry::Instance().Get<Aws::DynamoDB::DynamoDBClient>(detail::WithoutSdkRetries(config))) {}
+
+DynamoDBManager::DynamoDBManager(std::shared_ptr<Aws::DynamoDB::DynamoDBClient> client)
+    : client(std::move(client)), retryController(utils::RetryController::ForService("dynamodb")) {}
+
+OperationResult DynamoDBManager::CreateTable(const std::string& tableName) {
+    TableSpec spec;
+    spec.name = tableName;
+    return CreateTable(spec);
+}
+
+OperationResult DynamoDBManager::CreateTable(const TableSpec& spec) {
+    detail::ResultTimer timer;
+    std::string problem = ValidateTableSpec(spec);
+    if (!problem.empty()) {
+        AWSEXAMPLES_LOG(Error, "Error creating table: " << problem);
+        return timer.Failed(errors::kInvalidArgument, problem);
     }
+    
+    auto outcome = detail::Execute(*retryController, "CreateTable", [&]() {
+        return client->CreateTable(MakeCreateTableRequest(spec));
+    });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Table " + spec.name + " created successfully!",
+                                "Error creating table");
 }
 
-void DynamoDBManager::ScanTable(const std::string& tableName) {
-    Aws::DynamoDB::Model::ScanRequest request;
+OperationResult DynamoDBManager::PutItem(const std::string& tableName, 
+                                       const std::string& id, 
+                                       const std::string& name, 
+                                       int age) {
+    detail::ResultTimer timer;
+    auto outcome = detail::Execute(*retryController, "PutItem", [&]() {
+        return client->PutItem(MakePutItemRequest(tableName, id, name, age));
+    });
+    
+    // Even a failed write may have been applied
+    if (itemCache) {
+        itemCache->Invalidate(tableName, id);
+    }
+    return detail::ReportResult(timer, outcome, "Item added successfully!", "Error");
+}
+
+OperationResult DynamoDBManager::PutItem(const std::string& tableName, const AttributeMap& item) {
+    detail::ResultTimer timer;
+    Aws::DynamoDB::Model::PutItemRequest request;
     request.SetTableName(tableName);
+    request.SetItem(item);
+    
+    auto outcome = detail::Execute(*retryController, "PutItem", [&]() {
+        return client->PutItem(request);
+    });
+    
+    // Even a failed write may have been applied
+    std::string id = ItemCache::ItemId(item);
+    if (itemCache && !id.empty()) {
+        itemCache->Invalidate(tableName, id);
+    }
+    if (!outcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "Error: " << outcome.GetError().GetMessage());
+    }
+    return timer.From(outcome);
+}
+
+void DynamoDBManager::GetItem(const std::string& tableName, const std::string& id) {
+    AttributeMap item;
+    if (!GetItem(tableName, id, item)) {
+        return;
+    }
+    
+    if (!item.empty()) {
+        std::cout << "Item found:\n";
+        std::cout << "ID: " << item.at("id").GetS() << std::endl;
+        std::cout << "Name: " << item.at("name").GetS() << std::endl;
+        std::cout << "Age: " << item.at("age").GetN() << std::endl;
+    } else {
+        std::cout << "Item not found" << std::endl;
+    }
+}
+
+OperationResult DynamoDBManager::GetItem(const std::string& tableName, const std::string& id, AttributeMap& item) {
+    detail::ResultTimer timer;
+    if (itemCache && itemCache->Get(tableName, id, item)) {
+        return timer.Succeeded();
+    }
+    
+    // Taken before the read, so a write racing with it keeps the stale item out of the cache
+    std::uint64_t generation = itemCache ? itemCache->Generation(tableName, id) : 0;
+    auto outcome = detail::Execute(*retryController, "GetItem", [&]() {
+        return client->GetItem(MakeGetItemRequest(tableName, id));
+    });
+    
+    if (!outcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "Error: " << outcome.GetError().GetMessage());
+        item.clear();
+        return timer.From(outcome);
+    }
+    item = outcome.GetResult().GetItem();
+    if (itemCache) {
+        itemCache->Put(tableName, id, item, generation);
+    }
+    return timer.Succeeded();
+}
+
+OperationResult DynamoDBManager::GetItems(const std::string& tableName,
+                                          const std::vector<std::string>& ids,
+                                          ItemMap& items,
+                                          const BatchGetOptions& options) {
+    utils::TraceScope scope("GetItems");
+    detail::ResultTimer timer;
+    std::set<std::string> uniqueIds(ids.begin(), ids.end());
+    std::vector<std::string> uncached;
+    for (const auto& id : uniqueIds) {
+        AttributeMap item;
+        if (itemCache && itemCache->Get(tableName, id, item)) {
+            if (!item.empty()) {
+                items[id] = std::move(item);
+            }
+        } else {
+            uncached.push_back(id);
+        }
+    }
+    
+    // One lookup per 100 keys; its request shrinks to the unprocessed keys on resubmission
+    struct BatchLookup {
+        std::size_t begin;
+        std::size_t end;
+        Aws::DynamoDB::Model::BatchGetItemRequest request;
+        std::vector<std::uint64_t> generations;
+        ItemMap found;
+        int submissions = 0;
+    };
+    std::vector<BatchLookup> batches;
+    for (std::size_t begin = 0; begin < uncached.size(); begin += kMaxBatchGetKeys) {
+        BatchLookup batch;
+        batch.begin = begin;
+        batch.end = std::min(begin + kMaxBatchGetKeys, uncached.size());
+        Aws::DynamoDB::Model::KeysAndAttributes keys;
+        batch.generations.reserve(batch.end - begin);
+        for (std::size_t i = begin; i < batch.end; ++i) {
+            AttributeMap key;
+            key["id"].SetS(uncached[i]);
+            keys.AddKeys(key);
+            batch.generations.push_back(itemCache ? itemCache->Generation(tableName, uncached[i]) : 0);
+        }
+        if (options.consistentRead) {
+            keys.SetConsistentRead(true);
+        }
+        batch.request.AddRequestItems(tableName, keys);
+        batches.push_back(std::move(batch));
+    }
     
-    auto outcome = client.Scan(request);
+    // Requests run on the client's executor; this thread only keeps up to
+    // options.concurrency of them in flight and resubmits unprocessed keys
+    using Clock = std::chrono::steady_clock;
+    std::multimap<Clock::time_point, std::size_t> due;
+    for (std::size_t batch = 0; batch < batches.size(); ++batch) {
+        due.emplace(Clock::time_point(), batch);
+    }
+    std::deque<std::pair<std::size_t, std::future<Aws::DynamoDB::Model::BatchGetItemOutcome>>> inFlight;
+    const std::size_t window = std::max(options.concurrency, 1U);
+    detail::FirstFailure failure;
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Items in " << tableName << ":" << std::endl;
-        const auto& items = outcome.GetResult().GetItems();
+    while (!due.empty() || !inFlight.empty()) {
+        while (inFlight.size() < window && !due.empty() && due.begin()->first <= Clock::now()) {
+            const std::size_t index = due.begin()->second;
+            due.erase(due.begin());
+            ++batches[index].submissions;
+            auto outcome = detail::ExecuteCallable<Aws::DynamoDB::Model::BatchGetItemOutcome>(
+                retryController, "BatchGetItem", [client = client, request = batches[index].request](auto onOutcome) {
+                    client->BatchGetItemAsync(request, [onOutcome](const auto*, const auto&, const auto& result,
+                                                                   const auto&) {
+                        onOutcome(result);
+                    });
+                });
+            inFlight.emplace_back(index, std::move(outcome));
+        }
+        if (inFlight.empty()) {
+            std::this_thread::sleep_until(due.begin()->first);
+            continue;
+        }
         
-        if (items.empty()) {
-            std::cout << "No items found in the table" << std::endl;
-            return;
+        const std::size_t index = inFlight.front().first;
+        auto outcome = inFlight.front().second.get();
+        inFlight.pop_front();
+        BatchLookup& batch = batches[index];
+        
+        // The controller has already retried failed requests
+        if (!outcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "BatchGetItem error: " << outcome.GetError().GetMessage());
+            failure.Record(outcome);
+            continue;
+        }
+        
+        const auto& result = outcome.GetResult();
+        auto responses = result.GetResponses().find(tableName);
+        if (responses != result.GetResponses().end()) {
+            for (const auto& item : responses->second) {
+                std::string id = ItemCache::ItemId(item);
+                if (!id.empty()) {
+                    batch.found[id] = item;
+                }
+            }
+        }
+        
+        auto unprocessed = result.GetUnprocessedKeys().find(tableName);
+        if (unprocessed != result.GetUnprocessedKeys().end() && !unprocessed->second.GetKeys().empty()) {
+            // Unprocessed keys mean the table is throttling reads
+            retryController->OnThrottled("BatchGetItem");
+            if (batch.submissions < options.maxAttempts) {
+                batch.request.SetRequestItems(result.GetUnprocessedKeys());
+                due.emplace(Clock::now() + detail::JitteredBackoff(batch.submissions, options.baseBackoff,
+                                                                   options.maxBackoff),
+                            index);
+            } else {
+                AWSEXAMPLES_LOG(Warn, "BatchGetItem gave up on keys in " << tableName << " after "
+                                      << options.maxAttempts << " attempts");
+                failure.Record(errors::kIncomplete, "Unprocessed keys remained in " + tableName, true);
+            }
+            continue;
         }
         
-        for (const auto& item : items) {
-            std::cout << "ID: " << item.at("id").GetS() 
-                      << ", Name: " << item.at("name").GetS()
-                      << ", Age: " << item.at("age").GetN() << std::endl;
+        // Only a finished batch knows which of its keys have no item
+        if (itemCache) {
+            for (std::size_t i = batch.begin; i < batch.end; ++i) {
+                auto item = batch.found.find(uncached[i]);
+                itemCache->Put(tableName, uncached[i], item == batch.found.end() ? AttributeMap() : item->second,
+                               batch.generations[i - batch.begin]);
+            }
+        }
+        for (auto& item : batch.found) {
+            items[item.first] = std::move(item.second);
         }
+    }
+    return failure.Result(timer);
+}
+
+void DynamoDBManager::ScanTable(const std::string& tableName) {
+    std::cout << "Items in " << tableName << ":" << std::endl;
+    
+    std::size_t itemCount = 0;
+    OperationResult scanned = ScanTable(tableName, ScanOptions(), [&itemCount](const AttributeMap& item) {
+        auto attribute = [&item](const char* name, bool numeric) -> std::string {
+            auto found = item.find(name);
+            if (found == item.end()) {
+                return "-";
+            }
+            return numeric ? found->second.GetN() : found->second.GetS();
+        };
+        std::cout << "ID: " << attribute("id", false)
+                  << ", Name: " << attribute("name", false)
+                  << ", Age: " << attribute("age", true) << '\n';
+        ++itemCount;
+        return true;
+    });
+    
+    if (scanned && itemCount == 0) {
+        std::cout << "No items found in the table" << std::endl;
     } else {
-        std::cerr << "Error: " << outcome.GetError().GetMessage() << std::endl;
+        std::cout.flush();
     }
 }
 
-bool DynamoDBManager::DeleteItem(const std::string& tableName, const std::string& id) {
-    Aws::DynamoDB::Model::DeleteItemRequest request;
+OperationResult DynamoDBManager::ScanTable(const std::string& tableName,
+                                           const ScanOptions& options,
+                                           const ItemCallback& callback) {
+    utils::TraceScope scope("ScanTable");
+    detail::ResultTimer timer;
+    detail::FirstFailure failure;
+    const int totalSegments = std::max(options.totalSegments, 1);
+    std::atomic<bool> stopped{false};
     
-    request.SetTableName(tableName);
+    auto scanSegment = [&](std::size_t segment) {
+        Aws::DynamoDB::Model::ScanRequest request;
+        request.SetTableName(tableName);
+        if (totalSegments > 1) {
+            request.SetSegment(static_cast<int>(segment));
+            request.SetTotalSegments(totalSegments);
+        }
+        if (options.pageSize > 0) {
+            request.SetLimit(options.pageSize);
+        }
+        if (options.consistentRead) {
+            request.SetConsistentRead(true);
+        }
+        if (!options.projectionExpression.empty()) {
+            request.SetProjectionExpression(options.projectionExpression);
+        }
+        if (!options.filterExpression.empty()) {
+            request.SetFilterExpression(options.filterExpression);
+        }
+        if (!options.expressionAttributeNames.empty()) {
+            request.SetExpressionAttributeNames(options.expressionAttributeNames);
+        }
+        if (!options.expressionAttributeValues.empty()) {
+            request.SetExpressionAttributeValues(options.expressionAttributeValues);
+        }
+        
+        while (!stopped.load(std::memory_order_relaxed)) {
+            auto outcome = detail::Execute(*retryController, "Scan", [&]() { return client->Scan(request); });
+            if (!outcome.IsSuccess()) {
+                AWSEXAMPLES_LOG(Error, "Scan error (segment " << segment << "): "
+                                       << outcome.GetError().GetMessage());
+                failure.Record(outcome);
+                return false;
+            }
+            
+            const auto& result = outcome.GetResult();
+            for (const auto& item : result.GetItems()) {
+                if (stopped.load(std::memory_order_relaxed) || !callback(item)) {
+                    stopped.store(true, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            
+            if (result.GetLastEvaluatedKey().empty()) {
+                return true;
+            }
+            request.SetExclusiveStartKey(result.GetLastEvaluatedKey());
+        }
+        return true;
+    };
+
+    // Segments may number up to a million, so by default they share a bounded pool
+    const unsigned defaultConcurrency = std::max(std::thread::hardware_concurrency(), 1U);
+    const unsigned concurrency = options.concurrency > 0
+        ? options.concurrency
+        : std::min(static_cast<unsigned>(totalSegments), defaultConcurrency);
+    detail::ParallelFor(static_cast<std::size_t>(totalSegments), concurrency, scanSegment);
+    return failure.Result(timer);
+}
+
+OperationResult DynamoDBManager::Query(const std::string& tableName,
+                                       const QueryOptions& options,
+                                       const ItemCallback& callback) {
+    utils::TraceScope scope("Query");
+    detail::ResultTimer timer;
+    auto request = MakeQueryRequest(tableName, options);
+    int remaining = options.limit;
     
-    // Set key to delete
-    Aws::DynamoDB::Model::AttributeValue keyAttr;
-    keyAttr.SetS(id);
-    request.AddKey("id", keyAttr);
+    while (true) {
+        // Ask for no more items than the limit still allows
+        if (options.limit > 0 && (options.pageSize <= 0 || remaining < options.pageSize)) {
+            request.SetLimit(remaining);
+        }
+        
+        auto outcome = detail::Execute(*retryController, "Query", [&]() { return client->Query(request); });
+        if (!outcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "Query error: " << outcome.GetError().GetMessage());
+            return timer.From(outcome);
+        }
+        
+        const auto& result = outcome.GetResult();
+        for (const auto& item : result.GetItems()) {
+            if (!callback(item)) {
+                return timer.Succeeded();
+            }
+        }
+        
+        // The limit counts evaluated items, including those the filter dropped
+        remaining -= result.GetScannedCount();
+        if (result.GetLastEvaluatedKey().empty() || (options.limit > 0 && remaining <= 0)) {
+            return timer.Succeeded();
+        }
+        request.SetExclusiveStartKey(result.GetLastEvaluatedKey());
+    }
+}
+
+OperationResult DynamoDBManager::QueryPage(const std::string& tableName,
+                                           const QueryOptions& options,
+                                           std::vector<AttributeMap>& items,
+                                           AttributeMap& lastEvaluatedKey) {
+    detail::ResultTimer timer;
+    auto request = MakeQueryRequest(tableName, options);
+    auto outcome = detail::Execute(*retryController, "Query", [&]() { return client->Query(request); });
+    if (!outcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "Query error: " << outcome.GetError().GetMessage());
+        return timer.From(outcome);
+    }
     
-    auto outcome = client.DeleteItem(request);
+    const auto& result = outcome.GetResult();
+    items.assign(result.GetItems().begin(), result.GetItems().end());
+    lastEvaluatedKey = result.GetLastEvaluatedKey();
+    return timer.Succeeded();
+}
+
+OperationResult DynamoDBManager::DeleteItem(const std::string& tableName, const std::string& id) {
+    detail::ResultTimer timer;
+    auto outcome = detail::Execute(*retryController, "DeleteItem", [&]() {
+        return client->DeleteItem(MakeDeleteItemRequest(tableName, id));
+    });
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Item deleted successfully!" << std::endl;
-        return true;
-    } else {
-        std::cerr << "Error deleting item: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    if (itemCache) {
+        itemCache->Invalidate(tableName, id);
     }
+    return detail::ReportResult(timer, outcome, "Item deleted successfully!", "Error deleting item");
 }
 
-bool DynamoDBManager::DeleteTable(const std::string& tableName) {
+OperationResult DynamoDBManager::DeleteTable(const std::string& tableName) {
+    detail::ResultTimer timer;
     Aws::DynamoDB::Model::DeleteTableRequest request;
     request.SetTableName(tableName);
     
-    auto outcome = client.DeleteTable(request);
+    auto outcome = detail::Execute(*retryController, "DeleteTable", [&]() { return client->DeleteTable(request); });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Table " + tableName + " deleted successfully!",
+                                "Error deleting table");
+}
+
+void DynamoDBManager::CreateTableAsync(const std::string& tableName, CompletionCallback callback) {
+    TableSpec spec;
+    spec.name = tableName;
+    CreateTableAsync(spec, std::move(callback));
+}
+
+std::future<bool> DynamoDBManager::CreateTableAsync(const std::string& tableName) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        CreateTableAsync(tableName, std::move(done));
+    });
+}
+
+void DynamoDBManager::CreateTableAsync(const TableSpec& spec, CompletionCallback callback) {
+    std::string problem = ValidateTableSpec(spec);
+    if (!problem.empty()) {
+        AWSEXAMPLES_LOG(Error, "Error creating table: " << problem);
+        callback(false);
+        return;
+    }
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Table " << tableName << " deleted successfully!" << std::endl;
-        return true;
-    } else {
-        std::cerr << "Error deleting table: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    detail::ExecuteAsync<Aws::DynamoDB::Model::CreateTableOutcome>(
+        retryController, "CreateTable",
+        [client = client, request = MakeCreateTableRequest(spec)](auto onOutcome) {
+            client->CreateTableAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [tableName = spec.name, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Table " + tableName + " created successfully!",
+                                           "Error creating table"));
+        });
+}
+
+std::future<bool> DynamoDBManager::CreateTableAsync(const TableSpec& spec) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        CreateTableAsync(spec, std::move(done));
+    });
+}
+
+void DynamoDBManager::PutItemAsync(const std::string& tableName,
+                                   const std::string& id,
+                                   const std::string& name,
+                                   int age,
+                                   CompletionCallback callback) {
+    detail::ExecuteAsync<Aws::DynamoDB::Model::PutItemOutcome>(
+        retryController, "PutItem",
+        [client = client, request = MakePutItemRequest(tableName, id, name, age)](auto onOutcome) {
+            client->PutItemAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [tableName, id, cache = itemCache, callback](const auto& outcome) {
+            if (cache) {
+                cache->Invalidate(tableName, id);
+            }
+            callback(detail::ReportOutcome(outcome, "Item added successfully!", "Error"));
+        });
+}
+
+std::future<bool> DynamoDBManager::PutItemAsync(const std::string& tableName,
+                                                const std::string& id,
+                                                const std::string& name,
+                                                int age) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        PutItemAsync(tableName, id, name, age, std::move(done));
+    });
+}
+
+void DynamoDBManager::GetItemAsync(const std::string& tableName,
+                                   const std::string& id,
+                                   GetItemCallback callback) {
+    GetItemResult cached;
+    if (itemCache && itemCache->Get(tableName, id, cached.item)) {
+        cached.success = true;
+        callback(cached);
+        return;
     }
+    
+    std::uint64_t generation = itemCache ? itemCache->Generation(tableName, id) : 0;
+    detail::ExecuteAsync<Aws::DynamoDB::Model::GetItemOutcome>(
+        retryController, "GetItem",
+        [client = client, request = MakeGetItemRequest(tableName, id)](auto onOutcome) {
+            client->GetItemAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [tableName, id, cache = itemCache, generation, callback](const auto& outcome) {
+            GetItemResult result;
+            result.success = outcome.IsSuccess();
+            if (result.success) {
+                result.item = outcome.GetResult().GetItem();
+                if (cache) {
+                    cache->Put(tableName, id, result.item, generation);
+                }
+            } else {
+                AWSEXAMPLES_LOG(Error, "Error: " << outcome.GetError().GetMessage());
+            }
+            callback(result);
+        });
+}
+
+std::future<GetItemResult> DynamoDBManager::GetItemAsync(const std::string& tableName, const std::string& id) {
+    return detail::ToFuture<GetItemResult>([&](GetItemCallback done) {
+        GetItemAsync(tableName, id, std::move(done));
+    });
+}
+
+void DynamoDBManager::DeleteItemAsync(const std::string& tableName,
+                                      const std::string& id,
+                                      CompletionCallback callback) {
+    detail::ExecuteAsync<Aws::DynamoDB::Model::DeleteItemOutcome>(
+        retryController, "DeleteItem",
+        [client = client, request = MakeDeleteItemRequest(tableName, id)](auto onOutcome) {
+            client->DeleteItemAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [tableName, id, cache = itemCache, callback](const auto& outcome) {
+            if (cache) {
+                cache->Invalidate(tableName, id);
+            }
+            callback(detail::ReportOutcome(outcome, "Item deleted successfully!", "Error deleting item"));
+        });
+}
+
+std::future<bool> DynamoDBManager::DeleteItemAsync(const std::string& tableName, const std::string& id) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        DeleteItemAsync(tableName, id, std::move(done));
+    });
+}
+
+void DynamoDBManager::DeleteTableAsync(const std::string& tableName, CompletionCallback callback) {
+    Aws::DynamoDB::Model::DeleteTableRequest request;
+    request.SetTableName(tableName);
+    
+    detail::ExecuteAsync<Aws::DynamoDB::Model::DeleteTableOutcome>(
+        retryController, "DeleteTable",
+        [client = client, request](auto onOutcome) {
+            client->DeleteTableAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [tableName, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Table " + tableName + " deleted successfully!",
+                                           "Error deleting table"));
+        });
+}
+
+std::future<bool> DynamoDBManager::DeleteTableAsync(const std::string& tableName) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        DeleteTableAsync(tableName, std::move(done));
+    });
 }
 
 bool DynamoDBManager::WaitForTableState(
@@ -185,42 +916,28 @@ bool DynamoDBManager::WaitForTableState(
     const std::string& targetState,
     int maxWaitSeconds) {
     
+    WaitOptions options;
+    options.timeout = std::chrono::seconds(maxWaitSeconds);
+    return WaitForTableStateAsync(tableName, targetState, options).get();
+}
+
+void DynamoDBManager::WaitForTableStateAsync(const std::string& tableName,
+                                             const std::string& targetState,
+                                             const WaitOptions& options,
+                                             CompletionCallback callback) {
     Aws::DynamoDB::Model::DescribeTableRequest request;
     request.SetTableName(tableName);
     
-    int waitTimeSeconds = 0;
-    bool tableInTargetState = false;
-    
-    while (!tableInTargetState && waitTimeSeconds < maxWaitSeconds) {
-        auto outcome = client.DescribeTable(request);
-        
-        if (outcome.IsSuccess()) {
-            const auto& tableStatus = outcome.GetResult().GetTable().GetTableStatus();
-            const auto status = Aws::DynamoDB::Model::TableStatusMapper::GetNameForTableStatus(tableStatus);
-            
-            std::cout << "Table status: " << status << std::endl;
-            
-            if (status == targetState) {
-                tableInTargetState = true;
-                break;
-            }
-        } else {
-            if (targetState == "DELETED" && 
-                outcome.GetError().GetErrorType() == Aws::DynamoDB::DynamoDBErrors::RESOURCE_NOT_FOUND) {
-                tableInTargetState = true;
-                break;
-            } else {
-                std::cerr << "Error checking table status: " << outcome.GetError().GetMessage() << std::endl;
-                return false;
-            }
-        }
-        
-        // Wait before checking again
-        std::this_thread::sleep_for(std::chrono::seconds(5));
-        waitTimeSeconds += 5;
-    }
-    
-    return tableInTargetState;
+    ScheduleTableCheck(std::make_shared<TableWait>(
+        TableWait{client, request, targetState, detail::PollSchedule(options), std::move(callback)}));
+}
+
+std::future<bool> DynamoDBManager::WaitForTableStateAsync(const std::string& tableName,
+                                                          const std::string& targetState,
+                                                          const WaitOptions& options) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        WaitForTableStateAsync(tableName, targetState, options, std::move(done));
+    });
 }
 
 } // namespace awsexamples
@@ -4,85 +4,456 @@
  */
 
 #include "awsexamples/EC2Manager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/Logger.h"
+#include "AsyncSupport.h"
+#include "InstanceStateWaiter.h"
+#include "ParallelFor.h"
+#include "ResultSupport.h"
+#include "RetrySupport.h"
 #include <aws/ec2/model/DescribeInstancesRequest.h>
+#include <aws/ec2/model/Filter.h>
 #include <aws/ec2/model/StartInstancesRequest.h>
 #include <aws/ec2/model/StopInstancesRequest.h>
 #include <aws/ec2/model/RunInstancesRequest.h>
 #include <aws/ec2/model/TerminateInstancesRequest.h>
-#include <iostream>
-#include <thread>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <iostream>
+#include <set>
+#include <utility>
 
 namespace awsexamples {
 
-EC2Manager::EC2Manager() : ec2Client() {}
+namespace {
 
-EC2Manager::EC2Manager(const Aws::Client::ClientConfiguration& config) : ec2Client(config) {}
-
-void EC2Manager::ListInstances() {
-    Aws::EC2::Model::DescribeInstancesRequest request;
+Aws::EC2::Model::RunInstancesRequest MakeRunInstancesRequest(const std::string& amiId,
+                                                             const std::string& instanceType,
+                                                             const std::string& keyName) {
+    Aws::EC2::Model::RunInstancesRequest request;
     
-    auto outcome = ec2Client.DescribeInstances(request);
+    request.SetImageId(amiId);
+    request.SetInstanceType(
+        Aws::EC2::Model::InstanceTypeMapper::GetInstanceTypeForName(instanceType)
+    );
+    request.SetMinCount(1);
+    request.SetMaxCount(1);
     
+    if (!keyName.empty()) {
+        request.SetKeyName(keyName);
+    }
+    return request;
+}
+
+// Extract the launched instance ID from a RunInstances outcome, or "" on failure
+std::string ReportLaunch(const Aws::EC2::Model::RunInstancesOutcome& outcome) {
     if (outcome.IsSuccess()) {
-        const auto& reservations = outcome.GetResult().GetReservations();
-        
-        if (reservations.empty()) {
-            std::cout << "No EC2 instances found." << std::endl;
+        const auto& instances = outcome.GetResult().GetInstances();
+        if (!instances.empty()) {
+            std::string instanceId = instances[0].GetInstanceId();
+            AWSEXAMPLES_LOG(Info, "Launched instance " << instanceId);
+            return instanceId;
+        } else {
+            AWSEXAMPLES_LOG(Error, "Error: No instances were launched");
+            return "";
+        }
+    } else {
+        AWSEXAMPLES_LOG(Error, "Error launching instance: " << outcome.GetError().GetMessage());
+        return "";
+    }
+}
+
+// Instance IDs sent per StartInstances, StopInstances or TerminateInstances request
+constexpr std::size_t kMaxStateChangeIds = 100;
+
+template <typename Request>
+Request MakeInstanceIdsRequest(std::vector<std::string>::const_iterator begin,
+                               std::vector<std::string>::const_iterator end) {
+    Request request;
+    for (auto it = begin; it != end; ++it) {
+        request.AddInstanceIds(*it);
+    }
+    return request;
+}
+
+// Whether a state change failed because of one of its instances, so the others may still succeed
+template <typename Error>
+bool NamesBadInstance(const Error& error) {
+    const auto& name = error.GetExceptionName();
+    return name.rfind("InvalidInstanceID.", 0) == 0 || name == "IncorrectInstanceState";
+}
+
+// Send a state change for many instances in batches and collect a per-instance result.
+// submit starts a request and returns a future for its outcome; changes extracts the
+// list of instance state changes from a successful result.
+template <typename Request, typename Submit, typename Changes>
+InstanceResultMap ChangeInstanceStates(const std::vector<std::string>& instanceIds,
+                                       Submit submit,
+                                       Changes changes,
+                                       const char* action,
+                                       const char* errorLabel) {
+    std::set<std::string> uniqueIds(instanceIds.begin(), instanceIds.end());
+    std::vector<std::string> ids(uniqueIds.begin(), uniqueIds.end());
+    
+    InstanceResultMap results;
+    for (const auto& id : ids) {
+        results[id] = false;
+    }
+    
+    using Future = decltype(submit(std::declval<const Request&>()));
+    auto record = [&](const auto& result) {
+        for (const auto& change : changes(result)) {
+            results[change.GetInstanceId()] = true;
+        }
+    };
+    
+    std::vector<std::pair<std::vector<std::string>, Future>> batches;
+    for (std::size_t begin = 0; begin < ids.size(); begin += kMaxStateChangeIds) {
+        std::vector<std::string> batch(ids.begin() + begin,
+                                       ids.begin() + std::min(begin + kMaxStateChangeIds, ids.size()));
+        Future future = submit(MakeInstanceIdsRequest<Request>(batch.begin(), batch.end()));
+        batches.emplace_back(std::move(batch), std::move(future));
+    }
+    
+    // One bad ID fails the whole request; retry the batch one instance at a time. Throttling
+    // and transient errors have already been retried as a whole batch, with backoff, by the
+    // controller, and splitting the batch would only multiply the requests
+    std::vector<std::pair<std::string, Future>> retries;
+    for (auto& batch : batches) {
+        auto outcome = batch.second.get();
+        if (outcome.IsSuccess()) {
+            record(outcome.GetResult());
+        } else if (batch.first.size() == 1) {
+            AWSEXAMPLES_LOG(Error, errorLabel << " " << batch.first[0] << ": " << outcome.GetError().GetMessage());
+        } else if (!NamesBadInstance(outcome.GetError())) {
+            AWSEXAMPLES_LOG(Error, errorLabel << " " << batch.first.front() << " to " << batch.first.back() << ": "
+                                   << outcome.GetError().GetMessage());
+        } else {
+            for (auto it = batch.first.begin(); it != batch.first.end(); ++it) {
+                retries.emplace_back(*it, submit(MakeInstanceIdsRequest<Request>(it, it + 1)));
+            }
+        }
+    }
+    
+    for (auto& retry : retries) {
+        auto outcome = retry.second.get();
+        if (outcome.IsSuccess()) {
+            record(outcome.GetResult());
+        } else {
+            AWSEXAMPLES_LOG(Error, errorLabel << " " << retry.first << ": " << outcome.GetError().GetMessage());
+        }
+    }
+    
+    auto succeeded = std::count_if(results.begin(), results.end(), [](const auto& entry) { return entry.second; });
+    AWSEXAMPLES_LOG(Info, action << " initiated for " << succeeded << " of " << results.size() << " instances");
+    return results;
+}
+
+// Largest page DescribeInstances returns
+constexpr int kMaxDescribePageSize = 1000;
+
+// Request a page of instances in the background through the controller
+std::future<Aws::EC2::Model::DescribeInstancesOutcome> RequestInstancesPage(
+    const Aws::EC2::EC2Client& client,
+    const std::shared_ptr<utils::RetryController>& controller,
+    const Aws::EC2::Model::DescribeInstancesRequest& request) {
+    return detail::ExecuteCallable<Aws::EC2::Model::DescribeInstancesOutcome>(
+        controller, "DescribeInstances", [&client, request](auto onOutcome) {
+            client.DescribeInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        });
+}
+
+// Add every instance visible to a client to a snapshot, fetching the next page
+// while the current one is being added; a failed page is recorded in failure
+void SnapshotInstances(const Aws::EC2::EC2Client& client,
+                       const std::shared_ptr<utils::RetryController>& controller,
+                       const std::string& region,
+                       FleetSnapshot& snapshot,
+                       detail::FirstFailure& failure) {
+    Aws::EC2::Model::DescribeInstancesRequest request;
+    request.SetMaxResults(kMaxDescribePageSize);
+    auto nextPage = RequestInstancesPage(client, controller, request);
+    
+    for (;;) {
+        auto outcome = nextPage.get();
+        if (!outcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "Error describing instances" << (region.empty() ? "" : " in " + region) << ": "
+                                   << outcome.GetError().GetMessage());
+            failure.Record(outcome);
             return;
         }
         
-        std::cout << "EC2 Instances:" << std::endl;
-        for (const auto& reservation : reservations) {
+        const auto& nextToken = outcome.GetResult().GetNextToken();
+        if (!nextToken.empty()) {
+            request.SetNextToken(nextToken);
+            nextPage = RequestInstancesPage(client, controller, request);
+        }
+        
+        for (const auto& reservation : outcome.GetResult().GetReservations()) {
             for (const auto& instance : reservation.GetInstances()) {
-                std::cout << "Instance ID: " << instance.GetInstanceId() << std::endl;
-                std::cout << "State: " << Aws::EC2::Model::InstanceStateNameMapper::GetNameForInstanceStateName(instance.GetState().GetName()) << std::endl;
-                std::cout << "Type: " << instance.GetInstanceTypeAsString() << std::endl;
-                
-                // Print tags
-                std::cout << "Tags: ";
-                for (const auto& tag : instance.GetTags()) {
-                    std::cout << tag.GetKey() << "=" << tag.GetValue() << " ";
-                }
-                std::cout << std::endl;
-                std::cout << "---" << std::endl;
+                snapshot.Add(instance, region);
             }
         }
-    } else {
-        std::cerr << "Error: " << outcome.GetError().GetMessage() << std::endl;
+        
+        if (nextToken.empty()) {
+            return;
+        }
     }
 }
 
-bool EC2Manager::StartInstance(const std::string& instanceId) {
-    Aws::EC2::Model::StartInstancesRequest request;
+// Request one page of a DescribeInstancesAsync call and chain the next; the call
+// holds the client and controller, so it may outlive the manager
+void DescribeInstancesPage(std::shared_ptr<Aws::EC2::EC2Client> client,
+                           std::shared_ptr<utils::RetryController> controller,
+                           const Aws::EC2::Model::DescribeInstancesRequest& request,
+                           std::shared_ptr<InstancesResult> result,
+                           InstancesCallback callback) {
+    detail::ExecuteAsync<Aws::EC2::Model::DescribeInstancesOutcome>(
+        controller, "DescribeInstances",
+        [client, request](auto onOutcome) {
+            client->DescribeInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [client, controller, request, result, callback](const auto& outcome) {
+            if (!outcome.IsSuccess()) {
+                AWSEXAMPLES_LOG(Error, "Error describing instances: " << outcome.GetError().GetMessage());
+                callback(*result);
+                return;
+            }
+            
+            for (const auto& reservation : outcome.GetResult().GetReservations()) {
+                result->instances.insert(result->instances.end(),
+                                         reservation.GetInstances().begin(),
+                                         reservation.GetInstances().end());
+            }
+            
+            const auto& nextToken = outcome.GetResult().GetNextToken();
+            if (nextToken.empty()) {
+                result->success = true;
+                callback(*result);
+                return;
+            }
+            auto nextRequest = request;
+            nextRequest.SetNextToken(nextToken);
+            DescribeInstancesPage(client, controller, nextRequest, result, callback);
+        });
+}
+
+}  // namespace
+
+EC2Manager::EC2Manager() : EC2Manager(Aws::Client::ClientConfiguration()) {}
+
+EC2Manager::EC2Manager(const Aws::Client::ClientConfiguration& config)
+    : EC2Manager(utils::ClientRegistry::Instance().Get<Aws::EC2::EC2Client>(detail::WithoutSdkRetries(config))) {}
+
+EC2Manager::EC2Manager(std::shared_ptr<Aws::EC2::EC2Client> client)
+    : ec2Client(std::move(client)),
+      retryController(utils::RetryController::ForService("ec2")),
+      instanceWaiter(std::make_shared<detail::InstanceStateWaiter>(ec2Client)) {}
+
+void EC2Manager::ListInstances() {
+    FleetSnapshot snapshot;
+    OperationResult complete = DescribeFleet(snapshot);
     
-    request.AddInstanceIds(instanceId);
+    if (snapshot.Size() == 0) {
+        if (complete) {
+            std::cout << "No EC2 instances found." << std::endl;
+        }
+        return;
+    }
     
-    auto outcome = ec2Client.StartInstances(request);
+    // Flush once at the end rather than once per line
+    std::cout << "EC2 Instances:\n";
+    for (std::size_t row = 0; row < snapshot.Size(); ++row) {
+        std::cout << "Instance ID: " << snapshot.InstanceId(row) << '\n';
+        std::cout << "State: " << snapshot.State(row) << '\n';
+        std::cout << "Type: " << snapshot.InstanceType(row) << '\n';
+        
+        // Print tags
+        std::cout << "Tags: ";
+        for (const auto& tag : snapshot.GetTags(row)) {
+            std::cout << tag.first << "=" << tag.second << " ";
+        }
+        std::cout << "\n---\n";
+    }
+    std::cout << std::flush;
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Instance " << instanceId << " start initiated" << std::endl;
+    if (!complete) {
+        AWSEXAMPLES_LOG(Warn, "Instance list is incomplete");
+    }
+}
+
+OperationResult EC2Manager::DescribeFleet(FleetSnapshot& snapshot) {
+    detail::ResultTimer timer;
+    detail::FirstFailure failure;
+    SnapshotInstances(*ec2Client, retryController, "", snapshot, failure);
+    return failure.Result(timer);
+}
+
+OperationResult EC2Manager::DescribeFleet(const std::vector<std::string>& regions,
+                                          const Aws::Client::ClientConfiguration& config,
+                                          FleetSnapshot& snapshot) {
+    detail::ResultTimer timer;
+    std::vector<FleetSnapshot> regionSnapshots(regions.size());
+    detail::FirstFailure failure;
+    auto controller = utils::RetryController::ForService("ec2");
+    
+    detail::ParallelFor(regions.size(), static_cast<unsigned>(regions.size()), [&](std::size_t index) {
+        Aws::Client::ClientConfiguration regionConfig = detail::WithoutSdkRetries(config);
+        regionConfig.region = regions[index];
+        auto client = utils::ClientRegistry::Instance().Get<Aws::EC2::EC2Client>(regionConfig);
+        SnapshotInstances(*client, controller, regions[index], regionSnapshots[index], failure);
+        // Keep going so the other regions are still described
         return true;
-    } else {
-        std::cerr << "Error starting instance: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    });
+    
+    std::size_t total = snapshot.Size();
+    for (const auto& regionSnapshot : regionSnapshots) {
+        total += regionSnapshot.Size();
+    }
+    snapshot.Reserve(total);
+    for (const auto& regionSnapshot : regionSnapshots) {
+        snapshot.Append(regionSnapshot);
     }
+    return failure.Result(timer);
+}
+
+OperationResult EC2Manager::StartInstance(const std::string& instanceId) {
+    detail::ResultTimer timer;
+    Aws::EC2::Model::StartInstancesRequest request;
+    
+    request.AddInstanceIds(instanceId);
+    
+    auto outcome = detail::Execute(*retryController, "StartInstances", [&]() { return ec2Client->StartInstances(request); });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Instance " + instanceId + " start initiated",
+                                "Error starting instance");
 }
 
-bool EC2Manager::StopInstance(const std::string& instanceId) {
+OperationResult EC2Manager::StopInstance(const std::string& instanceId) {
+    detail::ResultTimer timer;
     Aws::EC2::Model::StopInstancesRequest request;
     
     request.AddInstanceIds(instanceId);
     
-    auto outcome = ec2Client.StopInstances(request);
+    auto outcome = detail::Execute(*retryController, "StopInstances", [&]() { return ec2Client->StopInstances(request); });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Instance " + instanceId + " stop initiated",
+                                "Error stopping instance");
+}
+
+InstanceResultMap EC2Manager::StartInstances(const std::vector<std::string>& instanceIds) {
+    return ChangeInstanceStates<Aws::EC2::Model::StartInstancesRequest>(
+        instanceIds,
+        [this](const auto& request) {
+            return detail::ExecuteCallable<Aws::EC2::Model::StartInstancesOutcome>(
+                retryController, "StartInstances", [client = ec2Client, request](auto onOutcome) {
+                    client->StartInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                        onOutcome(outcome);
+                    });
+                });
+        },
+        [](const auto& result) -> const auto& { return result.GetStartingInstances(); },
+        "Start",
+        "Error starting instance");
+}
+
+InstanceResultMap EC2Manager::StopInstances(const std::vector<std::string>& instanceIds) {
+    return ChangeInstanceStates<Aws::EC2::Model::StopInstancesRequest>(
+        instanceIds,
+        [this](const auto& request) {
+            return detail::ExecuteCallable<Aws::EC2::Model::StopInstancesOutcome>(
+                retryController, "StopInstances", [client = ec2Client, request](auto onOutcome) {
+                    client->StopInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                        onOutcome(outcome);
+                    });
+                });
+        },
+        [](const auto& result) -> const auto& { return result.GetStoppingInstances(); },
+        "Stop",
+        "Error stopping instance");
+}
+
+InstanceResultMap EC2Manager::TerminateInstances(const std::vector<std::string>& instanceIds) {
+    return ChangeInstanceStates<Aws::EC2::Model::TerminateInstancesRequest>(
+        instanceIds,
+        [this](const auto& request) {
+            return detail::ExecuteCallable<Aws::EC2::Model::TerminateInstancesOutcome>(
+                retryController, "TerminateInstances", [client = ec2Client, request](auto onOutcome) {
+                    client->TerminateInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                        onOutcome(outcome);
+                    });
+                });
+        },
+        [](const auto& result) -> const auto& { return result.GetTerminatingInstances(); },
+        "Termination",
+        "Error terminating instance");
+}
+
+OperationResult EC2Manager::GetInstanceStates(const std::vector<std::string>& instanceIds, InstanceStateMap& states) {
+    detail::ResultTimer timer;
+    std::set<std::string> uniqueIds(instanceIds.begin(), instanceIds.end());
+    std::vector<std::string> ids(uniqueIds.begin(), uniqueIds.end());
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Instance " << instanceId << " stop initiated" << std::endl;
-        return true;
-    } else {
-        std::cerr << "Error stopping instance: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    auto describe = [this](const Aws::EC2::Model::DescribeInstancesRequest& request) {
+        return detail::ExecuteCallable<Aws::EC2::Model::DescribeInstancesOutcome>(
+            retryController, "DescribeInstances", [client = ec2Client, request](auto onOutcome) {
+                client->DescribeInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                    onOutcome(outcome);
+                });
+            });
+    };
+    
+    // Start the first page of every batch, then follow each batch's pages in turn
+    using Page = std::pair<Aws::EC2::Model::DescribeInstancesRequest,
+                           std::future<Aws::EC2::Model::DescribeInstancesOutcome>>;
+    std::vector<Page> pages;
+    for (std::size_t begin = 0; begin < ids.size(); begin += detail::kMaxInstanceFilterValues) {
+        Aws::EC2::Model::Filter filter;
+        filter.SetName("instance-id");
+        for (std::size_t i = begin; i < std::min(begin + detail::kMaxInstanceFilterValues, ids.size()); ++i) {
+            filter.AddValues(ids[i]);
+        }
+        
+        Aws::EC2::Model::DescribeInstancesRequest request;
+        request.AddFilters(filter);
+        auto future = describe(request);
+        pages.emplace_back(std::move(request), std::move(future));
     }
+    
+    detail::FirstFailure failure;
+    for (auto& page : pages) {
+        for (;;) {
+            auto outcome = page.second.get();
+            if (!outcome.IsSuccess()) {
+                AWSEXAMPLES_LOG(Error, "Error getting instance state: " << outcome.GetError().GetMessage());
+                failure.Record(outcome);
+                break;
+            }
+            
+            for (const auto& reservation : outcome.GetResult().GetReservations()) {
+                for (const auto& instance : reservation.GetInstances()) {
+                    states[instance.GetInstanceId()] =
+                        Aws::EC2::Model::InstanceStateNameMapper::GetNameForInstanceStateName(
+                            instance.GetState().GetName());
+                }
+            }
+            
+            const auto& nextToken = outcome.GetResult().GetNextToken();
+            if (nextToken.empty()) {
+                break;
+            }
+            page.first.SetNextToken(nextToken);
+            page.second = describe(page.first);
+        }
+    }
+    return failure.Result(timer);
 }
 
 std::string EC2Manager::LaunchInstance(
@@ -90,78 +461,130 @@ std::string EC2Manager::LaunchInstance(
     const std::string& instanceType,
     const std::string& keyName) {
     
-    Aws::EC2::Model::RunInstancesRequest request;
+    return ReportLaunch(detail::Measure("RunInstances", [&]() {
+        return ec2Client->RunInstances(MakeRunInstancesRequest(amiId, instanceType, keyName));
+    }));
+}
+
+OperationResult EC2Manager::TerminateInstance(const std::string& instanceId) {
+    detail::ResultTimer timer;
+    Aws::EC2::Model::TerminateInstancesRequest request;
     
-    request.SetImageId(amiId);
-    request.SetInstanceType(
-        Aws::EC2::Model::InstanceTypeMapper::GetInstanceTypeForName(instanceType)
-    );
-    request.SetMinCount(1);
-    request.SetMaxCount(1);
+    request.AddInstanceIds(instanceId);
     
-    if (!keyName.empty()) {
-        request.SetKeyName(keyName);
-    }
+    auto outcome = detail::Execute(*retryController, "TerminateInstances", [&]() { return ec2Client->TerminateInstances(request); });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Instance " + instanceId + " termination initiated",
+                                "Error terminating instance");
+}
+
+void EC2Manager::StartInstanceAsync(const std::string& instanceId, CompletionCallback callback) {
+    Aws::EC2::Model::StartInstancesRequest request;
+    request.AddInstanceIds(instanceId);
     
-    auto outcome = ec2Client.RunInstances(request);
+    detail::ExecuteAsync<Aws::EC2::Model::StartInstancesOutcome>(
+        retryController, "StartInstances",
+        [client = ec2Client, request](auto onOutcome) {
+            client->StartInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [instanceId, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Instance " + instanceId + " start initiated",
+                                           "Error starting instance"));
+        });
+}
+
+std::future<bool> EC2Manager::StartInstanceAsync(const std::string& instanceId) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        StartInstanceAsync(instanceId, std::move(done));
+    });
+}
+
+void EC2Manager::StopInstanceAsync(const std::string& instanceId, CompletionCallback callback) {
+    Aws::EC2::Model::StopInstancesRequest request;
+    request.AddInstanceIds(instanceId);
     
-    if (outcome.IsSuccess()) {
-        const auto& instances = outcome.GetResult().GetInstances();
-        if (!instances.empty()) {
-            std::string instanceId = instances[0].GetInstanceId();
-            std::cout << "Launched instance " << instanceId << std::endl;
-            return instanceId;
-        } else {
-            std::cerr << "Error: No instances were launched" << std::endl;
-            return "";
-        }
-    } else {
-        std::cerr << "Error launching instance: " << outcome.GetError().GetMessage() << std::endl;
-        return "";
-    }
+    detail::ExecuteAsync<Aws::EC2::Model::StopInstancesOutcome>(
+        retryController, "StopInstances",
+        [client = ec2Client, request](auto onOutcome) {
+            client->StopInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [instanceId, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Instance " + instanceId + " stop initiated",
+                                           "Error stopping instance"));
+        });
 }
 
-bool EC2Manager::TerminateInstance(const std::string& instanceId) {
+std::future<bool> EC2Manager::StopInstanceAsync(const std::string& instanceId) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        StopInstanceAsync(instanceId, std::move(done));
+    });
+}
+
+void EC2Manager::LaunchInstanceAsync(const std::string& amiId,
+                                     const std::string& instanceType,
+                                     const std::string& keyName,
+                                     StringCallback callback) {
+    ec2Client->RunInstancesAsync(
+        MakeRunInstancesRequest(amiId, instanceType, keyName),
+        [callback](const auto*, const auto&, const auto& outcome, const auto&) {
+            callback(ReportLaunch(outcome));
+        });
+}
+
+std::future<std::string> EC2Manager::LaunchInstanceAsync(const std::string& amiId,
+                                                         const std::string& instanceType,
+                                                         const std::string& keyName) {
+    return detail::ToFuture<std::string>([&](StringCallback done) {
+        LaunchInstanceAsync(amiId, instanceType, keyName, std::move(done));
+    });
+}
+
+void EC2Manager::TerminateInstanceAsync(const std::string& instanceId, CompletionCallback callback) {
     Aws::EC2::Model::TerminateInstancesRequest request;
-    
     request.AddInstanceIds(instanceId);
     
-    auto outcome = ec2Client.TerminateInstances(request);
-    
-    if (outcome.IsSuccess()) {
-        std::cout << "Instance " << instanceId << " termination initiated" << std::endl;
-        return true;
-    } else {
-        std::cerr << "Error terminating instance: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
-    }
+    detail::ExecuteAsync<Aws::EC2::Model::TerminateInstancesOutcome>(
+        retryController, "TerminateInstances",
+        [client = ec2Client, request](auto onOutcome) {
+            client->TerminateInstancesAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [instanceId, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Instance " + instanceId + " termination initiated",
+                                           "Error terminating instance"));
+        });
 }
 
-std::string EC2Manager::GetInstanceState(const std::string& instanceId) {
+std::future<bool> EC2Manager::TerminateInstanceAsync(const std::string& instanceId) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        TerminateInstanceAsync(instanceId, std::move(done));
+    });
+}
+
+void EC2Manager::DescribeInstancesAsync(const std::vector<std::string>& instanceIds,
+                                        InstancesCallback callback) {
     Aws::EC2::Model::DescribeInstancesRequest request;
-    
-    Aws::EC2::Model::Filter filter;
-    filter.SetName("instance-id");
-    filter.AddValues(instanceId);
-    request.AddFilters(filter);
-    
-    auto outcome = ec2Client.DescribeInstances(request);
-    
-    if (outcome.IsSuccess()) {
-        const auto& reservations = outcome.GetResult().GetReservations();
-        
-        if (!reservations.empty() && !reservations[0].GetInstances().empty()) {
-            const auto& instance = reservations[0].GetInstances()[0];
-            return Aws::EC2::Model::InstanceStateNameMapper::GetNameForInstanceStateName(
-                instance.GetState().GetName());
-        } else {
-            std::cerr << "Could not find instance: " << instanceId << std::endl;
-            return "";
-        }
-    } else {
-        std::cerr << "Error getting instance state: " << outcome.GetError().GetMessage() << std::endl;
-        return "";
+    for (const auto& instanceId : instanceIds) {
+        request.AddInstanceIds(instanceId);
     }
+    
+    DescribeInstancesPage(ec2Client, retryController, request, std::make_shared<InstancesResult>(),
+                          std::move(callback));
+}
+
+std::future<InstancesResult> EC2Manager::DescribeInstancesAsync(const std::vector<std::string>& instanceIds) {
+    return detail::ToFuture<InstancesResult>([&](InstancesCallback done) {
+        DescribeInstancesAsync(instanceIds, std::move(done));
+    });
 }
 
 bool EC2Manager::WaitForInstanceState(
@@ -169,29 +592,72 @@ bool EC2Manager::WaitForInstanceState(
     const std::string& targetState, 
     int maxWaitSeconds) {
     
-    int waitTimeSeconds = 0;
-    bool instanceInTargetState = false;
+    WaitOptions options;
+    options.timeout = std::chrono::seconds(maxWaitSeconds);
+    return WaitForInstanceStateAsync(instanceId, targetState, options).get();
+}
+
+bool EC2Manager::WaitForInstancesState(
+    const std::vector<std::string>& instanceIds,
+    const std::string& targetState,
+    int maxWaitSeconds) {
     
-    while (!instanceInTargetState && waitTimeSeconds < maxWaitSeconds) {
-        std::string state = GetInstanceState(instanceId);
-        
-        if (state == targetState) {
-            instanceInTargetState = true;
-            break;
-        } else if (state.empty()) {
-            // Error occurred
-            return false;
-        }
-        
-        std::cout << "Instance " << instanceId << " state: " << state 
-                  << " (waiting for " << targetState << ")" << std::endl;
-        
-        // Wait before checking again
-        std::this_thread::sleep_for(std::chrono::seconds(10));
-        waitTimeSeconds += 10;
+    WaitOptions options;
+    options.timeout = std::chrono::seconds(maxWaitSeconds);
+    return WaitForInstancesStateAsync(instanceIds, targetState, options).get();
+}
+
+void EC2Manager::WaitForInstanceStateAsync(const std::string& instanceId,
+                                           const std::string& targetState,
+                                           const WaitOptions& options,
+                                           CompletionCallback callback) {
+    instanceWaiter->Wait(instanceId, targetState, options, std::move(callback));
+}
+
+std::future<bool> EC2Manager::WaitForInstanceStateAsync(const std::string& instanceId,
+                                                        const std::string& targetState,
+                                                        const WaitOptions& options) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        WaitForInstanceStateAsync(instanceId, targetState, options, std::move(done));
+    });
+}
+
+void EC2Manager::WaitForInstancesStateAsync(const std::vector<std::string>& instanceIds,
+                                            const std::string& targetState,
+                                            const WaitOptions& options,
+                                            CompletionCallback callback) {
+    if (instanceIds.empty()) {
+        callback(true);
+        return;
     }
     
-    return instanceInTargetState;
+    struct Progress {
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> allSucceeded{true};
+        CompletionCallback callback;
+    };
+    auto progress = std::make_shared<Progress>();
+    progress->remaining = instanceIds.size();
+    progress->callback = std::move(callback);
+    
+    for (const auto& instanceId : instanceIds) {
+        instanceWaiter->Wait(instanceId, targetState, options, [progress](bool success) {
+            if (!success) {
+                progress->allSucceeded = false;
+            }
+            if (--progress->remaining == 0) {
+                progress->callback(progress->allSucceeded.load());
+            }
+        });
+    }
+}
+
+std::future<bool> EC2Manager::WaitForInstancesStateAsync(const std::vector<std::string>& instanceIds,
+                                                         const std::string& targetState,
+                                                         const WaitOptions& options) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        WaitForInstancesStateAsync(instanceIds, targetState, options, std::move(done));
+    });
 }
 
 } // namespace awsexamples
@@ -0,0 +1,190 @@
+/**
+ * @file FleetSnapshot.cpp
+ * @brief Implementation of the StringPool and FleetSnapshot classes
+ */
+
+#include "awsexamples/FleetSnapshot.h"
+#include <limits>
+
+namespace awsexamples {
+
+namespace {
+
+// Marks a filter field that matches any value
+constexpr StringPool::Id kAny = std::numeric_limits<StringPool::Id>::max();
+
+// Resolve a filter field to an interned ID; false if no row can match it
+bool ResolveCriterion(const StringPool& strings, const std::string& value, StringPool::Id& id) {
+    if (value.empty()) {
+        id = kAny;
+        return true;
+    }
+    return strings.Find(value, id);
+}
+
+}  // namespace
+
+StringPool::Id StringPool::Intern(std::string_view value) {
+    auto existing = ids.find(value);
+    if (existing != ids.end()) {
+        return existing->second;
+    }
+
+    Id id = static_cast<Id>(strings.size());
+    strings.emplace_back(value);
+    ids.emplace(strings.back(), id);
+    return id;
+}
+
+bool StringPool::Find(std::string_view value, Id& id) const {
+    auto existing = ids.find(value);
+    if (existing == ids.end()) {
+        return false;
+    }
+    id = existing->second;
+    return true;
+}
+
+void FleetSnapshot::Add(const Aws::EC2::Model::Instance& instance, const std::string& region) {
+    std::vector<std::pair<Id, Id>> tags;
+    tags.reserve(instance.GetTags().size());
+    for (const auto& tag : instance.GetTags()) {
+        tags.emplace_back(strings.Intern(tag.GetKey()), strings.Intern(tag.GetValue()));
+    }
+
+    AddRow(instance.GetInstanceId(),
+           strings.Intern(Aws::EC2::Model::InstanceStateNameMapper::GetNameForInstanceStateName(
+               instance.GetState().GetName())),
+           strings.Intern(Aws::EC2::Model::InstanceTypeMapper::GetNameForInstanceType(instance.GetInstanceType())),
+           strings.Intern(region),
+           instance.GetLaunchTime().Millis(),
+           tags);
+}
+
+void FleetSnapshot::Append(const FleetSnapshot& other) {
+    Reserve(Size() + other.Size());
+
+    // Map the other snapshot's string IDs to this one's as they are needed
+    std::vector<Id> translated(other.strings.Size(), kAny);
+    auto translate = [&](Id id) {
+        if (translated[id] == kAny) {
+            translated[id] = strings.Intern(other.strings.Get(id));
+        }
+        return translated[id];
+    };
+
+    std::vector<std::pair<Id, Id>> tags;
+    for (std::size_t row = 0; row < other.Size(); ++row) {
+        tags.clear();
+        auto range = other.Tags(row);
+        for (auto i = range.first; i < range.second; ++i) {
+            tags.emplace_back(translate(other.tagPairs[i].first), translate(other.tagPairs[i].second));
+        }
+        AddRow(other.instanceIds[row],
+               translate(other.states[row]),
+               translate(other.types[row]),
+               translate(other.regions[row]),
+               other.launchTimes[row],
+               tags);
+    }
+}
+
+void FleetSnapshot::Reserve(std::size_t rows) {
+    instanceIds.reserve(rows);
+    states.reserve(rows);
+    types.reserve(rows);
+    regions.reserve(rows);
+    launchTimes.reserve(rows);
+    tagOffsets.reserve(rows + 1);
+    rowsById.reserve(rows);
+}
+
+bool FleetSnapshot::Find(const std::string& instanceId, std::size_t& row) const {
+    auto found = rowsById.find(instanceId);
+    if (found == rowsById.end()) {
+        return false;
+    }
+    row = found->second;
+    return true;
+}
+
+std::vector<std::size_t> FleetSnapshot::Select(const FleetFilter& filter) const {
+    std::vector<std::size_t> rows;
+
+    // A value that was never interned cannot match any row
+    Id state, type, region, tagKey, tagValue;
+    if (!ResolveCriterion(strings, filter.state, state) ||
+        !ResolveCriterion(strings, filter.instanceType, type) ||
+        !ResolveCriterion(strings, filter.region, region) ||
+        !ResolveCriterion(strings, filter.tagKey, tagKey) ||
+        !ResolveCriterion(strings, filter.tagValue, tagValue)) {
+        return rows;
+    }
+
+    for (std::size_t row = 0; row < Size(); ++row) {
+        if ((state != kAny && states[row] != state) ||
+            (type != kAny && types[row] != type) ||
+            (region != kAny && regions[row] != region)) {
+            continue;
+        }
+
+        if (tagKey != kAny) {
+            bool tagged = false;
+            auto range = Tags(row);
+            for (auto i = range.first; i < range.second && !tagged; ++i) {
+                tagged = tagPairs[i].first == tagKey && (tagValue == kAny || tagPairs[i].second == tagValue);
+            }
+            if (!tagged) {
+                continue;
+            }
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+bool FleetSnapshot::GetTag(std::size_t row, const std::string& key, std::string& value) const {
+    Id keyId;
+    if (!strings.Find(key, keyId)) {
+        return false;
+    }
+
+    auto range = Tags(row);
+    for (auto i = range.first; i < range.second; ++i) {
+        if (tagPairs[i].first == keyId) {
+            value = strings.Get(tagPairs[i].second);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::pair<std::string, std::string>> FleetSnapshot::GetTags(std::size_t row) const {
+    std::vector<std::pair<std::string, std::string>> tags;
+    auto range = Tags(row);
+    for (auto i = range.first; i < range.second; ++i) {
+        tags.emplace_back(strings.Get(tagPairs[i].first), strings.Get(tagPairs[i].second));
+    }
+    return tags;
+}
+
+void FleetSnapshot::AddRow(const std::string& instanceId,
+                           Id state,
+                           Id type,
+                           Id region,
+                           std::int64_t launchTime,
+                           const std::vector<std::pair<Id, Id>>& tags) {
+    if (!rowsById.emplace(instanceId, Size()).second) {
+        return;
+    }
+
+    instanceIds.push_back(instanceId);
+    states.push_back(state);
+    types.push_back(type);
+    regions.push_back(region);
+    launchTimes.push_back(launchTime);
+    tagPairs.insert(tagPairs.end(), tags.begin(), tags.end());
+    tagOffsets.push_back(tagPairs.size());
+}
+
+}  // namespace awsexamples
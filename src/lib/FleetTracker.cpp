@@ -0,0 +1,54 @@
+/**
+ * @file FleetTracker.cpp
+ * @brief Implementation of the FleetTracker class
+ */
+
+#include "awsexamples/FleetTracker.h"
+#include <utility>
+
+namespace awsexamples {
+
+FleetTracker::FleetTracker(EC2Manager& manager)
+    : describe([&manager](FleetSnapshot& next) { return manager.DescribeFleet(next).success; }) {}
+
+FleetTracker::FleetTracker(std::vector<std::string> regions, Aws::Client::ClientConfiguration config)
+    : describe([regions = std::move(regions), config = std::move(config)](FleetSnapshot& next) {
+          return EC2Manager::DescribeFleet(regions, config, next).success;
+      }) {}
+
+bool FleetTracker::Refresh(FleetDiff& diff) {
+    diff = FleetDiff();
+
+    FleetSnapshot next;
+    next.Reserve(snapshot.Size());
+    if (!describe(next)) {
+        return false;
+    }
+
+    Diff(snapshot, next, diff);
+    snapshot = std::move(next);
+    return true;
+}
+
+void FleetTracker::Diff(const FleetSnapshot& previous, const FleetSnapshot& current, FleetDiff& diff) {
+    diff = FleetDiff();
+
+    std::size_t previousRow = 0;
+    for (std::size_t row = 0; row < current.Size(); ++row) {
+        const std::string& instanceId = current.InstanceId(row);
+        if (!previous.Find(instanceId, previousRow)) {
+            diff.added.push_back(instanceId);
+        } else if (previous.State(previousRow) != current.State(row)) {
+            diff.stateChanged.push_back({instanceId, previous.State(previousRow), current.State(row)});
+        }
+    }
+
+    std::size_t currentRow = 0;
+    for (std::size_t row = 0; row < previous.Size(); ++row) {
+        if (!current.Find(previous.InstanceId(row), currentRow)) {
+            diff.removed.push_back(previous.InstanceId(row));
+        }
+    }
+}
+
+}  // namespace awsexamples
@@ -0,0 +1,113 @@
+/**
+ * @file GetItemCoalescer.cpp
+ * @brief Implementation of the GetItemCoalescer class
+ */
+
+#include "awsexamples/GetItemCoalescer.h"
+#include "AsyncSupport.h"
+#include <algorithm>
+
+namespace awsexamples {
+
+GetItemCoalescer::GetItemCoalescer(DynamoDBManager& manager,
+                                   const std::string& tableName,
+                                   const CoalescerOptions& options)
+    : manager(manager), tableName(tableName), options(options) {
+    this->options.maxBatchSize = std::max<std::size_t>(options.maxBatchSize, 1);
+    unsigned workerCount = std::max(options.maxInFlight, 1U);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&GetItemCoalescer::WorkerLoop, this);
+    }
+}
+
+GetItemCoalescer::~GetItemCoalescer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pendingChanged.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void GetItemCoalescer::Get(const std::string& id, GetItemCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.lookups;
+        if (pending.empty()) {
+            windowEnd = std::chrono::steady_clock::now() + options.window;
+        }
+        pending[id].push_back(std::move(callback));
+    }
+    pendingChanged.notify_all();
+}
+
+std::future<GetItemResult> GetItemCoalescer::Get(const std::string& id) {
+    return detail::ToFuture<GetItemResult>([&](GetItemCallback done) {
+        Get(id, std::move(done));
+    });
+}
+
+CoalescerStats GetItemCoalescer::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void GetItemCoalescer::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        pendingChanged.wait(lock, [this]() { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return;
+        }
+
+        // Hold the batch open for later lookups; a stopping coalescer sends at once
+        while (!stopping && !pending.empty() && pending.size() < options.maxBatchSize &&
+               std::chrono::steady_clock::now() < windowEnd) {
+            pendingChanged.wait_until(lock, windowEnd);
+        }
+        if (pending.empty()) {
+            continue;  // Another worker took the batch
+        }
+
+        Batch batch;
+        while (!pending.empty() && batch.size() < options.maxBatchSize) {
+            batch.insert(pending.extract(pending.begin()));
+        }
+        ++stats.batches;
+        stats.keys += batch.size();
+
+        lock.unlock();
+        SendBatch(batch);
+        lock.lock();
+    }
+}
+
+void GetItemCoalescer::SendBatch(const Batch& batch) {
+    std::vector<std::string> ids;
+    ids.reserve(batch.size());
+    for (const auto& lookup : batch) {
+        ids.push_back(lookup.first);
+    }
+
+    ItemMap items;
+    bool complete = manager.GetItems(tableName, ids, items, options.batchOptions).success;
+
+    for (const auto& lookup : batch) {
+        GetItemResult result;
+        auto item = items.find(lookup.first);
+        if (item != items.end()) {
+            result.success = true;
+            result.item = std::move(item->second);
+        } else {
+            // After a partial failure a key without an item may not have been read
+            result.success = complete;
+        }
+        for (const auto& callback : lookup.second) {
+            callback(result);
+        }
+    }
+}
+
+}  // namespace awsexamples
@@ -0,0 +1,179 @@
+/**
+ * @file InstanceStateWaiter.cpp
+ * @brief Implementation of the InstanceStateWaiter class
+ */
+
+#include "InstanceStateWaiter.h"
+#include "awsexamples/Logger.h"
+#include "Backoff.h"
+#include <aws/ec2/model/Filter.h>
+#include <algorithm>
+
+namespace awsexamples {
+namespace detail {
+
+namespace {
+
+// Waits falling due within this window are checked together
+constexpr std::chrono::milliseconds kCoalesceWindow{100};
+
+// States an instance cannot leave for the given target state
+bool IsUnreachable(const std::string& state, const std::string& targetState) {
+    if (state == "terminated") {
+        return true;
+    }
+    return state == "shutting-down" && targetState != "terminated";
+}
+
+}  // namespace
+
+InstanceStateWaiter::InstanceStateWaiter(std::shared_ptr<Aws::EC2::EC2Client> client)
+    : client(std::move(client)) {}
+
+void InstanceStateWaiter::Wait(const std::string& instanceId,
+                               const std::string& targetState,
+                               const WaitOptions& options,
+                               CompletionCallback callback) {
+    Reschedule(std::make_shared<PendingWait>(
+        PendingWait{instanceId, targetState, PollSchedule(options), std::move(callback)}));
+}
+
+void InstanceStateWaiter::Reschedule(const std::shared_ptr<PendingWait>& wait) {
+    std::chrono::milliseconds delay;
+    if (!wait->schedule.NextDelay(delay)) {
+        AWSEXAMPLES_LOG(Error, "Timed out waiting for instance " << wait->instanceId
+                                   << " to reach state " << wait->targetState);
+        wait->callback(false);
+        return;
+    }
+    
+    auto self = shared_from_this();
+    Waiter::Instance().Schedule(delay, [self, wait](bool run) {
+        if (run) {
+            self->Enqueue(wait);
+        } else {
+            wait->callback(false);
+        }
+    });
+}
+
+void InstanceStateWaiter::Enqueue(const std::shared_ptr<PendingWait>& wait) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back(wait);
+        if (pollScheduled) {
+            return;
+        }
+        pollScheduled = true;
+    }
+    
+    auto self = shared_from_this();
+    Waiter::Instance().Schedule(JitteredBackoff(1, kCoalesceWindow, kCoalesceWindow), [self](bool run) {
+        if (run) {
+            self->Poll();
+            return;
+        }
+        Batch cancelled;
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            cancelled.swap(self->queued);
+            self->pollScheduled = false;
+        }
+        for (const auto& wait : cancelled) {
+            wait->callback(false);
+        }
+    });
+}
+
+void InstanceStateWaiter::Poll() {
+    Batch due;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        due.swap(queued);
+        pollScheduled = false;
+    }
+    
+    for (std::size_t begin = 0; begin < due.size(); begin += kMaxInstanceFilterValues) {
+        auto batch = std::make_shared<Batch>(due.begin() + begin,
+                                             due.begin() + std::min(begin + kMaxInstanceFilterValues, due.size()));
+        
+        // Waits on the same instance share a filter value
+        Aws::EC2::Model::Filter filter;
+        filter.SetName("instance-id");
+        std::vector<std::string> instanceIds;
+        for (const auto& wait : *batch) {
+            instanceIds.push_back(wait->instanceId);
+        }
+        std::sort(instanceIds.begin(), instanceIds.end());
+        instanceIds.erase(std::unique(instanceIds.begin(), instanceIds.end()), instanceIds.end());
+        for (const auto& instanceId : instanceIds) {
+            filter.AddValues(instanceId);
+        }
+        
+        Aws::EC2::Model::DescribeInstancesRequest request;
+        request.AddFilters(filter);
+        DescribePage(request, batch, std::make_shared<StateMap>());
+    }
+}
+
+void InstanceStateWaiter::DescribePage(const Aws::EC2::Model::DescribeInstancesRequest& request,
+                                       std::shared_ptr<Batch> batch,
+                                       std::shared_ptr<StateMap> states) {
+    auto self = shared_from_this();
+    client->DescribeInstancesAsync(
+        request,
+        [self, batch, states](const auto*, const auto& sentRequest, const auto& outcome, const auto&) {
+            if (!outcome.IsSuccess()) {
+                AWSEXAMPLES_LOG(Error, "Error getting instance state: " << outcome.GetError().GetMessage());
+                for (const auto& wait : *batch) {
+                    if (outcome.GetError().ShouldRetry()) {
+                        self->Reschedule(wait);
+                    } else {
+                        wait->callback(false);
+                    }
+                }
+                return;
+            }
+            
+            for (const auto& reservation : outcome.GetResult().GetReservations()) {
+                for (const auto& instance : reservation.GetInstances()) {
+                    (*states)[instance.GetInstanceId()] =
+                        Aws::EC2::Model::InstanceStateNameMapper::GetNameForInstanceStateName(
+                            instance.GetState().GetName());
+                }
+            }
+            
+            const auto& nextToken = outcome.GetResult().GetNextToken();
+            if (!nextToken.empty()) {
+                auto nextRequest = sentRequest;
+                nextRequest.SetNextToken(nextToken);
+                self->DescribePage(nextRequest, batch, states);
+                return;
+            }
+            self->Resolve(*batch, *states);
+        });
+}
+
+void InstanceStateWaiter::Resolve(const Batch& batch, const StateMap& states) {
+    for (const auto& wait : batch) {
+        // A just-launched instance may not be visible yet; keep waiting for it
+        auto found = states.find(wait->instanceId);
+        const std::string state = found != states.end() ? found->second : "unknown";
+        
+        if (state == wait->targetState) {
+            AWSEXAMPLES_LOG(Info, "Instance " << wait->instanceId << " reached state " << state);
+            wait->callback(true);
+        } else if (IsUnreachable(state, wait->targetState)) {
+            AWSEXAMPLES_LOG(Error, "Instance " << wait->instanceId << " is " << state
+                                   << " and cannot reach state " << wait->targetState);
+            wait->callback(false);
+        } else {
+            AWSEXAMPLES_LOG(Info, "Instance " << wait->instanceId << " state: " << state
+                                  << " (waiting for " << wait->targetState << ")");
+            Reschedule(wait);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace awsexamples
@@ -0,0 +1,108 @@
+/**
+ * @file InstanceStateWaiter.h
+ * @brief Internal engine that checks many EC2 instance waits with few DescribeInstances calls
+ */
+
+#ifndef AWSEXAMPLES_INSTANCESTATEWAITER_H
+#define AWSEXAMPLES_INSTANCESTATEWAITER_H
+
+#include "awsexamples/AsyncTypes.h"
+#include "awsexamples/Waiter.h"
+#include "PollSchedule.h"
+#include <aws/ec2/EC2Client.h>
+#include <aws/ec2/model/DescribeInstancesRequest.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace awsexamples {
+namespace detail {
+
+/// DescribeInstances accepts at most 200 values per filter
+constexpr std::size_t kMaxInstanceFilterValues = 200;
+
+/**
+ * @class InstanceStateWaiter
+ * @brief Coalesces the checks of all pending instance waits of one manager
+ *
+ * Each wait backs off on its own schedule, but instead of describing its
+ * instance when its delay elapses it joins a batch. A batch is checked after a
+ * short, randomised coalescing window with one DescribeInstances call (filtered
+ * by instance ID) per 200 instances, so waits started together keep sharing
+ * requests, and separate processes do not poll in lockstep.
+ */
+class InstanceStateWaiter : public std::enable_shared_from_this<InstanceStateWaiter> {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param client The client used for DescribeInstances calls
+     */
+    explicit InstanceStateWaiter(std::shared_ptr<Aws::EC2::EC2Client> client);
+
+    /**
+     * @brief Wait for an instance to reach a state
+     *
+     * @param instanceId The ID of the instance to wait for
+     * @param targetState The state to wait for (e.g. "running", "stopped")
+     * @param options Polling schedule and timeout
+     * @param callback Invoked with true once the instance is in the target state, or false
+     *                 on timeout, error or if the instance reaches a state it cannot leave
+     */
+    void Wait(const std::string& instanceId,
+              const std::string& targetState,
+              const WaitOptions& options,
+              CompletionCallback callback);
+
+private:
+    /// One pending wait
+    struct PendingWait {
+        std::string instanceId;     ///< Instance waited for
+        std::string targetState;    ///< State waited for
+        PollSchedule schedule;      ///< Delays between checks
+        CompletionCallback callback; ///< Receives the result
+    };
+
+    using Batch = std::vector<std::shared_ptr<PendingWait>>;
+    using StateMap = std::map<std::string, std::string>;
+
+    /**
+     * @brief Schedule the next check of a wait, or fail it if it timed out
+     */
+    void Reschedule(const std::shared_ptr<PendingWait>& wait);
+
+    /**
+     * @brief Add a wait whose delay has elapsed to the next batch
+     */
+    void Enqueue(const std::shared_ptr<PendingWait>& wait);
+
+    /**
+     * @brief Check all queued waits
+     */
+    void Poll();
+
+    /**
+     * @brief Request one page of instance states for a batch and chain the next
+     */
+    void DescribePage(const Aws::EC2::Model::DescribeInstancesRequest& request,
+                      std::shared_ptr<Batch> batch,
+                      std::shared_ptr<StateMap> states);
+
+    /**
+     * @brief Complete or reschedule the waits of a batch from the states found
+     */
+    void Resolve(const Batch& batch, const StateMap& states);
+
+    std::shared_ptr<Aws::EC2::EC2Client> client; ///< Client used for all checks
+    std::mutex mutex;                            ///< Guards queued and pollScheduled
+    Batch queued;                                ///< Waits due for the next check
+    bool pollScheduled = false;                  ///< Whether a check of queued is scheduled
+};
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_INSTANCESTATEWAITER_H
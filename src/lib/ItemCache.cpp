@@ -0,0 +1,225 @@
+/**
+ * @file ItemCache.cpp
+ * @brief Implementation of the ItemCache class
+ */
+
+#include "awsexamples/ItemCache.h"
+#include <algorithm>
+#include <functional>
+
+namespace awsexamples {
+
+namespace {
+
+// Bookkeeping per cached entry: map node, list node and key copies
+constexpr std::size_t kEntryOverhead = 128;
+
+std::string CacheKey(const std::string& tableName, const std::string& id) {
+    std::string key;
+    key.reserve(tableName.size() + 1 + id.size());
+    key.append(tableName).append(1, '\0').append(id);
+    return key;
+}
+
+std::size_t EstimateSize(const Aws::DynamoDB::Model::AttributeValue& value) {
+    using Aws::DynamoDB::Model::ValueType;
+
+    std::size_t size = sizeof(value);
+    switch (value.GetType()) {
+    case ValueType::STRING:
+        size += value.GetS().size();
+        break;
+    case ValueType::NUMBER:
+        size += value.GetN().size();
+        break;
+    case ValueType::BYTEBUFFER:
+        size += value.GetB().GetLength();
+        break;
+    case ValueType::STRING_SET:
+        for (const auto& member : value.GetSS()) {
+            size += sizeof(member) + member.size();
+        }
+        break;
+    case ValueType::NUMBER_SET:
+        for (const auto& member : value.GetNS()) {
+            size += sizeof(member) + member.size();
+        }
+        break;
+    case ValueType::BYTEBUFFER_SET:
+        for (const auto& member : value.GetBS()) {
+            size += sizeof(member) + member.GetLength();
+        }
+        break;
+    case ValueType::ATTRIBUTE_MAP:
+        for (const auto& member : value.GetM()) {
+            size += member.first.size() + EstimateSize(*member.second);
+        }
+        break;
+    case ValueType::ATTRIBUTE_LIST:
+        for (const auto& member : value.GetL()) {
+            size += EstimateSize(*member);
+        }
+        break;
+    default:
+        break;
+    }
+    return size;
+}
+
+std::size_t EstimateSize(const std::string& key, const AttributeMap& item) {
+    std::size_t size = kEntryOverhead + 2 * key.size();
+    for (const auto& attribute : item) {
+        size += attribute.first.size() + EstimateSize(attribute.second);
+    }
+    return size;
+}
+
+}  // namespace
+
+ItemCache::ItemCache(const ItemCacheOptions& options) : options(options) {
+    unsigned shardCount = std::max(options.shards, 1U);
+    shardBytes = options.maxBytes / shardCount;
+    shards.reserve(shardCount);
+    for (unsigned i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+bool ItemCache::Get(const std::string& tableName, const std::string& id, AttributeMap& item) {
+    std::string key = CacheKey(tableName, id);
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto entry = shard.entries.find(key);
+    if (entry == shard.entries.end()) {
+        ++shard.stats.misses;
+        return false;
+    }
+    if (entry->second.expires <= Clock::now()) {
+        Erase(shard, entry);
+        ++shard.stats.expirations;
+        ++shard.stats.misses;
+        return false;
+    }
+
+    shard.recency.splice(shard.recency.begin(), shard.recency, entry->second.lru);
+    item = entry->second.item;
+    ++shard.stats.hits;
+    return true;
+}
+
+std::uint64_t ItemCache::Generation(const std::string& tableName, const std::string& id) const {
+    Shard& shard = ShardFor(CacheKey(tableName, id));
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.generation;
+}
+
+void ItemCache::Put(const std::string& tableName,
+                    const std::string& id,
+                    const AttributeMap& item,
+                    std::uint64_t generation) {
+    auto ttl = item.empty() ? options.negativeTtl : options.ttl;
+    if (ttl.count() <= 0) {
+        return;
+    }
+
+    std::string key = CacheKey(tableName, id);
+    std::size_t bytes = EstimateSize(key, item);
+    if (bytes > shardBytes) {
+        return;
+    }
+
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // The item may have been written while it was being read
+    if (shard.generation != generation) {
+        return;
+    }
+
+    auto existing = shard.entries.find(key);
+    if (existing != shard.entries.end()) {
+        Erase(shard, existing);
+    }
+
+    // Evict the least recently used entries until the new one fits
+    while (shard.bytes + bytes > shardBytes && !shard.recency.empty()) {
+        Erase(shard, shard.entries.find(shard.recency.back()));
+        ++shard.stats.evictions;
+    }
+
+    shard.recency.push_front(key);
+    Entry& entry = shard.entries[key];
+    entry.item = item;
+    entry.expires = Clock::now() + ttl;
+    entry.bytes = bytes;
+    entry.lru = shard.recency.begin();
+    shard.bytes += bytes;
+}
+
+std::string ItemCache::ItemId(const AttributeMap& item) {
+    using Aws::DynamoDB::Model::ValueType;
+
+    auto id = item.find("id");
+    if (id == item.end()) {
+        return "";
+    }
+    switch (id->second.GetType()) {
+    case ValueType::STRING:
+        return id->second.GetS();
+    case ValueType::NUMBER:
+        return id->second.GetN();
+    default:
+        return "";
+    }
+}
+
+void ItemCache::Invalidate(const std::string& tableName, const std::string& id) {
+    std::string key = CacheKey(tableName, id);
+    Shard& shard = ShardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    ++shard.generation;
+    auto entry = shard.entries.find(key);
+    if (entry != shard.entries.end()) {
+        Erase(shard, entry);
+        ++shard.stats.invalidations;
+    }
+}
+
+void ItemCache::Clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        ++shard->generation;
+        shard->entries.clear();
+        shard->recency.clear();
+        shard->bytes = 0;
+    }
+}
+
+ItemCacheStats ItemCache::GetStats() const {
+    ItemCacheStats total;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total.hits += shard->stats.hits;
+        total.misses += shard->stats.misses;
+        total.evictions += shard->stats.evictions;
+        total.expirations += shard->stats.expirations;
+        total.invalidations += shard->stats.invalidations;
+        total.entries += shard->entries.size();
+        total.bytes += shard->bytes;
+    }
+    return total;
+}
+
+ItemCache::Shard& ItemCache::ShardFor(const std::string& key) const {
+    return *shards[std::hash<std::string>()(key) % shards.size()];
+}
+
+void ItemCache::Erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator entry) {
+    shard.bytes -= entry->second.bytes;
+    shard.recency.erase(entry->second.lru);
+    shard.entries.erase(entry);
+}
+
+}  // namespace awsexamples
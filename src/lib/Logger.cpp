@@ -0,0 +1,103 @@
+/**
+ * @file Logger.cpp
+ * @brief Implementation of the Logger class
+ */
+
+#include "awsexamples/Logger.h"
+#include <iostream>
+#include <utility>
+
+namespace awsexamples {
+namespace utils {
+
+namespace {
+
+// Messages held for the writer before new ones are dropped
+constexpr std::size_t kMaxQueued = 64 * 1024;
+
+}  // namespace
+
+Logger& Logger::Instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : threshold(static_cast<int>(LogLevel::Info)) {}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void Logger::SetSink(LogSink newSink) {
+    Flush();
+    std::lock_guard<std::mutex> lock(mutex);
+    sink = std::move(newSink);
+}
+
+void Logger::Write(LogLevel level, std::string message) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= kMaxQueued) {
+            ++dropped;
+            return;
+        }
+        queue.push_back({level, std::move(message)});
+        if (!writer.joinable()) {
+            writer = std::thread(&Logger::WriterLoop, this);
+        }
+    }
+    queueChanged.notify_all();
+}
+
+void Logger::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    queueChanged.wait(lock, [this]() { return (queue.empty() && !writing) || !writer.joinable(); });
+}
+
+std::uint64_t Logger::GetDropped() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+void Logger::WriterLoop() {
+    std::deque<Entry> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        queueChanged.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+
+        batch.swap(queue);
+        writing = true;
+        LogSink currentSink = sink;
+        lock.unlock();
+
+        // One flush per batch instead of one per message
+        for (const auto& entry : batch) {
+            if (currentSink) {
+                currentSink(entry.level, entry.message);
+            } else if (static_cast<int>(entry.level) >= static_cast<int>(LogLevel::Info)) {
+                std::cout << entry.message << '\n';
+            } else {
+                std::cerr << entry.message << '\n';
+            }
+        }
+        std::cout.flush();
+        batch.clear();
+
+        lock.lock();
+        writing = false;
+        queueChanged.notify_all();
+    }
+}
+
+}  // namespace utils
+}  // namespace awsexamples
@@ -0,0 +1,101 @@
+/**
+ * @file MemoryStream.cpp
+ * @brief Implementation of the zero-copy memory and mapped-file streams
+ */
+
+#include "awsexamples/MemoryStream.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace awsexamples {
+
+MappedFile::MappedFile(const std::string& filePath) {
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat fileInfo {};
+    if (::fstat(fd, &fileInfo) == 0 && S_ISREG(fileInfo.st_mode)) {
+        size = static_cast<std::size_t>(fileInfo.st_size);
+        if (size == 0) {
+            open = true;  // mmap rejects zero-length mappings; an empty view is still valid
+        } else {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                // Uploads read front to back, so let the kernel read ahead aggressively
+                ::madvise(mapping, size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(mapping);
+                open = true;
+            }
+        }
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+}
+
+MemoryViewStreamBuf::MemoryViewStreamBuf(const char* data, std::size_t size) {
+    // The get area is never written through; the const_cast only satisfies the streambuf interface
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+}
+
+std::streamsize MemoryViewStreamBuf::showmanyc() {
+    return egptr() - gptr();
+}
+
+MemoryViewStreamBuf::pos_type MemoryViewStreamBuf::seekoff(off_type offset,
+                                                           std::ios_base::seekdir direction,
+                                                           std::ios_base::openmode which) {
+    if ((which & std::ios_base::in) == 0) {
+        return pos_type(off_type(-1));
+    }
+
+    off_type base = 0;
+    if (direction == std::ios_base::cur) {
+        base = gptr() - eback();
+    } else if (direction == std::ios_base::end) {
+        base = egptr() - eback();
+    }
+
+    off_type target = base + offset;
+    if (target < 0 || target > egptr() - eback()) {
+        return pos_type(off_type(-1));
+    }
+    setg(eback(), eback() + target, egptr());
+    return pos_type(target);
+}
+
+MemoryViewStreamBuf::pos_type MemoryViewStreamBuf::seekpos(pos_type position,
+                                                           std::ios_base::openmode which) {
+    return seekoff(off_type(position), std::ios_base::beg, which);
+}
+
+MemoryViewStream::MemoryViewStream(const char* data, std::size_t size)
+    : Aws::IOStream(nullptr), size(size), buffer(data, size) {
+    rdbuf(&buffer);
+}
+
+MemoryViewStream::MemoryViewStream(std::shared_ptr<const MappedFile> file,
+                                   std::size_t offset,
+                                   std::size_t length)
+    : Aws::IOStream(nullptr),
+      file(std::move(file)),
+      size(length),
+      buffer(this->file->Data() + offset, length) {
+    rdbuf(&buffer);
+}
+
+MemoryViewStream::MemoryViewStream(std::shared_ptr<const MappedFile> file)
+    : MemoryViewStream(file, 0, file->Size()) {}
+
+}  // namespace awsexamples
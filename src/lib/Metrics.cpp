@@ -0,0 +1,320 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the LatencyHistogram and MetricsRegistry classes
+ */
+
+#include "awsexamples/Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace awsexamples {
+namespace utils {
+
+namespace {
+
+// Quantiles written for each operation's latency summary
+constexpr double kExportedQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+constexpr std::uint64_t kMaxTrackedValue = (std::uint64_t{1} << LatencyHistogram::kMaxValueBits) - 1;
+
+int HighestBit(std::uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) {
+        ++bit;
+    }
+    return bit;
+}
+
+// Add to a counter only the calling thread writes: a plain load and store
+// instead of a locked read-modify-write
+void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void WriteSeconds(std::ostream& out, std::uint64_t micros) {
+    out << static_cast<double>(micros) / 1e6;
+}
+
+}  // namespace
+
+std::size_t LatencyHistogram::BucketOf(std::uint64_t value) {
+    value = std::min(value, kMaxTrackedValue);
+    if (value < 2 * kSubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+    const int exponent = HighestBit(value);
+    const int shift = exponent - kSubBucketBits;
+    const auto subBucket = static_cast<std::size_t>(value >> shift) - kSubBucketCount;
+    return 2 * kSubBucketCount + static_cast<std::size_t>(exponent - kSubBucketBits - 1) * kSubBucketCount + subBucket;
+}
+
+std::uint64_t LatencyHistogram::BucketUpperBound(std::size_t bucket) {
+    if (bucket < 2 * kSubBucketCount) {
+        return bucket;
+    }
+    const std::size_t octave = (bucket - 2 * kSubBucketCount) / kSubBucketCount;
+    const std::size_t subBucket = (bucket - 2 * kSubBucketCount) % kSubBucketCount;
+    const int shift = static_cast<int>(octave) + 1;
+    return ((kSubBucketCount + subBucket) << shift) + (std::uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::Record(std::uint64_t value, std::uint64_t occurrences) {
+    counts[BucketOf(value)] += occurrences;
+    count += occurrences;
+    sum += value * occurrences;
+    max = std::max(max, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        counts[bucket] += other.counts[bucket];
+    }
+    count += other.count;
+    sum += other.sum;
+    max = std::max(max, other.max);
+}
+
+std::uint64_t LatencyHistogram::ValueAtQuantile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(std::min(std::max(quantile, 0.0), 1.0) * static_cast<double>(count))));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::min(BucketUpperBound(bucket), max);
+        }
+    }
+    return max;
+}
+
+const char* ErrorClassName(ErrorClass errorClass) {
+    switch (errorClass) {
+        case ErrorClass::None:
+            return "none";
+        case ErrorClass::Throttling:
+            return "throttling";
+        case ErrorClass::Client:
+            return "client";
+        case ErrorClass::Server:
+            return "server";
+        case ErrorClass::Network:
+            return "network";
+    }
+    return "unknown";
+}
+
+/// Counters of one operation written by one thread
+struct MetricsRegistry::Slot {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> latencySum{0};
+    std::atomic<std::uint64_t> latencyMax{0};
+    std::array<std::atomic<std::uint64_t>, kErrorClassCount> errors{};
+    std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> buckets{};
+};
+
+/// Counters of every operation written by one thread at a time
+struct MetricsRegistry::Shard {
+    std::array<std::atomic<Slot*>, kMaxOperations> slots{};
+
+    ~Shard() {
+        for (auto& slot : slots) {
+            delete slot.load();
+        }
+    }
+};
+
+/// Holds the calling thread's shard and gives it back when the thread exits
+struct ShardLease {
+    MetricsRegistry::Shard* shard = nullptr;
+    std::unordered_map<std::string, MetricsRegistry::Slot*> slots;  ///< The shard's slots by operation name
+
+    ~ShardLease() {
+        if (shard != nullptr) {
+            MetricsRegistry::Instance().ReleaseShard(shard);
+        }
+    }
+};
+
+MetricsRegistry& MetricsRegistry::Instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::MetricsRegistry() = default;
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+void MetricsRegistry::Record(const std::string& operation, std::chrono::microseconds latency, ErrorClass errorClass) {
+    Slot* slot = IsEnabled() ? LocalSlot(operation) : nullptr;
+    if (slot == nullptr) {
+        return;
+    }
+    const auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+    Bump(slot->calls, 1);
+    Bump(slot->latencySum, micros);
+    if (micros > slot->latencyMax.load(std::memory_order_relaxed)) {
+        slot->latencyMax.store(micros, std::memory_order_relaxed);
+    }
+    Bump(slot->buckets[LatencyHistogram::BucketOf(micros)], 1);
+    if (errorClass != ErrorClass::None) {
+        Bump(slot->errors[static_cast<std::size_t>(errorClass)], 1);
+    }
+}
+
+void MetricsRegistry::AddBytes(const std::string& operation, std::uint64_t bytes) {
+    if (Slot* slot = IsEnabled() ? LocalSlot(operation) : nullptr) {
+        Bump(slot->bytes, bytes);
+    }
+}
+
+MetricsRegistry::Slot* MetricsRegistry::LocalSlot(const std::string& operation) {
+    thread_local ShardLease lease;
+    auto cached = lease.slots.find(operation);
+    if (cached != lease.slots.end()) {
+        return cached->second;
+    }
+
+    const std::size_t id = OperationId(operation);
+    if (id >= kMaxOperations) {
+        return nullptr;
+    }
+    if (lease.shard == nullptr) {
+        lease.shard = AcquireShard();
+    }
+    // A reused shard may already hold the slot; otherwise publish a new one for Snapshot
+    Slot* slot = lease.shard->slots[id].load(std::memory_order_acquire);
+    if (slot == nullptr) {
+        slot = new Slot();
+        lease.shard->slots[id].store(slot, std::memory_order_release);
+    }
+    lease.slots.emplace(operation, slot);
+    return slot;
+}
+
+std::size_t MetricsRegistry::OperationId(const std::string& operation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = ids.find(operation);
+    if (found != ids.end()) {
+        return found->second;
+    }
+    if (names.size() >= kMaxOperations) {
+        return kMaxOperations;
+    }
+    ids.emplace(operation, names.size());
+    names.push_back(operation);
+    return names.size() - 1;
+}
+
+MetricsRegistry::Shard* MetricsRegistry::AcquireShard() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeShards.empty()) {
+        Shard* shard = freeShards.back();
+        freeShards.pop_back();
+        return shard;
+    }
+    shards.push_back(std::make_unique<Shard>());
+    return shards.back().get();
+}
+
+void MetricsRegistry::ReleaseShard(Shard* shard) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeShards.push_back(shard);
+}
+
+std::map<std::string, OperationMetrics> MetricsRegistry::Snapshot() const {
+    std::map<std::string, OperationMetrics> snapshot;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t id = 0; id < names.size(); ++id) {
+        OperationMetrics merged;
+        LatencyHistogram& latency = merged.latency;
+        for (const auto& shard : shards) {
+            const Slot* slot = shard->slots[id].load(std::memory_order_acquire);
+            if (slot == nullptr) {
+                continue;
+            }
+            merged.calls += slot->calls.load(std::memory_order_relaxed);
+            merged.bytes += slot->bytes.load(std::memory_order_relaxed);
+            for (std::size_t errorClass = 0; errorClass < kErrorClassCount; ++errorClass) {
+                merged.errors[errorClass] += slot->errors[errorClass].load(std::memory_order_relaxed);
+            }
+            for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+                const auto count = slot->buckets[bucket].load(std::memory_order_relaxed);
+                latency.counts[bucket] += count;
+                latency.count += count;
+            }
+            latency.sum += slot->latencySum.load(std::memory_order_relaxed);
+            latency.max = std::max(latency.max, slot->latencyMax.load(std::memory_order_relaxed));
+        }
+        snapshot.emplace(names[id], merged);
+    }
+    return snapshot;
+}
+
+void MetricsRegistry::WritePrometheus(std::ostream& out) const {
+    const auto snapshot = Snapshot();
+
+    out << "# HELP awsexamples_calls_total Calls completed, including failed ones\n"
+        << "# TYPE awsexamples_calls_total counter\n";
+    for (const auto& operation : snapshot) {
+        out << "awsexamples_calls_total{operation=\"" << operation.first << "\"} " << operation.second.calls << '\n';
+    }
+
+    out << "# HELP awsexamples_errors_total Failed calls by error class\n"
+        << "# TYPE awsexamples_errors_total counter\n";
+    for (const auto& operation : snapshot) {
+        for (std::size_t errorClass = 1; errorClass < kErrorClassCount; ++errorClass) {
+            if (operation.second.errors[errorClass] > 0) {
+                out << "awsexamples_errors_total{operation=\"" << operation.first << "\",class=\""
+                    << ErrorClassName(static_cast<ErrorClass>(errorClass)) << "\"} "
+                    << operation.second.errors[errorClass] << '\n';
+            }
+        }
+    }
+
+    out << "# HELP awsexamples_bytes_total Payload bytes transferred\n"
+        << "# TYPE awsexamples_bytes_total counter\n";
+    for (const auto& operation : snapshot) {
+        if (operation.second.bytes > 0) {
+            out << "awsexamples_bytes_total{operation=\"" << operation.first << "\"} " << operation.second.bytes
+                << '\n';
+        }
+    }
+
+    out << "# HELP awsexamples_latency_seconds Call latency, including retries and backoff\n"
+        << "# TYPE awsexamples_latency_seconds summary\n";
+    for (const auto& operation : snapshot) {
+        const auto& latency = operation.second.latency;
+        for (double quantile : kExportedQuantiles) {
+            out << "awsexamples_latency_seconds{operation=\"" << operation.first << "\",quantile=\"" << quantile
+                << "\"} ";
+            WriteSeconds(out, latency.ValueAtQuantile(quantile));
+            out << '\n';
+        }
+        out << "awsexamples_latency_seconds_sum{operation=\"" << operation.first << "\"} ";
+        WriteSeconds(out, latency.GetSum());
+        out << "\nawsexamples_latency_seconds_count{operation=\"" << operation.first << "\"} " << latency.GetCount()
+            << '\n';
+    }
+}
+
+bool MetricsRegistry::DumpToFile(const std::string& path) const {
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        WritePrometheus(file);
+        if (!file.flush()) {
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+}  // namespace utils
+}  // namespace awsexamples
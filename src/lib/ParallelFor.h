@@ -0,0 +1,74 @@
+/**
+ * @file ParallelFor.h
+ * @brief Internal helper for running indexed work items on a bounded set of threads
+ */
+
+#ifndef AWSEXAMPLES_PARALLELFOR_H
+#define AWSEXAMPLES_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @brief Run a task for every index in [0, count) using up to @p concurrency threads
+ *
+ * Worker threads pull the next index from a shared counter, so slow items do not
+ * hold back the rest of the batch. Once any task returns false no further indices
+ * are handed out, but tasks that are already running are allowed to finish.
+ *
+ * @param count Number of work items
+ * @param concurrency Maximum number of threads to use (0 is treated as 1)
+ * @param task Callable invoked with each index; returns false on failure
+ * @return bool True if every task returned true, false otherwise
+ */
+inline bool ParallelFor(std::size_t count,
+                        unsigned concurrency,
+                        const std::function<bool(std::size_t)>& task) {
+    if (count == 0) {
+        return true;
+    }
+
+    std::atomic<std::size_t> nextIndex{0};
+    std::atomic<bool> failed{false};
+
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count) {
+                return;
+            }
+            if (!task(index)) {
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::size_t threadCount = std::min<std::size_t>(std::max(concurrency, 1U), count);
+    if (threadCount == 1) {
+        worker();
+        return !failed.load();
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return !failed.load();
+}
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_PARALLELFOR_H
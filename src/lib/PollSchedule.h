@@ -0,0 +1,62 @@
+/**
+ * @file PollSchedule.h
+ * @brief Internal helper tracking the polling schedule of a single wait
+ */
+
+#ifndef AWSEXAMPLES_POLLSCHEDULE_H
+#define AWSEXAMPLES_POLLSCHEDULE_H
+
+#include "awsexamples/Waiter.h"
+#include "Backoff.h"
+#include <algorithm>
+#include <chrono>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @class PollSchedule
+ * @brief Yields the delays between the checks of a wait until its timeout
+ */
+class PollSchedule {
+public:
+    /**
+     * @brief Constructor; the timeout starts counting now
+     *
+     * @param options The schedule to follow
+     */
+    explicit PollSchedule(const WaitOptions& options)
+        : options(options), deadline(std::chrono::steady_clock::now() + options.timeout) {}
+
+    /**
+     * @brief Get the delay before the next check
+     *
+     * Delays grow exponentially with equal jitter: half of each delay is fixed and
+     * the rest random, so waits that start together do not poll in lockstep. The
+     * last delay is shortened so that a final check is made at the deadline.
+     *
+     * @param delay Receives the delay
+     * @return bool False if the timeout has passed and no further check should be made
+     */
+    bool NextDelay(std::chrono::milliseconds& delay) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        auto backoff = ExponentialDelay(++attempt, options.initialDelay, options.maxDelay);
+        auto jittered = backoff / 2 + JitteredBackoff(1, backoff - backoff / 2, backoff - backoff / 2);
+        delay = std::min(remaining, jittered);
+        return true;
+    }
+
+private:
+    WaitOptions options;                              ///< Delays and timeout
+    std::chrono::steady_clock::time_point deadline;   ///< When the wait times out
+    int attempt = 0;                                  ///< Number of delays handed out
+};
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_POLLSCHEDULE_H
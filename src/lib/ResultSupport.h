@@ -0,0 +1,152 @@
+/**
+ * @file ResultSupport.h
+ * @brief Internal helpers building OperationResults from SDK outcomes
+ */
+
+#ifndef AWSEXAMPLES_RESULTSUPPORT_H
+#define AWSEXAMPLES_RESULTSUPPORT_H
+
+#include "awsexamples/Logger.h"
+#include "awsexamples/OperationResult.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @class ResultTimer
+ * @brief Measures an operation from construction and stamps its result
+ */
+class ResultTimer {
+public:
+    ResultTimer() : start(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Build a successful result
+     */
+    OperationResult Succeeded() const {
+        OperationResult result;
+        result.success = true;
+        return Stamp(result);
+    }
+
+    /**
+     * @brief Build a failed result
+     *
+     * @param errorType SDK exception name or one of awsexamples::errors
+     * @param message Error message
+     * @param retryable Whether the same call may succeed later
+     */
+    OperationResult Failed(std::string errorType, std::string message, bool retryable = false) const {
+        OperationResult result;
+        result.errorType = std::move(errorType);
+        result.message = std::move(message);
+        result.retryable = retryable;
+        return Stamp(result);
+    }
+
+    /**
+     * @brief Build a result from an SDK outcome
+     */
+    template <typename Outcome>
+    OperationResult From(const Outcome& outcome) const {
+        if (outcome.IsSuccess()) {
+            return Succeeded();
+        }
+        const auto& error = outcome.GetError();
+        return Failed(error.GetExceptionName(), error.GetMessage(), error.ShouldRetry());
+    }
+
+    /**
+     * @brief Set a result's latency to the time elapsed so far
+     */
+    OperationResult Stamp(OperationResult result) const {
+        result.latency =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        return result;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;  ///< When the operation began
+};
+
+/**
+ * @class FirstFailure
+ * @brief Keeps the first error reported by the parts of an operation
+ *
+ * Thread-safe, for operations whose requests run on several threads.
+ */
+class FirstFailure {
+public:
+    /**
+     * @brief Record an error unless one was recorded already
+     */
+    void Record(std::string errorType, std::string message, bool retryable = false) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed) {
+            failed = true;
+            first.errorType = std::move(errorType);
+            first.message = std::move(message);
+            first.retryable = retryable;
+        }
+    }
+
+    /**
+     * @brief Record the error of a failed SDK outcome
+     */
+    template <typename Outcome>
+    void Record(const Outcome& outcome) {
+        const auto& error = outcome.GetError();
+        Record(error.GetExceptionName(), error.GetMessage(), error.ShouldRetry());
+    }
+
+    /**
+     * @brief Build the operation's result: the first error, or success if there was none
+     */
+    OperationResult Result(const ResultTimer& timer) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return failed ? timer.Failed(first.errorType, first.message, first.retryable) : timer.Succeeded();
+    }
+
+private:
+    mutable std::mutex mutex;  ///< Guards the members below
+    bool failed = false;       ///< Whether an error was recorded
+    OperationResult first;     ///< The first error recorded
+};
+
+/**
+ * @brief Log the outcome of a request the same way for blocking and asynchronous calls
+ *
+ * @param outcome The SDK outcome
+ * @param successMessage Logged at Info level on success
+ * @param errorLabel Prefixes the error message, logged at Error level on failure
+ * @return bool True if the request succeeded, false otherwise
+ */
+template <typename Outcome, typename Message>
+bool ReportOutcome(const Outcome& outcome, const Message& successMessage, const char* errorLabel) {
+    if (outcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Info, successMessage);
+        return true;
+    }
+    AWSEXAMPLES_LOG(Error, errorLabel << ": " << outcome.GetError().GetMessage());
+    return false;
+}
+
+/**
+ * @brief Log the outcome of a blocking request and describe it to the caller
+ */
+template <typename Outcome, typename Message>
+OperationResult ReportResult(const ResultTimer& timer,
+                             const Outcome& outcome,
+                             const Message& successMessage,
+                             const char* errorLabel) {
+    ReportOutcome(outcome, successMessage, errorLabel);
+    return timer.From(outcome);
+}
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_RESULTSUPPORT_H
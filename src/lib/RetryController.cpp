@@ -0,0 +1,219 @@
+/**
+ * @file RetryController.cpp
+ * @brief Implementation of the RetryController class
+ */
+
+#include "awsexamples/RetryController.h"
+#include "Backoff.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+
+namespace awsexamples {
+namespace utils {
+
+namespace {
+
+// Attempts are counted over windows of this length to measure the sending rate
+constexpr double kMeasureWindowSeconds = 1.0;
+
+// Weight of the latest window in the smoothed sending rate
+constexpr double kMeasureSmoothing = 0.2;
+
+double Seconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
+RetryController::RetryController(const RetryOptions& options) : options(options), budget(options.retryBudget) {}
+
+std::shared_ptr<RetryController> RetryController::ForService(const std::string& service) {
+    static std::mutex servicesMutex;
+    static std::map<std::string, std::shared_ptr<RetryController>> services;
+
+    std::lock_guard<std::mutex> lock(servicesMutex);
+    auto& controller = services[service];
+    if (!controller) {
+        controller = std::make_shared<RetryController>();
+    }
+    return controller;
+}
+
+bool RetryController::IsThrottlingError(const std::string& exceptionName, int httpStatus) {
+    static const std::set<std::string> throttlingErrors = {
+        "Throttling",
+        "ThrottlingException",
+        "ThrottledException",
+        "RequestThrottled",
+        "RequestThrottledException",
+        "TooManyRequestsException",
+        "ProvisionedThroughputExceededException",
+        "RequestLimitExceeded",
+        "RequestLimitExceededException",
+        "BandwidthLimitExceeded",
+        "LimitExceededException",
+        "SlowDown",
+        "EC2ThrottledException",
+        "PriorRequestNotComplete",
+    };
+
+    // Some services qualify the name, e.g. "com.amazonaws.dynamodb.v20120810#ThrottlingException"
+    auto separator = exceptionName.rfind('#');
+    std::string name = separator == std::string::npos ? exceptionName : exceptionName.substr(separator + 1);
+    return httpStatus == 429 || throttlingErrors.count(name) > 0;
+}
+
+std::chrono::milliseconds RetryController::Admit(const std::string& operation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    OperationState& state = State(operation);
+    auto now = Clock::now();
+
+    ++state.counters.attempts;
+    ++state.windowAttempts;
+    double windowSeconds = Seconds(now - state.windowStart);
+    if (windowSeconds >= kMeasureWindowSeconds) {
+        double sample = state.windowAttempts / windowSeconds;
+        state.measuredRate = state.measuredRate == 0
+            ? sample
+            : (1 - kMeasureSmoothing) * state.measuredRate + kMeasureSmoothing * sample;
+        state.windowStart = now;
+        state.windowAttempts = 0;
+    }
+
+    if (!state.limited) {
+        return std::chrono::milliseconds(0);
+    }
+
+    // Refill, allowing a burst of at most one second's worth of calls
+    state.tokens = std::min(std::max(1.0, state.rate), state.tokens + state.rate * Seconds(now - state.lastRefill));
+    state.lastRefill = now;
+    state.tokens -= 1;
+    if (state.tokens >= 0) {
+        return std::chrono::milliseconds(0);
+    }
+
+    auto delay = std::chrono::milliseconds(static_cast<long long>(std::ceil(-state.tokens / state.rate * 1000)));
+    state.counters.admissionDelayMs += delay.count();
+    return delay;
+}
+
+void RetryController::OnCall(const std::string& operation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++State(operation).counters.calls;
+}
+
+void RetryController::OnSuccess(const std::string& operation, int attempt) {
+    std::lock_guard<std::mutex> lock(mutex);
+    OperationState& state = State(operation);
+    auto now = Clock::now();
+
+    ++state.counters.successes;
+    budget = std::min(options.retryBudget, budget + (attempt == 1 ? options.successRefund : options.retryCost));
+
+    if (state.limited) {
+        // Probe upwards while calls succeed, but never far beyond what is actually sent
+        double grown = state.rate * (1 + options.growthPerSecond * Seconds(now - state.lastGrowth));
+        state.rate = std::max(options.minRate, std::min(grown, std::max(state.rate, 2 * state.measuredRate)));
+        state.lastGrowth = now;
+        state.counters.admissionRate = state.rate;
+    }
+}
+
+bool RetryController::OnFailure(const std::string& operation,
+                                int attempt,
+                                bool throttled,
+                                bool retryable,
+                                std::chrono::milliseconds& delay) {
+    std::lock_guard<std::mutex> lock(mutex);
+    OperationState& state = State(operation);
+    auto now = Clock::now();
+
+    if (throttled) {
+        Throttle(state, now);
+    }
+
+    if ((!retryable && !throttled) || attempt >= options.maxAttempts) {
+        ++state.counters.failures;
+        return false;
+    }
+
+    double cost = throttled ? options.throttleRetryCost : options.retryCost;
+    if (budget < cost) {
+        ++state.counters.retriesDenied;
+        ++state.counters.failures;
+        return false;
+    }
+
+    budget -= cost;
+    ++state.counters.retries;
+    delay = detail::JitteredBackoff(attempt, throttled ? options.throttleBaseDelay : options.baseDelay, options.maxDelay);
+    return true;
+}
+
+void RetryController::OnThrottled(const std::string& operation) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Throttle(State(operation), Clock::now());
+}
+
+std::map<std::string, OperationCounters> RetryController::GetCounters() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::string, OperationCounters> counters;
+    for (const auto& operation : operations) {
+        counters[operation.first] = operation.second.counters;
+    }
+    return counters;
+}
+
+double RetryController::GetRetryBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return budget;
+}
+
+void RetryController::PrintCounters() const {
+    for (const auto& operation : GetCounters()) {
+        const OperationCounters& counters = operation.second;
+        std::cout << operation.first
+                  << ": calls=" << counters.calls
+                  << " attempts=" << counters.attempts
+                  << " successes=" << counters.successes
+                  << " failures=" << counters.failures
+                  << " throttled=" << counters.throttled
+                  << " retries=" << counters.retries
+                  << " retries_denied=" << counters.retriesDenied
+                  << " admission_delay_ms=" << counters.admissionDelayMs
+                  << " admission_rate=" << counters.admissionRate << '\n';
+    }
+    std::cout << std::flush;
+}
+
+RetryController::OperationState& RetryController::State(const std::string& operation) {
+    auto found = operations.find(operation);
+    if (found == operations.end()) {
+        found = operations.emplace(operation, OperationState()).first;
+        found->second.windowStart = Clock::now();
+    }
+    return found->second;
+}
+
+void RetryController::Throttle(OperationState& state, Clock::time_point now) {
+    ++state.counters.throttled;
+
+    // Before the first full window the rate is estimated from the calls so far
+    double observed = state.measuredRate > 0
+        ? state.measuredRate
+        : state.windowAttempts / std::max(Seconds(now - state.windowStart), kMeasureWindowSeconds);
+    double base = state.limited ? std::min(state.rate, std::max(observed, options.minRate)) : observed;
+    state.rate = std::max(options.minRate, base * options.decreaseFactor);
+    if (!state.limited) {
+        state.limited = true;
+        state.tokens = 0;
+        state.lastRefill = now;
+    }
+    state.lastGrowth = now;
+    state.counters.admissionRate = state.rate;
+}
+
+}  // namespace utils
+}  // namespace awsexamples
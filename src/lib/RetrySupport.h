@@ -0,0 +1,296 @@
+/**
+ * @file RetrySupport.h
+ * @brief Internal helpers running SDK calls under a RetryController
+ */
+
+#ifndef AWSEXAMPLES_RETRYSUPPORT_H
+#define AWSEXAMPLES_RETRYSUPPORT_H
+
+#include "awsexamples/Metrics.h"
+#include "awsexamples/RetryController.h"
+#include "awsexamples/Tracing.h"
+#include "awsexamples/Waiter.h"
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/client/DefaultRetryStrategy.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @brief Copy a client configuration with the SDK's own retries turned off
+ *
+ * Managers retry through their RetryController. An SDK retry strategy under it
+ * would multiply the attempts of every call and retry throttling errors before
+ * the controller could see them.
+ *
+ * @param config The configuration to copy
+ * @return Aws::Client::ClientConfiguration The copy, with a retry strategy that never retries
+ */
+inline Aws::Client::ClientConfiguration WithoutSdkRetries(const Aws::Client::ClientConfiguration& config) {
+    Aws::Client::ClientConfiguration single = config;
+    single.retryStrategy = Aws::MakeShared<Aws::Client::DefaultRetryStrategy>("RetrySupport", 0);
+    return single;
+}
+
+/**
+ * @brief Check whether an SDK error is a throttling error
+ */
+template <typename Error>
+bool IsThrottled(const Error& error) {
+    return utils::RetryController::IsThrottlingError(error.GetExceptionName(),
+                                                     static_cast<int>(error.GetResponseCode()));
+}
+
+/**
+ * @brief Classify an SDK error for metrics
+ */
+template <typename Error>
+utils::ErrorClass ClassifyError(const Error& error) {
+    const int status = static_cast<int>(error.GetResponseCode());
+    if (IsThrottled(error)) {
+        return utils::ErrorClass::Throttling;
+    }
+    if (status >= 500) {
+        return utils::ErrorClass::Server;
+    }
+    if (status >= 400) {
+        return utils::ErrorClass::Client;
+    }
+    return utils::ErrorClass::Network;
+}
+
+/**
+ * @brief Record a completed call in the MetricsRegistry and, if tracing, the Tracer
+ *
+ * @param operation The operation name, e.g. "PutItem"
+ * @param start When the call started
+ * @param outcome The outcome of its last attempt
+ * @param attempts Attempts sent
+ * @param waited Time spent in admission waits and backoff
+ */
+template <typename Outcome>
+void RecordCall(const std::string& operation,
+                std::chrono::steady_clock::time_point start,
+                const Outcome& outcome,
+                int attempts = 1,
+                std::chrono::microseconds waited = std::chrono::microseconds(0)) {
+    auto& metrics = utils::MetricsRegistry::Instance();
+    auto& tracer = utils::Tracer::Instance();
+    if (!metrics.IsEnabled() && !tracer.IsEnabled()) {
+        return;
+    }
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    if (metrics.IsEnabled()) {
+        metrics.Record(operation, latency,
+                       outcome.IsSuccess() ? utils::ErrorClass::None : ClassifyError(outcome.GetError()));
+    }
+    if (tracer.IsEnabled()) {
+        utils::TraceEvent event;
+        event.kind = utils::TraceKind::Operation;
+        event.name = operation;
+        event.start = start;
+        event.duration = latency;
+        event.attempts = attempts;
+        event.retryDelay = waited;
+        if (!outcome.IsSuccess()) {
+            event.errorType = outcome.GetError().GetExceptionName();
+        }
+        tracer.Record(event);
+    }
+}
+
+/**
+ * @brief Add the payload bytes of a successful call to the MetricsRegistry
+ *
+ * @param operation The operation name, e.g. "UploadPart"
+ * @param bytes The bytes sent or received
+ */
+inline void RecordBytes(const std::string& operation, std::uint64_t bytes) {
+    auto& metrics = utils::MetricsRegistry::Instance();
+    if (metrics.IsEnabled()) {
+        metrics.AddBytes(operation, bytes);
+    }
+}
+
+/**
+ * @brief Run a blocking SDK call once, recording it in the MetricsRegistry
+ *
+ * For calls that must not be retried, e.g. uploads of a stream that cannot be
+ * rewound.
+ *
+ * @param operation The operation name, e.g. "PutObject"
+ * @param call Callable sending the request and returning its outcome
+ * @return The outcome
+ */
+template <typename Call>
+auto Measure(const std::string& operation, Call&& call) -> decltype(call()) {
+    auto start = std::chrono::steady_clock::now();
+    auto outcome = call();
+    RecordCall(operation, start, outcome);
+    return outcome;
+}
+
+/**
+ * @brief Run a blocking SDK call with admission control and retries
+ *
+ * @p call must build its request afresh on every invocation, so that a retry
+ * never re-sends a consumed body stream. The call is recorded in the
+ * MetricsRegistry and, if tracing is enabled, the Tracer.
+ *
+ * @param controller The controller of the call's service
+ * @param operation The operation name, e.g. "PutItem"
+ * @param call Callable sending one attempt and returning its outcome
+ * @return The outcome of the last attempt
+ */
+template <typename Call>
+auto Execute(utils::RetryController& controller, const std::string& operation, Call&& call) -> decltype(call()) {
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::microseconds waited{0};
+    controller.OnCall(operation);
+    for (int attempt = 1;; ++attempt) {
+        auto admissionDelay = controller.Admit(operation);
+        if (admissionDelay.count() > 0) {
+            std::this_thread::sleep_for(admissionDelay);
+            waited += admissionDelay;
+        }
+
+        auto outcome = call();
+        if (outcome.IsSuccess()) {
+            controller.OnSuccess(operation, attempt);
+            RecordCall(operation, start, outcome, attempt, waited);
+            return outcome;
+        }
+
+        std::chrono::milliseconds retryDelay{0};
+        if (!controller.OnFailure(operation, attempt, IsThrottled(outcome.GetError()),
+                                  outcome.GetError().ShouldRetry(), retryDelay)) {
+            RecordCall(operation, start, outcome, attempt, waited);
+            return outcome;
+        }
+        std::this_thread::sleep_for(retryDelay);
+        waited += retryDelay;
+    }
+}
+
+/**
+ * @brief State of one asynchronous call made through ExecuteAsync
+ */
+template <typename Outcome>
+class AsyncCall : public std::enable_shared_from_this<AsyncCall<Outcome>> {
+public:
+    using OutcomeCallback = std::function<void(const Outcome&)>;
+    using Starter = std::function<void(OutcomeCallback)>;
+
+    AsyncCall(std::shared_ptr<utils::RetryController> controller,
+              std::string operation,
+              Starter start,
+              OutcomeCallback done)
+        : controller(std::move(controller)),
+          operation(std::move(operation)),
+          start(std::move(start)),
+          done(std::move(done)),
+          started(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Send the next attempt once it is admitted
+     */
+    void Attempt() {
+        ++attempt;
+        auto self = this->shared_from_this();
+        auto send = [self]() {
+            self->start([self](const Outcome& outcome) { self->Complete(outcome); });
+        };
+
+        // Waiting for admission must not hold up an executor thread; if the waiter
+        // shuts down meanwhile the attempt is sent straight away
+        auto admissionDelay = controller->Admit(operation);
+        if (admissionDelay.count() > 0) {
+            waited += admissionDelay;
+            Waiter::Instance().Schedule(admissionDelay, [send](bool) { send(); });
+        } else {
+            send();
+        }
+    }
+
+private:
+    void Complete(const Outcome& outcome) {
+        if (outcome.IsSuccess()) {
+            controller->OnSuccess(operation, attempt);
+            RecordCall(operation, started, outcome, attempt, waited);
+            done(outcome);
+            return;
+        }
+
+        std::chrono::milliseconds retryDelay{0};
+        if (!controller->OnFailure(operation, attempt, IsThrottled(outcome.GetError()),
+                                   outcome.GetError().ShouldRetry(), retryDelay)) {
+            RecordCall(operation, started, outcome, attempt, waited);
+            done(outcome);
+            return;
+        }
+        waited += retryDelay;
+        auto self = this->shared_from_this();
+        Waiter::Instance().Schedule(retryDelay, [self](bool) { self->Attempt(); });
+    }
+
+    std::shared_ptr<utils::RetryController> controller; ///< Controller of the service
+    std::string operation;                              ///< Operation name
+    Starter start;                                      ///< Sends one attempt
+    OutcomeCallback done;                               ///< Receives the final outcome
+    std::chrono::steady_clock::time_point started;      ///< When the call was made, for metrics
+    std::chrono::microseconds waited{0};                ///< Admission waits and backoff so far, for tracing
+    int attempt = 0;                                    ///< Attempts sent so far
+};
+
+/**
+ * @brief Run an asynchronous SDK call with admission control and retries
+ *
+ * Admission delays and backoffs are scheduled on the Waiter, so no thread is
+ * blocked while a call waits.
+ *
+ * @param controller The controller of the call's service
+ * @param operation The operation name, e.g. "PutItem"
+ * @param start Sends one attempt, given the callback to pass its outcome to
+ * @param done Receives the outcome of the last attempt
+ */
+template <typename Outcome>
+void ExecuteAsync(std::shared_ptr<utils::RetryController> controller,
+                  std::string operation,
+                  typename AsyncCall<Outcome>::Starter start,
+                  typename AsyncCall<Outcome>::OutcomeCallback done) {
+    controller->OnCall(operation);
+    std::make_shared<AsyncCall<Outcome>>(std::move(controller), std::move(operation), std::move(start), std::move(done))
+        ->Attempt();
+}
+
+/**
+ * @brief Run an asynchronous SDK call with admission control and retries
+ *
+ * @param controller The controller of the call's service
+ * @param operation The operation name, e.g. "StartInstances"
+ * @param start Sends one attempt, given the callback to pass its outcome to
+ * @return std::future<Outcome> Becomes the outcome of the last attempt
+ */
+template <typename Outcome>
+std::future<Outcome> ExecuteCallable(std::shared_ptr<utils::RetryController> controller,
+                                     std::string operation,
+                                     typename AsyncCall<Outcome>::Starter start) {
+    auto promise = std::make_shared<std::promise<Outcome>>();
+    auto future = promise->get_future();
+    ExecuteAsync<Outcome>(std::move(controller), std::move(operation), std::move(start),
+                          [promise](const Outcome& outcome) { promise->set_value(outcome); });
+    return future;
+}
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_RETRYSUPPORT_H
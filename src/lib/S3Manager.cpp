@@ -4,39 +4,163 @@
  */
 
 #include "awsexamples/S3Manager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/Logger.h"
+#include "awsexamples/MemoryStream.h"
+#include "awsexamples/S3ObjectLister.h"
+#include "awsexamples/Tracing.h"
+#include "AsyncSupport.h"
+#include "ParallelFor.h"
+#include "ResultSupport.h"
+#include "RetrySupport.h"
 #include <aws/s3/model/ListBucketsRequest.h>
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
 #include <aws/core/utils/memory/stl/AWSStreamFwd.h>
 #include <aws/core/utils/memory/stl/AWSStringStream.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <streambuf>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace awsexamples {
 
-S3Manager::S3Manager() : s3Client() {}
+namespace {
 
-S3Manager::S3Manager(const Aws::Client::ClientConfiguration& config) : s3Client(config) {}
+constexpr std::size_t kMinPartSize = 5 * 1024 * 1024;  // S3 minimum for all but the last part
+constexpr std::size_t kMaxPartCount = 10000;           // S3 maximum parts per upload
+constexpr double kBytesPerMiB = 1024.0 * 1024.0;
 
-void S3Manager::ListBuckets() {
-    auto outcome = s3Client.ListBuckets();
-    if (outcome.IsSuccess()) {
-        std::cout << "Your S3 buckets:\n";
-        for (const auto& bucket : outcome.GetResult().GetBuckets()) {
-            std::cout << "  " << bucket.GetName() 
-                     << " (created " << bucket.GetCreationDate().ToGmtString(Aws::Utils::DateFormat::ISO_8601)
-                     << ")" << std::endl;
+void RecordTransferStats(TransferStats* stats,
+                         std::uint64_t bytes,
+                         std::size_t partCount,
+                         std::chrono::steady_clock::time_point start) {
+    if (stats == nullptr) {
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats->bytesTransferred = bytes;
+    stats->partCount = partCount;
+    stats->elapsedSeconds = elapsed.count();
+    stats->throughputMiBps = elapsed.count() > 0.0 ? (bytes / kBytesPerMiB) / elapsed.count() : 0.0;
+}
+
+constexpr std::size_t kMinRangeSize = 256 * 1024;
+
+/**
+ * Stream buffer that writes everything it receives straight to a fixed offset of a
+ * file descriptor with pwrite, so ranged GET responses land in place without an
+ * intermediate copy through iostream buffering.
+ */
+class OffsetWriteStreamBuf : public std::streambuf {
+public:
+    OffsetWriteStreamBuf(int fd, off_t offset) : fd(fd), offset(offset) {}
+
+protected:
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        std::streamsize written = 0;
+        while (written < count) {
+            ssize_t result = ::pwrite(fd, data + written, static_cast<std::size_t>(count - written), offset);
+            if (result <= 0) {
+                break;
+            }
+            written += result;
+            offset += result;
         }
-    } else {
-        std::cerr << "ListBuckets error: " << outcome.GetError().GetMessage() << std::endl;
+        return written;
     }
+
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        char byte = traits_type::to_char_type(ch);
+        return xsputn(&byte, 1) == 1 ? ch : traits_type::eof();
+    }
+
+private:
+    int fd;
+    off_t offset;
+};
+
+/**
+ * Response stream handed to the SDK for a single byte range; owned and deleted by the SDK
+ */
+class OffsetWriteStream : public Aws::IOStream {
+public:
+    OffsetWriteStream(int fd, off_t offset) : Aws::IOStream(nullptr), buffer(fd, offset) {
+        rdbuf(&buffer);
+    }
+
+private:
+    OffsetWriteStreamBuf buffer;
+};
+
+// Load the resume journal of an earlier download, marking its finished ranges as completed.
+// Returns false if there is no journal or it belongs to a different object version.
+bool LoadDownloadJournal(const std::string& journalPath,
+                         const std::string& eTag,
+                         std::uint64_t objectSize,
+                         std::size_t rangeSize,
+                         std::vector<bool>& completed) {
+    std::ifstream journal(journalPath);
+    std::string journalETag;
+    std::uint64_t journalSize = 0;
+    std::size_t journalRangeSize = 0;
+    if (!(journal >> journalETag >> journalSize >> journalRangeSize) || journalETag != eTag ||
+        journalSize != objectSize || journalRangeSize != rangeSize) {
+        return false;
+    }
+    
+    std::size_t index = 0;
+    while (journal >> index) {
+        if (index < completed.size()) {
+            completed[index] = true;
+        }
+    }
+    return true;
 }
 
-bool S3Manager::CreateBucket(const std::string& bucketName, const std::string& region) {
+// Reserve disk space for the whole object up front so ranges can be written in any order
+bool PreallocateFile(int fd, std::uint64_t size) {
+    if (size == 0) {
+        return ::ftruncate(fd, 0) == 0;
+    }
+    if (::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0) {
+        return true;
+    }
+    // Not every file system supports fallocate; a sparse file still allows in-place writes
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+// Log a local file that cannot be opened and describe it to the caller
+OperationResult ReportOpenFailure(const detail::ResultTimer& timer, const std::string& path) {
+    AWSEXAMPLES_LOG(Error, "Failed to open file: " << path);
+    return timer.Failed(errors::kIoError, "Failed to open file: " + path);
+}
+
+Aws::S3::Model::CreateBucketRequest MakeCreateBucketRequest(const std::string& bucketName,
+                                                            const std::string& region) {
     Aws::S3::Model::CreateBucketRequest request;
     request.SetBucket(bucketName);
     
@@ -47,135 +171,728 @@ bool S3Manager::CreateBucket(const std::string& bucketName, const std::string& r
         );
         request.SetCreateBucketConfiguration(config);
     }
+    return request;
+}
+
+Aws::S3::Model::PutObjectRequest MakePutObjectRequest(const std::string& bucketName,
+                                                      const std::string& keyName,
+                                                      const std::shared_ptr<Aws::IOStream>& body) {
+    Aws::S3::Model::PutObjectRequest request;
+    request.SetBucket(bucketName);
+    request.SetKey(keyName);
+    request.SetBody(body);
     
-    auto outcome = s3Client.CreateBucket(request);
+    // Known-size views spare the SDK a seek to the end to measure the body
+    if (auto view = std::dynamic_pointer_cast<MemoryViewStream>(body)) {
+        request.SetContentLength(static_cast<long long>(view->Size()));
+    }
+    return request;
+}
+
+// Upload a mapped file with PutObject; each attempt reads it through a fresh view of the mapping
+Aws::S3::Model::PutObjectOutcome PutMappedFile(const Aws::S3::S3Client& client,
+                                               utils::RetryController& controller,
+                                               const std::string& bucketName,
+                                               const std::string& keyName,
+                                               const std::shared_ptr<const MappedFile>& mappedFile) {
+    auto outcome = detail::Execute(controller, "PutObject", [&]() {
+        return client.PutObject(
+            MakePutObjectRequest(bucketName, keyName, Aws::MakeShared<MemoryViewStream>("S3Manager", mappedFile)));
+    });
     if (outcome.IsSuccess()) {
-        std::cout << "Created bucket: " << bucketName << std::endl;
-        return true;
+        detail::RecordBytes("PutObject", mappedFile->Size());
+    }
+    return outcome;
+}
+
+// Response stream of a whole-object download; truncates the file, so a retry overwrites a failed attempt
+Aws::IOStream* OpenDownloadFile(const std::string& localPath) {
+    return Aws::New<Aws::FStream>("S3Manager",
+                                  localPath.c_str(),
+                                  std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+}
+
+}  // namespace
+
+S3Manager::S3Manager() : S3Manager(Aws::Client::ClientConfiguration()) {}
+
+S3Manager::S3Manager(const Aws::Client::ClientConfiguration& config)
+    : s3Client(utils::ClientRegistry::Instance().Get<Aws::S3::S3Client>(detail::WithoutSdkRetries(config))),
+      maxConnections(config.maxConnections),
+      retryController(utils::RetryController::ForService("s3")) {}
+
+S3Manager::S3Manager(const Aws::Client::ClientConfiguration& config, bool useVirtualAddressing)
+    : s3Client(utils::ClientRegistry::Instance().GetOrCreate<Aws::S3::S3Client>(
+          detail::WithoutSdkRetries(config),
+          useVirtualAddressing ? "virtual-hosted" : "path-style",
+          [&config, useVirtualAddressing]() {
+              return Aws::MakeShared<Aws::S3::S3Client>(
+                  "S3Manager",
+                  detail::WithoutSdkRetries(config),
+                  Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
+                  useVirtualAddressing);
+          })),
+      maxConnections(config.maxConnections),
+      retryController(utils::RetryController::ForService("s3")) {}
+
+S3Manager::S3Manager(std::shared_ptr<Aws::S3::S3Client> client, unsigned maxConnections)
+    : s3Client(std::move(client)),
+      maxConnections(maxConnections),
+      retryController(utils::RetryController::ForService("s3")) {}
+
+void S3Manager::ListBuckets() {
+    auto outcome = detail::Execute(*retryController, "ListBuckets", [&]() { return s3Client->ListBuckets(); });
+    if (outcome.IsSuccess()) {
+        std::cout << "Your S3 buckets:\n";
+        for (const auto& bucket : outcome.GetResult().GetBuckets()) {
+            std::cout << "  " << bucket.GetName() 
+                     << " (created " << bucket.GetCreationDate().ToGmtString(Aws::Utils::DateFormat::ISO_8601)
+                     << ")" << std::endl;
+        }
     } else {
-        std::cerr << "CreateBucket error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+        AWSEXAMPLES_LOG(Error, "ListBuckets error: " << outcome.GetError().GetMessage());
     }
 }
 
-bool S3Manager::DeleteBucket(const std::string& bucketName) {
+OperationResult S3Manager::CreateBucket(const std::string& bucketName, const std::string& region) {
+    detail::ResultTimer timer;
+    auto outcome = detail::Execute(*retryController, "CreateBucket", [&]() {
+        return s3Client->CreateBucket(MakeCreateBucketRequest(bucketName, region));
+    });
+    return detail::ReportResult(timer, outcome, "Created bucket: " + bucketName, "CreateBucket error");
+}
+
+OperationResult S3Manager::DeleteBucket(const std::string& bucketName) {
+    detail::ResultTimer timer;
     Aws::S3::Model::DeleteBucketRequest request;
     request.SetBucket(bucketName);
     
-    auto outcome = s3Client.DeleteBucket(request);
-    if (outcome.IsSuccess()) {
-        std::cout << "Deleted bucket: " << bucketName << std::endl;
-        return true;
-    } else {
-        std::cerr << "DeleteBucket error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    auto outcome = detail::Execute(*retryController, "DeleteBucket", [&]() { return s3Client->DeleteBucket(request); });
+    return detail::ReportResult(timer, outcome, "Deleted bucket: " + bucketName, "DeleteBucket error");
+}
+
+OperationResult S3Manager::UploadFile(const std::string& bucketName, 
+                                      const std::string& keyName, 
+                                      const std::string& filePath) {
+    
+    utils::TraceScope scope("UploadFile");
+    detail::ResultTimer timer;
+    // Map the file so the SDK signs and sends the bytes in place instead of copying
+    // them through an fstream buffer
+    auto mappedFile = std::make_shared<const MappedFile>(filePath);
+    if (!mappedFile->IsOpen()) {
+        return ReportOpenFailure(timer, filePath);
     }
+    
+    auto outcome = PutMappedFile(*s3Client, *retryController, bucketName, keyName, mappedFile);
+    return detail::ReportResult(timer, outcome, "Successfully uploaded: " + keyName, "Upload error");
 }
 
-bool S3Manager::UploadFile(const std::string& bucketName, 
-                         const std::string& keyName, 
-                         const std::string& filePath) {
+OperationResult S3Manager::UploadFile(const std::string& bucketName, 
+                                      const std::string& keyName, 
+                                      const std::string& filePath,
+                                      const MultipartUploadOptions& options,
+                                      TransferStats* stats) {
     
-    Aws::S3::Model::PutObjectRequest request;
-    request.SetBucket(bucketName);
-    request.SetKey(keyName);
+    utils::TraceScope scope("UploadFile");
+    detail::ResultTimer timer;
+    auto start = std::chrono::steady_clock::now();
     
-    std::shared_ptr<Aws::IOStream> inputData = 
-        Aws::MakeShared<Aws::FStream>("SampleAllocationTag", 
-                                      filePath.c_str(), 
-                                      std::ios_base::in | std::ios_base::binary);
+    auto mappedFile = std::make_shared<const MappedFile>(filePath);
+    if (!mappedFile->IsOpen()) {
+        return ReportOpenFailure(timer, filePath);
+    }
+    const std::uint64_t fileSize = mappedFile->Size();
     
-    if (!inputData->good()) {
-        std::cerr << "Failed to open file: " << filePath << std::endl;
-        return false;
+    // Respect the S3 part size floor and grow parts if the file would exceed the part limit
+    std::size_t partSize = std::max(options.partSize, kMinPartSize);
+    if ((fileSize + partSize - 1) / partSize > kMaxPartCount) {
+        partSize = static_cast<std::size_t>((fileSize + kMaxPartCount - 1) / kMaxPartCount);
     }
     
-    request.SetBody(inputData);
+    if (fileSize <= partSize) {
+        auto outcome = PutMappedFile(*s3Client, *retryController, bucketName, keyName, mappedFile);
+        RecordTransferStats(stats, outcome.IsSuccess() ? fileSize : 0, 1, start);
+        return detail::ReportResult(timer, outcome, "Successfully uploaded: " + keyName, "Upload error");
+    }
     
-    auto outcome = s3Client.PutObject(request);
-    if (outcome.IsSuccess()) {
-        std::cout << "Successfully uploaded: " << keyName << std::endl;
+    const auto partCount = static_cast<std::size_t>((fileSize + partSize - 1) / partSize);
+    const unsigned concurrency = options.concurrency > 0 ? options.concurrency : maxConnections;
+    
+    Aws::S3::Model::CreateMultipartUploadRequest createRequest;
+    createRequest.SetBucket(bucketName);
+    createRequest.SetKey(keyName);
+    
+    auto createOutcome = detail::Execute(*retryController, "CreateMultipartUpload", [&]() {
+        return s3Client->CreateMultipartUpload(createRequest);
+    });
+    if (!createOutcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "CreateMultipartUpload error: " << createOutcome.GetError().GetMessage());
+        return timer.From(createOutcome);
+    }
+    const std::string uploadId = createOutcome.GetResult().GetUploadId();
+    
+    std::vector<Aws::S3::Model::CompletedPart> completedParts(partCount);
+    std::atomic<std::uint64_t> bytesSent{0};
+    detail::FirstFailure failure;
+    
+    bool allPartsUploaded = detail::ParallelFor(partCount, concurrency, [&](std::size_t index) {
+        const std::uint64_t offset = static_cast<std::uint64_t>(index) * partSize;
+        const auto length = static_cast<std::size_t>(std::min<std::uint64_t>(partSize, fileSize - offset));
+        const int partNumber = static_cast<int>(index) + 1;
+        
+        Aws::S3::Model::UploadPartRequest partRequest;
+        partRequest.SetBucket(bucketName);
+        partRequest.SetKey(keyName);
+        partRequest.SetUploadId(uploadId);
+        partRequest.SetPartNumber(partNumber);
+        partRequest.SetContentLength(static_cast<long long>(length));
+        
+        // Each attempt reads the part through a fresh view of the mapping
+        auto partOutcome = detail::Execute(*retryController, "UploadPart", [&]() {
+            partRequest.SetBody(Aws::MakeShared<MemoryViewStream>(
+                "S3Manager", mappedFile, static_cast<std::size_t>(offset), length));
+            return s3Client->UploadPart(partRequest);
+        });
+        if (!partOutcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "UploadPart " << partNumber << " error: "
+                                   << partOutcome.GetError().GetMessage());
+            failure.Record(partOutcome);
+            return false;
+        }
+        
+        completedParts[index].SetETag(partOutcome.GetResult().GetETag());
+        completedParts[index].SetPartNumber(partNumber);
+        bytesSent += length;
+        detail::RecordBytes("UploadPart", length);
         return true;
-    } else {
-        std::cerr << "Upload error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    });
+    
+    if (!allPartsUploaded) {
+        AbortMultipartUpload(bucketName, keyName, uploadId);
+        RecordTransferStats(stats, bytesSent.load(), partCount, start);
+        return failure.Result(timer);
     }
-}
-
-bool S3Manager::UploadText(const std::string& bucketName, 
-                         const std::string& keyName,
-                         const std::string& content) {
     
-    Aws::S3::Model::PutObjectRequest request;
-    request.SetBucket(bucketName);
-    request.SetKey(keyName);
+    Aws::S3::Model::CompletedMultipartUpload completedUpload;
+    completedUpload.SetParts(completedParts);
+    
+    Aws::S3::Model::CompleteMultipartUploadRequest completeRequest;
+    completeRequest.SetBucket(bucketName);
+    completeRequest.SetKey(keyName);
+    completeRequest.SetUploadId(uploadId);
+    completeRequest.SetMultipartUpload(completedUpload);
     
-    auto inputData = Aws::MakeShared<Aws::StringStream>("SampleAllocationTag");
-    *inputData << content;
+    auto completeOutcome = detail::Execute(*retryController, "CompleteMultipartUpload", [&]() {
+        return s3Client->CompleteMultipartUpload(completeRequest);
+    });
+    if (!completeOutcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "CompleteMultipartUpload error: " << completeOutcome.GetError().GetMessage());
+        AbortMultipartUpload(bucketName, keyName, uploadId);
+        RecordTransferStats(stats, bytesSent.load(), partCount, start);
+        return timer.From(completeOutcome);
+    }
     
-    request.SetBody(inputData);
+    TransferStats localStats;
+    RecordTransferStats(&localStats, bytesSent.load(), partCount, start);
+    if (stats != nullptr) {
+        *stats = localStats;
+    }
+    AWSEXAMPLES_LOG(Info, "Successfully uploaded: " << keyName << " (" << partCount << " parts, "
+                          << localStats.bytesTransferred / kBytesPerMiB << " MiB in " << localStats.elapsedSeconds
+                          << " s, " << localStats.throughputMiBps << " MiB/s)");
+    return timer.Succeeded();
+}
+
+OperationResult S3Manager::UploadText(const std::string& bucketName, 
+                                      const std::string& keyName,
+                                      const std::string& content) {
     
-    auto outcome = s3Client.PutObject(request);
+    detail::ResultTimer timer;
+    // The views read content in place; it outlives them since PutObject is synchronous
+    auto outcome = detail::Execute(*retryController, "PutObject", [&]() {
+        auto inputData = Aws::MakeShared<MemoryViewStream>("S3Manager", content.data(), content.size());
+        return s3Client->PutObject(MakePutObjectRequest(bucketName, keyName, inputData));
+    });
     if (outcome.IsSuccess()) {
-        std::cout << "Successfully uploaded text content as: " << keyName << std::endl;
-        return true;
-    } else {
-        std::cerr << "Text upload error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+        detail::RecordBytes("PutObject", content.size());
     }
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Successfully uploaded text content as: " + keyName,
+                                "Text upload error");
 }
 
-bool S3Manager::DownloadFile(const std::string& bucketName, 
-                           const std::string& keyName, 
-                           const std::string& localPath) {
+OperationResult S3Manager::UploadStream(const std::string& bucketName, 
+                                        const std::string& keyName,
+                                        const std::shared_ptr<Aws::IOStream>& body) {
     
+    detail::ResultTimer timer;
+    // A stream cannot be rewound for a retry, so the upload is sent once
+    auto outcome = detail::Measure("PutObject", [&]() {
+        return s3Client->PutObject(MakePutObjectRequest(bucketName, keyName, body));
+    });
+    return detail::ReportResult(timer, outcome, "Successfully uploaded: " + keyName, "Upload error");
+}
+
+OperationResult S3Manager::DownloadFile(const std::string& bucketName, 
+                                        const std::string& keyName, 
+                                        const std::string& localPath) {
+    
+    utils::TraceScope scope("DownloadFile");
+    detail::ResultTimer timer;
     Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(bucketName);
     request.SetKey(keyName);
+    request.SetResponseStreamFactory([&localPath]() { return OpenDownloadFile(localPath); });
     
-    auto outcome = s3Client.GetObject(request);
+    auto outcome = detail::Execute(*retryController, "GetObject", [&]() { return s3Client->GetObject(request); });
     
     if (outcome.IsSuccess()) {
-        std::ofstream localFile(localPath, std::ios::binary);
-        localFile << outcome.GetResult().GetBody().rdbuf();
-        std::cout << "Successfully downloaded " << keyName << " to " << localPath << std::endl;
-        return true;
+        // The result still owns the file stream; flush before reporting completion
+        outcome.GetResult().GetBody().flush();
+        detail::RecordBytes("GetObject", static_cast<std::uint64_t>(outcome.GetResult().GetContentLength()));
+        AWSEXAMPLES_LOG(Info, "Successfully downloaded " << keyName << " to " << localPath);
     } else {
-        std::cerr << "Download error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+        std::remove(localPath.c_str());
+        AWSEXAMPLES_LOG(Error, "Download error: " << outcome.GetError().GetMessage());
     }
+    return timer.From(outcome);
 }
 
-bool S3Manager::DeleteObject(const std::string& bucketName, const std::string& keyName) {
+OperationResult S3Manager::DownloadFile(const std::string& bucketName, 
+                                        const std::string& keyName, 
+                                        const std::string& localPath,
+                                        const RangedDownloadOptions& options,
+                                        TransferStats* stats) {
+    
+    utils::TraceScope scope("DownloadFile");
+    detail::ResultTimer timer;
+    auto start = std::chrono::steady_clock::now();
+    
+    Aws::S3::Model::HeadObjectRequest headRequest;
+    headRequest.SetBucket(bucketName);
+    headRequest.SetKey(keyName);
+    
+    auto headOutcome = detail::Execute(*retryController, "HeadObject", [&]() { return s3Client->HeadObject(headRequest); });
+    if (!headOutcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "HeadObject error: " << headOutcome.GetError().GetMessage());
+        return timer.From(headOutcome);
+    }
+    
+    const auto objectSize = static_cast<std::uint64_t>(headOutcome.GetResult().GetContentLength());
+    const std::string eTag = headOutcome.GetResult().GetETag();
+    const std::size_t rangeSize = std::max(options.rangeSize, kMinRangeSize);
+    const auto rangeCount = static_cast<std::size_t>((objectSize + rangeSize - 1) / rangeSize);
+    const unsigned concurrency = options.concurrency > 0 ? options.concurrency : maxConnections;
+    const std::string journalPath = localPath + ".parts";
+    
+    std::vector<bool> completed(rangeCount, false);
+    bool resuming = options.resume &&
+                    LoadDownloadJournal(journalPath, eTag, objectSize, rangeSize, completed);
+    
+    int fd = ::open(localPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return ReportOpenFailure(timer, localPath);
+    }
+    
+    struct stat fileInfo {};
+    if (resuming && (::fstat(fd, &fileInfo) != 0 || static_cast<std::uint64_t>(fileInfo.st_size) != objectSize)) {
+        resuming = false;
+        completed.assign(rangeCount, false);
+    }
+    
+    if (!resuming) {
+        if (::ftruncate(fd, 0) != 0 || !PreallocateFile(fd, objectSize)) {
+            AWSEXAMPLES_LOG(Error, "Failed to preallocate " << objectSize << " bytes for " << localPath);
+            ::close(fd);
+            return timer.Failed(errors::kIoError, "Failed to preallocate " + localPath);
+        }
+        std::ofstream(journalPath, std::ios::trunc) << eTag << ' ' << objectSize << ' ' << rangeSize << '\n';
+    }
+    
+    std::vector<std::size_t> pendingRanges;
+    for (std::size_t index = 0; index < rangeCount; ++index) {
+        if (!completed[index]) {
+            pendingRanges.push_back(index);
+        }
+    }
+    if (resuming) {
+        AWSEXAMPLES_LOG(Info, "Resuming download of " << keyName << ": " << pendingRanges.size() << " of "
+                              << rangeCount << " ranges remaining");
+    }
+    
+    std::ofstream journal(journalPath, std::ios::app);
+    std::mutex journalMutex;
+    std::atomic<std::uint64_t> bytesReceived{0};
+    detail::FirstFailure failure;
+    
+    bool allRangesDownloaded = detail::ParallelFor(pendingRanges.size(), concurrency, [&](std::size_t i) {
+        const std::size_t index = pendingRanges[i];
+        const std::uint64_t first = static_cast<std::uint64_t>(index) * rangeSize;
+        const std::uint64_t last = std::min<std::uint64_t>(first + rangeSize, objectSize) - 1;
+        
+        Aws::S3::Model::GetObjectRequest request;
+        request.SetBucket(bucketName);
+        request.SetKey(keyName);
+        request.SetRange("bytes=" + std::to_string(first) + "-" + std::to_string(last));
+        request.SetIfMatch(eTag);  // Fail rather than mix ranges from two object versions
+        request.SetResponseStreamFactory([fd, first]() {
+            return Aws::New<OffsetWriteStream>("S3Manager", fd, static_cast<off_t>(first));
+        });
+        
+        // A retried range is simply written again at the same offset
+        auto outcome = detail::Execute(*retryController, "GetObject", [&]() { return s3Client->GetObject(request); });
+        if (!outcome.IsSuccess()) {
+            AWSEXAMPLES_LOG(Error, "Download range " << first << "-" << last << " error: "
+                                   << outcome.GetError().GetMessage());
+            failure.Record(outcome);
+            return false;
+        }
+        if (!outcome.GetResult().GetBody().good() ||
+            static_cast<std::uint64_t>(outcome.GetResult().GetContentLength()) != last - first + 1) {
+            AWSEXAMPLES_LOG(Error, "Failed to write range " << first << "-" << last << " to " << localPath);
+            failure.Record(errors::kIoError, "Failed to write to " + localPath, true);
+            return false;
+        }
+        
+        bytesReceived += last - first + 1;
+        detail::RecordBytes("GetObject", last - first + 1);
+        std::lock_guard<std::mutex> lock(journalMutex);
+        journal << index << '\n' << std::flush;
+        return true;
+    });
+    
+    journal.close();
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    
+    TransferStats localStats;
+    RecordTransferStats(&localStats, bytesReceived.load(), rangeCount, start);
+    if (stats != nullptr) {
+        *stats = localStats;
+    }
+    
+    if (!synced) {
+        failure.Record(errors::kIoError, "Failed to sync " + localPath, true);
+    }
+    if (!allRangesDownloaded || !synced) {
+        AWSEXAMPLES_LOG(Warn, "Download of " << keyName << " incomplete; call again to resume");
+        return failure.Result(timer);
+    }
+    
+    std::remove(journalPath.c_str());
+    AWSEXAMPLES_LOG(Info, "Successfully downloaded " << keyName << " to " << localPath << " (" << rangeCount
+                          << " ranges, " << localStats.bytesTransferred / kBytesPerMiB << " MiB in "
+                          << localStats.elapsedSeconds << " s, " << localStats.throughputMiBps << " MiB/s)");
+    return timer.Succeeded();
+}
+
+OperationResult S3Manager::DeleteObject(const std::string& bucketName, const std::string& keyName) {
+    detail::ResultTimer timer;
     Aws::S3::Model::DeleteObjectRequest request;
     request.SetBucket(bucketName);
     request.SetKey(keyName);
     
-    auto outcome = s3Client.DeleteObject(request);
+    auto outcome = detail::Execute(*retryController, "DeleteObject", [&]() { return s3Client->DeleteObject(request); });
+    return detail::ReportResult(timer,
+                                outcome,
+                                "Successfully deleted " + keyName + " from " + bucketName,
+                                "Delete object error");
+}
+
+void S3Manager::ListObjects(const std::string& bucketName) {
+    S3ObjectLister lister(*this, bucketName);
+    std::size_t objectCount = 0;
     
-    if (outcome.IsSuccess()) {
-        std::cout << "Successfully deleted " << keyName << " from " << bucketName << std::endl;
+    std::cout << "Objects in " << bucketName << ":\n";
+    for (const auto& object : lister) {
+        std::cout << "  " << object.GetKey() << " - Size: " << object.GetSize() << " bytes" <<
+            " - Last Modified: " << object.GetLastModified().ToGmtString(Aws::Utils::DateFormat::ISO_8601) << '\n';
+        ++objectCount;
+    }
+    std::cout << objectCount << " objects" << std::endl;
+    
+    if (lister.Failed()) {
+        AWSEXAMPLES_LOG(Warn, "ListObjects error: listing of " << bucketName << " is incomplete");
+    }
+}
+
+OperationResult S3Manager::ListObjectsParallel(const std::string& bucketName,
+                                               const ParallelListOptions& options,
+                                               const ObjectCallback& callback) {
+    utils::TraceScope scope("ListObjectsParallel");
+    detail::ResultTimer timer;
+    const unsigned concurrency = options.concurrency > 0 ? options.concurrency : maxConnections;
+    std::atomic<bool> stopped{false};
+    detail::FirstFailure failure;
+    
+    // Drain one listing into the callback; false only on a request error
+    auto visit = [&](S3ObjectLister& lister) {
+        Aws::S3::Model::Object object;
+        while (!stopped.load(std::memory_order_relaxed) && lister.Next(object)) {
+            if (!callback(object)) {
+                stopped.store(true, std::memory_order_relaxed);
+            }
+        }
+        if (lister.Failed()) {
+            const auto& error = lister.GetError();
+            failure.Record(error.GetExceptionName(), error.GetMessage(), error.ShouldRetry());
+            return false;
+        }
         return true;
-    } else {
-        std::cerr << "Delete object error: " << outcome.GetError().GetMessage() << std::endl;
-        return false;
+    };
+    
+    std::vector<std::string> prefixes{options.prefix};
+    for (int level = 0; level < options.depth && !options.delimiter.empty(); ++level) {
+        std::vector<std::vector<std::string>> discovered(prefixes.size());
+        bool success = detail::ParallelFor(prefixes.size(), concurrency, [&](std::size_t index) {
+            ListObjectsOptions listOptions;
+            listOptions.prefix = prefixes[index];
+            listOptions.delimiter = options.delimiter;
+            
+            S3ObjectLister lister(*this, bucketName, listOptions);
+            if (!visit(lister)) {
+                return false;
+            }
+            discovered[index].assign(lister.GetCommonPrefixes().begin(), lister.GetCommonPrefixes().end());
+            return true;
+        });
+        if (!success || stopped.load()) {
+            return failure.Result(timer);
+        }
+        
+        prefixes.clear();
+        for (auto& group : discovered) {
+            prefixes.insert(prefixes.end(),
+                            std::make_move_iterator(group.begin()),
+                            std::make_move_iterator(group.end()));
+        }
     }
+    
+    detail::ParallelFor(prefixes.size(), concurrency, [&](std::size_t index) {
+        ListObjectsOptions listOptions;
+        listOptions.prefix = prefixes[index];
+        
+        S3ObjectLister lister(*this, bucketName, listOptions);
+        return visit(lister);
+    });
+    return failure.Result(timer);
 }
 
-void S3Manager::ListObjects(const std::string& bucketName) {
-    Aws::S3::Model::ListObjectsV2Request request;
+void S3Manager::CreateBucketAsync(const std::string& bucketName,
+                                  const std::string& region,
+                                  CompletionCallback callback) {
+    detail::ExecuteAsync<Aws::S3::Model::CreateBucketOutcome>(
+        retryController, "CreateBucket",
+        [client = s3Client, request = MakeCreateBucketRequest(bucketName, region)](auto onOutcome) {
+            client->CreateBucketAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [bucketName, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome, "Created bucket: " + bucketName, "CreateBucket error"));
+        });
+}
+
+std::future<bool> S3Manager::CreateBucketAsync(const std::string& bucketName, const std::string& region) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        CreateBucketAsync(bucketName, region, std::move(done));
+    });
+}
+
+void S3Manager::DeleteBucketAsync(const std::string& bucketName, CompletionCallback callback) {
+    Aws::S3::Model::DeleteBucketRequest request;
+    request.SetBucket(bucketName);
+    
+    detail::ExecuteAsync<Aws::S3::Model::DeleteBucketOutcome>(
+        retryController, "DeleteBucket",
+        [client = s3Client, request](auto onOutcome) {
+            client->DeleteBucketAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [bucketName, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome, "Deleted bucket: " + bucketName, "DeleteBucket error"));
+        });
+}
+
+std::future<bool> S3Manager::DeleteBucketAsync(const std::string& bucketName) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        DeleteBucketAsync(bucketName, std::move(done));
+    });
+}
+
+void S3Manager::UploadFileAsync(const std::string& bucketName,
+                                const std::string& keyName,
+                                const std::string& filePath,
+                                CompletionCallback callback) {
+    auto mappedFile = std::make_shared<const MappedFile>(filePath);
+    if (!mappedFile->IsOpen()) {
+        AWSEXAMPLES_LOG(Error, "Failed to open file: " << filePath);
+        callback(false);
+        return;
+    }
+    
+    // Each attempt reads the file through a fresh view of the mapping, which the call keeps alive
+    detail::ExecuteAsync<Aws::S3::Model::PutObjectOutcome>(
+        retryController, "PutObject",
+        [client = s3Client, bucketName, keyName, mappedFile](auto onOutcome) {
+            auto inputData = Aws::MakeShared<MemoryViewStream>("S3Manager", mappedFile);
+            client->PutObjectAsync(MakePutObjectRequest(bucketName, keyName, inputData),
+                                   [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                                       onOutcome(outcome);
+                                   });
+        },
+        [keyName, mappedFile, callback](const auto& outcome) {
+            if (outcome.IsSuccess()) {
+                detail::RecordBytes("PutObject", mappedFile->Size());
+            }
+            callback(detail::ReportOutcome(outcome, "Successfully uploaded: " + keyName, "Upload error"));
+        });
+}
+
+std::future<bool> S3Manager::UploadFileAsync(const std::string& bucketName,
+                                             const std::string& keyName,
+                                             const std::string& filePath) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        UploadFileAsync(bucketName, keyName, filePath, std::move(done));
+    });
+}
+
+void S3Manager::UploadTextAsync(const std::string& bucketName,
+                                const std::string& keyName,
+                                const std::string& content,
+                                CompletionCallback callback) {
+    // The call owns the copy, keeping it alive until the last attempt has been sent
+    auto ownedContent = std::make_shared<const std::string>(content);
+    
+    detail::ExecuteAsync<Aws::S3::Model::PutObjectOutcome>(
+        retryController, "PutObject",
+        [client = s3Client, bucketName, keyName, ownedContent](auto onOutcome) {
+            auto inputData = Aws::MakeShared<MemoryViewStream>("S3Manager", ownedContent->data(), ownedContent->size());
+            client->PutObjectAsync(MakePutObjectRequest(bucketName, keyName, inputData),
+                                   [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                                       onOutcome(outcome);
+                                   });
+        },
+        [keyName, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Successfully uploaded text content as: " + keyName,
+                                           "Text upload error"));
+        });
+}
+
+std::future<bool> S3Manager::UploadTextAsync(const std::string& bucketName,
+                                             const std::string& keyName,
+                                             const std::string& content) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        UploadTextAsync(bucketName, keyName, content, std::move(done));
+    });
+}
+
+void S3Manager::UploadStreamAsync(const std::string& bucketName,
+                                  const std::string& keyName,
+                                  const std::shared_ptr<Aws::IOStream>& body,
+                                  CompletionCallback callback) {
+    // A stream cannot be rewound for a retry, so the upload is sent once
+    auto start = std::chrono::steady_clock::now();
+    s3Client->PutObjectAsync(
+        MakePutObjectRequest(bucketName, keyName, body),
+        [keyName, callback, start](const auto*, const auto&, const auto& outcome, const auto&) {
+            detail::RecordCall("PutObject", start, outcome);
+            callback(detail::ReportOutcome(outcome, "Successfully uploaded: " + keyName, "Upload error"));
+        });
+}
+
+std::future<bool> S3Manager::UploadStreamAsync(const std::string& bucketName,
+                                               const std::string& keyName,
+                                               const std::shared_ptr<Aws::IOStream>& body) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        UploadStreamAsync(bucketName, keyName, body, std::move(done));
+    });
+}
+
+void S3Manager::DownloadFileAsync(const std::string& bucketName,
+                                  const std::string& keyName,
+                                  const std::string& localPath,
+                                  CompletionCallback callback) {
+    Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(bucketName);
+    request.SetKey(keyName);
+    request.SetResponseStreamFactory([localPath]() { return OpenDownloadFile(localPath); });
     
-    auto outcome = s3Client.ListObjectsV2(request);
+    detail::ExecuteAsync<Aws::S3::Model::GetObjectOutcome>(
+        retryController, "GetObject",
+        [client = s3Client, request](auto onOutcome) {
+            client->GetObjectAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [keyName, localPath, callback](const auto& outcome) {
+            if (outcome.IsSuccess()) {
+                // The result still owns the file stream; flush before reporting completion
+                outcome.GetResult().GetBody().flush();
+                detail::RecordBytes("GetObject", static_cast<std::uint64_t>(outcome.GetResult().GetContentLength()));
+            } else {
+                std::remove(localPath.c_str());
+            }
+            callback(detail::ReportOutcome(outcome,
+                                           "Successfully downloaded " + keyName + " to " + localPath,
+                                           "Download error"));
+        });
+}
+
+std::future<bool> S3Manager::DownloadFileAsync(const std::string& bucketName,
+                                               const std::string& keyName,
+                                               const std::string& localPath) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        DownloadFileAsync(bucketName, keyName, localPath, std::move(done));
+    });
+}
+
+void S3Manager::DeleteObjectAsync(const std::string& bucketName,
+                                  const std::string& keyName,
+                                  CompletionCallback callback) {
+    Aws::S3::Model::DeleteObjectRequest request;
+    request.SetBucket(bucketName);
+    request.SetKey(keyName);
+    
+    detail::ExecuteAsync<Aws::S3::Model::DeleteObjectOutcome>(
+        retryController, "DeleteObject",
+        [client = s3Client, request](auto onOutcome) {
+            client->DeleteObjectAsync(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        },
+        [bucketName, keyName, callback](const auto& outcome) {
+            callback(detail::ReportOutcome(outcome,
+                                           "Successfully deleted " + keyName + " from " + bucketName,
+                                           "Delete object error"));
+        });
+}
+
+std::future<bool> S3Manager::DeleteObjectAsync(const std::string& bucketName, const std::string& keyName) {
+    return detail::ToFuture<bool>([&](CompletionCallback done) {
+        DeleteObjectAsync(bucketName, keyName, std::move(done));
+    });
+}
+
+void S3Manager::AbortMultipartUpload(const std::string& bucketName,
+                                     const std::string& keyName,
+                                     const std::string& uploadId) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.SetBucket(bucketName);
+    request.SetKey(keyName);
+    request.SetUploadId(uploadId);
     
+    auto outcome = detail::Execute(*retryController, "AbortMultipartUpload", [&]() {
+        return s3Client->AbortMultipartUpload(request);
+    });
     if (outcome.IsSuccess()) {
-        std::cout << "Objects in " << bucketName << ":" << std::endl;
-        for (const auto& object : outcome.GetResult().GetContents()) {
-            std::cout << "  " << object.GetKey() << " - Size: " << object.GetSize() << " bytes" <<
-                " - Last Modified: " << object.GetLastModified().ToGmtString(Aws::Utils::DateFormat::ISO_8601) << std::endl;
-        }
+        AWSEXAMPLES_LOG(Warn, "Aborted multipart upload of " << keyName);
     } else {
-        std::cerr << "ListObjects error: " << outcome.GetError().GetMessage() << std::endl;
+        AWSEXAMPLES_LOG(Error, "AbortMultipartUpload error: " << outcome.GetError().GetMessage());
     }
 }
 
@@ -0,0 +1,103 @@
+/**
+ * @file S3ObjectLister.cpp
+ * @brief Implementation of the S3ObjectLister class
+ */
+
+#include "awsexamples/S3ObjectLister.h"
+#include "awsexamples/Logger.h"
+#include "RetrySupport.h"
+
+namespace awsexamples {
+
+namespace {
+
+// Request a page in the background through the controller
+std::future<Aws::S3::Model::ListObjectsV2Outcome> RequestPage(
+    const std::shared_ptr<const Aws::S3::S3Client>& client,
+    const std::shared_ptr<utils::RetryController>& controller,
+    const Aws::S3::Model::ListObjectsV2Request& request) {
+    return detail::ExecuteCallable<Aws::S3::Model::ListObjectsV2Outcome>(
+        controller, "ListObjectsV2", [client, request](auto onOutcome) {
+            client->ListObjectsV2Async(request, [onOutcome](const auto*, const auto&, const auto& outcome, const auto&) {
+                onOutcome(outcome);
+            });
+        });
+}
+
+}  // namespace
+
+S3ObjectLister::S3ObjectLister(S3Manager& manager,
+                               const std::string& bucketName,
+                               const ListObjectsOptions& options)
+    : s3Client(manager.s3Client), retryController(manager.retryController), prefetch(options.prefetch) {
+    request.SetBucket(bucketName);
+    if (!options.prefix.empty()) {
+        request.SetPrefix(options.prefix);
+    }
+    if (!options.delimiter.empty()) {
+        request.SetDelimiter(options.delimiter);
+    }
+    if (options.pageSize > 0) {
+        request.SetMaxKeys(options.pageSize);
+    }
+    if (prefetch) {
+        nextPage = RequestPage(s3Client, retryController, request);
+    }
+}
+
+S3ObjectLister::~S3ObjectLister() {
+    // Do not leave a prefetch running against a client the caller may shut down
+    if (nextPage.valid()) {
+        nextPage.wait();
+    }
+}
+
+bool S3ObjectLister::Next(Aws::S3::Model::Object& object) {
+    while (!hasPage || position >= currentPage.GetResult().GetContents().size()) {
+        if (!FetchNextPage()) {
+            return false;
+        }
+    }
+    object = currentPage.GetResult().GetContents()[position++];
+    return true;
+}
+
+bool S3ObjectLister::FetchNextPage() {
+    if (finished) {
+        return false;
+    }
+
+    auto outcome = nextPage.valid()
+                       ? nextPage.get()
+                       : detail::Execute(*retryController, "ListObjectsV2", [&]() {
+                             return s3Client->ListObjectsV2(request);
+                         });
+    if (!outcome.IsSuccess()) {
+        AWSEXAMPLES_LOG(Error, "ListObjectsV2 error: " << outcome.GetError().GetMessage());
+        failed = true;
+        error = outcome.GetError();
+        finished = true;
+        return false;
+    }
+
+    currentPage = std::move(outcome);
+    hasPage = true;
+    position = 0;
+
+    const auto& result = currentPage.GetResult();
+    for (const auto& commonPrefix : result.GetCommonPrefixes()) {
+        commonPrefixes.push_back(commonPrefix.GetPrefix());
+    }
+
+    if (result.GetIsTruncated()) {
+        request.SetContinuationToken(result.GetNextContinuationToken());
+        if (prefetch) {
+            nextPage = RequestPage(s3Client, retryController, request);
+        }
+    } else {
+        finished = true;
+    }
+    return true;
+}
+
+}  // namespace awsexamples
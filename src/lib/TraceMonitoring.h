@@ -0,0 +1,27 @@
+/**
+ * @file TraceMonitoring.h
+ * @brief Internal hook feeding SDK request timings to the Tracer
+ */
+
+#ifndef AWSEXAMPLES_TRACEMONITORING_H
+#define AWSEXAMPLES_TRACEMONITORING_H
+
+#include <aws/core/Aws.h>
+
+namespace awsexamples {
+namespace detail {
+
+/**
+ * @brief Register the monitoring interface that records an Attempt event per HTTP request
+ *
+ * Must be called before Aws::InitAPI with the same options. The interface does
+ * nothing while the Tracer is disabled.
+ *
+ * @param options The options the SDK will be initialized with
+ */
+void InstallTraceMonitoring(Aws::SDKOptions& options);
+
+}  // namespace detail
+}  // namespace awsexamples
+
+#endif  // AWSEXAMPLES_TRACEMONITORING_H
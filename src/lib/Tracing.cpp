@@ -0,0 +1,332 @@
+/**
+ * @file Tracing.cpp
+ * @brief Implementation of the Tracer and TraceScope classes and the SDK monitoring hook
+ */
+
+#include "awsexamples/Tracing.h"
+#include "TraceMonitoring.h"
+#include <aws/core/monitoring/HttpClientMetrics.h>
+#include <aws/core/monitoring/MonitoringFactory.h>
+#include <aws/core/monitoring/MonitoringInterface.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace awsexamples {
+namespace utils {
+
+namespace {
+
+// Give each thread a small, stable ID for the trace's thread lanes
+std::uint32_t CurrentThreadId() {
+    static std::atomic<std::uint32_t> nextId{1};
+    thread_local const std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void WriteJsonString(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Write one complete ("X") event; args is a JSON object or empty
+void WriteSpan(std::ostream& out, bool& first, const std::string& name, const char* category, std::uint32_t thread,
+               std::int64_t timestamp, std::int64_t duration, const std::string& args) {
+    out << (first ? "\n" : ",\n") << "{\"name\":";
+    first = false;
+    WriteJsonString(out, name);
+    out << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"ts\":" << timestamp << ",\"dur\":" << duration
+        << ",\"pid\":1,\"tid\":" << thread;
+    if (!args.empty()) {
+        out << ",\"args\":" << args;
+    }
+    out << '}';
+}
+
+// Write the phases of an attempt as slices nested in its span
+void WritePhases(std::ostream& out, bool& first, const TraceEvent& event, std::int64_t timestamp) {
+    const std::int64_t duration = event.duration.count();
+    auto offset = [duration](std::int64_t millis) { return std::min(millis * 1000, duration); };
+
+    std::int64_t setupEnd = 0;
+    if (event.dnsMillis > 0) {
+        setupEnd = offset(event.dnsMillis);
+        WriteSpan(out, first, "dns", "phase", event.thread, timestamp, setupEnd, "");
+    }
+    if (event.tlsMillis > 0 && offset(event.tlsMillis) > setupEnd) {
+        WriteSpan(out, first, "connect", "phase", event.thread, timestamp + setupEnd,
+                  offset(event.tlsMillis) - setupEnd, "");
+        setupEnd = offset(event.tlsMillis);
+    }
+    if (event.firstByteMillis >= 0 && offset(event.firstByteMillis) >= setupEnd) {
+        const std::int64_t firstByte = offset(event.firstByteMillis);
+        WriteSpan(out, first, "wait", "phase", event.thread, timestamp + setupEnd, firstByte - setupEnd, "");
+        WriteSpan(out, first, "transfer", "phase", event.thread, timestamp + firstByte, duration - firstByte, "");
+    }
+}
+
+}  // namespace
+
+Tracer& Tracer::Instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::Enable(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ring.assign(std::max<std::size_t>(capacity, 1), TraceEvent());
+    next = 0;
+    recorded = 0;
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Disable() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::Record(const TraceEvent& event) {
+    if (!IsEnabled()) {
+        return;
+    }
+    const std::uint32_t thread = CurrentThreadId();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ring.empty()) {
+        return;
+    }
+    // Copying into the slot reuses its string storage
+    TraceEvent& slot = ring[next];
+    slot = event;
+    slot.thread = thread;
+    next = (next + 1) % ring.size();
+    ++recorded;
+}
+
+std::vector<TraceEvent> Tracer::Events() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TraceEvent> events;
+    if (recorded < ring.size()) {
+        events.assign(ring.begin(), ring.begin() + static_cast<std::ptrdiff_t>(recorded));
+    } else {
+        events.assign(ring.begin() + static_cast<std::ptrdiff_t>(next), ring.end());
+        events.insert(events.end(), ring.begin(), ring.begin() + static_cast<std::ptrdiff_t>(next));
+    }
+    return events;
+}
+
+std::uint64_t Tracer::GetOverwritten() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recorded > ring.size() ? recorded - ring.size() : 0;
+}
+
+void Tracer::WriteChromeTrace(std::ostream& out) const {
+    const auto events = Events();
+
+    // Timestamps are relative to the earliest span
+    auto origin = std::chrono::steady_clock::time_point::max();
+    for (const auto& event : events) {
+        origin = std::min(origin, event.start);
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        const std::int64_t timestamp =
+            std::chrono::duration_cast<std::chrono::microseconds>(event.start - origin).count();
+        std::ostringstream args;
+        const char* category = "scope";
+        switch (event.kind) {
+            case TraceKind::Operation:
+                category = "operation";
+                args << "{\"attempts\":" << event.attempts << ",\"retry_delay_us\":" << event.retryDelay.count();
+                break;
+            case TraceKind::Attempt:
+                category = "attempt";
+                args << "{\"service\":";
+                WriteJsonString(args, event.service);
+                args << ",\"status\":" << event.status << ",\"dns_ms\":" << event.dnsMillis
+                     << ",\"tls_ms\":" << event.tlsMillis << ",\"first_byte_ms\":" << event.firstByteMillis;
+                break;
+            case TraceKind::Scope:
+                break;
+        }
+        if (!event.errorType.empty()) {
+            args << (args.tellp() > 0 ? "," : "{") << "\"error\":";
+            WriteJsonString(args, event.errorType);
+        }
+        if (args.tellp() > 0) {
+            args << '}';
+        }
+
+        WriteSpan(out, first, event.name, category, event.thread, timestamp, event.duration.count(), args.str());
+        if (event.kind == TraceKind::Attempt) {
+            WritePhases(out, first, event, timestamp);
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool Tracer::DumpToFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    WriteChromeTrace(file);
+    return static_cast<bool>(file.flush());
+}
+
+TraceScope::TraceScope(const char* name)
+    : name(Tracer::Instance().IsEnabled() ? name : nullptr),
+      start(this->name != nullptr ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()) {}
+
+TraceScope::~TraceScope() {
+    if (name == nullptr) {
+        return;
+    }
+    TraceEvent event;
+    event.kind = TraceKind::Scope;
+    event.name = name;
+    event.start = start;
+    event.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    Tracer::Instance().Record(event);
+}
+
+}  // namespace utils
+
+namespace detail {
+
+namespace {
+
+// Allocation tag for the SDK's memory system
+constexpr char kTraceTag[] = "TraceMonitoring";
+
+/// Per-call state the SDK hands back to each callback
+struct AttemptContext {
+    std::chrono::steady_clock::time_point attemptStart;  ///< When the current attempt began
+};
+
+// Get a timing from the HTTP client's metrics, or -1 if it did not report it
+std::int64_t HttpClientMetric(const Aws::Monitoring::CoreMetricsCollection& metrics,
+                              Aws::Monitoring::HttpClientMetricsType type) {
+    auto found = metrics.httpClientMetrics.find(Aws::Monitoring::GetHttpClientMetricNameByType(type));
+    return found != metrics.httpClientMetrics.end() ? found->second : -1;
+}
+
+/**
+ * @class TraceMonitoring
+ * @brief Records an Attempt event for each HTTP request the SDK sends
+ *
+ * The SDK calls OnRequestStarted once per call and OnRequestSucceeded or
+ * OnRequestFailed after each attempt, on the thread that sent it.
+ */
+class TraceMonitoring : public Aws::Monitoring::MonitoringInterface {
+public:
+    void* OnRequestStarted(const Aws::String&,
+                           const Aws::String&,
+                           const std::shared_ptr<const Aws::Http::HttpRequest>&) const override {
+        if (!utils::Tracer::Instance().IsEnabled()) {
+            return nullptr;
+        }
+        return Aws::New<AttemptContext>(kTraceTag, AttemptContext{std::chrono::steady_clock::now()});
+    }
+
+    void OnRequestSucceeded(const Aws::String& serviceName,
+                            const Aws::String& requestName,
+                            const std::shared_ptr<const Aws::Http::HttpRequest>&,
+                            const Aws::Client::HttpResponseOutcome& outcome,
+                            const Aws::Monitoring::CoreMetricsCollection& metricsFromCore,
+                            void* context) const override {
+        const int status = outcome.GetResult() ? static_cast<int>(outcome.GetResult()->GetResponseCode()) : 0;
+        RecordAttempt(serviceName, requestName, status, "", metricsFromCore, context);
+    }
+
+    void OnRequestFailed(const Aws::String& serviceName,
+                         const Aws::String& requestName,
+                         const std::shared_ptr<const Aws::Http::HttpRequest>&,
+                         const Aws::Client::HttpResponseOutcome& outcome,
+                         const Aws::Monitoring::CoreMetricsCollection& metricsFromCore,
+                         void* context) const override {
+        const auto& error = outcome.GetError();
+        RecordAttempt(serviceName, requestName, std::max(static_cast<int>(error.GetResponseCode()), 0),
+                      error.GetExceptionName(), metricsFromCore, context);
+    }
+
+    void OnRequestRetry(const Aws::String&,
+                        const Aws::String&,
+                        const std::shared_ptr<const Aws::Http::HttpRequest>&,
+                        void* context) const override {
+        if (context != nullptr) {
+            static_cast<AttemptContext*>(context)->attemptStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    void OnFinish(const Aws::String&,
+                  const Aws::String&,
+                  const std::shared_ptr<const Aws::Http::HttpRequest>&,
+                  void* context) const override {
+        Aws::Delete(static_cast<AttemptContext*>(context));
+    }
+
+private:
+    static void RecordAttempt(const Aws::String& serviceName,
+                              const Aws::String& requestName,
+                              int status,
+                              const Aws::String& errorType,
+                              const Aws::Monitoring::CoreMetricsCollection& metrics,
+                              void* context) {
+        if (context == nullptr) {
+            return;
+        }
+        using Aws::Monitoring::HttpClientMetricsType;
+        const auto end = std::chrono::steady_clock::now();
+
+        // The SDK's own measure of the request excludes the backoff before a retry
+        auto start = static_cast<AttemptContext*>(context)->attemptStart;
+        const std::int64_t requestMillis = HttpClientMetric(metrics, HttpClientMetricsType::RequestLatency);
+        if (requestMillis >= 0) {
+            start = std::max(start, end - std::chrono::milliseconds(requestMillis));
+        }
+
+        utils::TraceEvent event;
+        event.kind = utils::TraceKind::Attempt;
+        event.name = requestName;
+        event.service = serviceName;
+        event.errorType = errorType;
+        event.start = start;
+        event.duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        event.status = status;
+        // Times since the request began; the curl client reports its start-transfer
+        // time, when the first response byte arrived, as ConnectLatency
+        event.dnsMillis = HttpClientMetric(metrics, HttpClientMetricsType::DnsLatency);
+        event.tlsMillis = HttpClientMetric(metrics, HttpClientMetricsType::SslLatency);
+        event.firstByteMillis = HttpClientMetric(metrics, HttpClientMetricsType::ConnectLatency);
+        utils::Tracer::Instance().Record(event);
+    }
+};
+
+class TraceMonitoringFactory : public Aws::Monitoring::MonitoringFactory {
+public:
+    Aws::UniquePtr<Aws::Monitoring::MonitoringInterface> CreateMonitoringInstance() const override {
+        return Aws::MakeUnique<TraceMonitoring>(kTraceTag);
+    }
+};
+
+}  // namespace
+
+void InstallTraceMonitoring(Aws::SDKOptions& options) {
+    options.monitoringOptions.customizedMonitoringFactory_create_fn.push_back(
+        []() -> Aws::UniquePtr<Aws::Monitoring::MonitoringFactory> {
+            return Aws::MakeUnique<TraceMonitoringFactory>(kTraceTag);
+        });
+}
+
+}  // namespace detail
+}  // namespace awsexamples
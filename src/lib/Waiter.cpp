@@ -0,0 +1,87 @@
+/**
+ * @file Waiter.cpp
+ * @brief Implementation of the Waiter class
+ */
+
+#include "awsexamples/Waiter.h"
+#include <utility>
+
+namespace awsexamples {
+
+Waiter& Waiter::Instance() {
+    static Waiter waiter;
+    return waiter;
+}
+
+Waiter::~Waiter() {
+    Shutdown();
+}
+
+void Waiter::Schedule(std::chrono::milliseconds delay, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!stopping) {
+            tasks.emplace(Clock::now() + delay, std::move(task));
+            if (!thread.joinable()) {
+                thread = std::thread(&Waiter::Run, this);
+            }
+            wakeup.notify_one();
+            return;
+        }
+    }
+
+    // Scheduled while shutting down
+    task(false);
+}
+
+void Waiter::Shutdown() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        worker = std::move(thread);
+    }
+    wakeup.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    std::multimap<Clock::time_point, Task> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelled.swap(tasks);
+        stopping = false;
+    }
+    for (auto& entry : cancelled) {
+        entry.second(false);
+    }
+}
+
+std::size_t Waiter::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size();
+}
+
+void Waiter::Run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (tasks.empty()) {
+            wakeup.wait(lock);
+            continue;
+        }
+
+        auto next = tasks.begin();
+        if (next->first > Clock::now()) {
+            wakeup.wait_until(lock, next->first);
+            continue;
+        }
+
+        Task task = std::move(next->second);
+        tasks.erase(next);
+        lock.unlock();
+        task(true);
+        lock.lock();
+    }
+}
+
+}  // namespace awsexamples
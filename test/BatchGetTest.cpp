@@ -0,0 +1,186 @@
+/**
+ * @file BatchGetTest.cpp
+ * @brief Test cases for DynamoDBManager::GetItems and GetItemCoalescer against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/GetItemCoalescer.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Counters of the mock endpoint
+struct MockTable {
+    std::mutex mutex;
+    int batchGetRequests = 0;
+    std::size_t largestBatch = 0;
+    bool unprocessedReturned = false;
+};
+
+// Items exist for even IDs only
+bool ItemExists(const std::string& id) {
+    return std::stoi(id) % 2 == 0;
+}
+
+// Answer BatchGetItem for BatchTable, returning half of the first request's keys as unprocessed
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table,
+                                             const std::string& operation,
+                                             const MockDynamoDB::Request& request) {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (operation != "BatchGetItem") {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Unsupported");
+    }
+
+    std::vector<std::string> ids;
+    const std::string marker = "\"id\":{\"S\":\"";
+    for (std::size_t at = request.body.find(marker); at != std::string::npos; at = request.body.find(marker, at)) {
+        at += marker.size();
+        ids.push_back(request.body.substr(at, request.body.find('"', at) - at));
+    }
+    ++table.batchGetRequests;
+    table.largestBatch = std::max(table.largestBatch, ids.size());
+
+    std::size_t processed = ids.size();
+    if (!table.unprocessedReturned && ids.size() > 1) {
+        table.unprocessedReturned = true;
+        processed = ids.size() / 2;
+    }
+
+    std::string items;
+    for (std::size_t i = 0; i < processed; ++i) {
+        if (ItemExists(ids[i])) {
+            items += (items.empty() ? "" : ",") + std::string("{\"id\":{\"S\":\"") + ids[i] +
+                     "\"},\"name\":{\"S\":\"Item " + ids[i] + "\"}}";
+        }
+    }
+    std::string unprocessed;
+    for (std::size_t i = processed; i < ids.size(); ++i) {
+        unprocessed += (unprocessed.empty() ? "" : ",") + std::string("{\"id\":{\"S\":\"") + ids[i] + "\"}}";
+    }
+
+    std::string body = "{\"Responses\":{\"BatchTable\":[" + items + "]}";
+    if (!unprocessed.empty()) {
+        body += ",\"UnprocessedKeys\":{\"BatchTable\":{\"Keys\":[" + unprocessed + "]}}";
+    }
+    return MockDynamoDB::Reply(body + "}");
+}
+
+// Test multi-key lookups and coalescing against the mock endpoint
+bool TestBatchGet(const MockDynamoDB& dynamo, MockTable& table) {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Batch Get Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions options = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(options));
+
+    // Unprocessed keys slow BatchGetItem down; keep the floor high enough for the test
+    awsexamples::utils::RetryOptions retryOptions;
+    retryOptions.minRate = 100;
+    auto controller = std::make_shared<awsexamples::utils::RetryController>(retryOptions);
+    dynamoManager.SetRetryController(controller);
+
+    auto batchGetRequests = [&table]() {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.batchGetRequests;
+    };
+
+    // 250 distinct keys take three batches plus one resubmission of unprocessed keys
+    std::cout << "\n1. Multi-key lookup:" << std::endl;
+    std::vector<std::string> ids;
+    for (int i = 0; i < 250; ++i) {
+        ids.push_back(std::to_string(i));
+    }
+    ids.push_back("0");  // Duplicates are looked up once
+    awsexamples::ItemMap items;
+    bool complete = dynamoManager.GetItems("BatchTable", ids, items).success;
+    bool itemsCorrect = items.size() == 125;
+    for (const auto& item : items) {
+        itemsCorrect = itemsCorrect && ItemExists(item.first) && item.second.at("name").GetS() == "Item " + item.first;
+    }
+    if (!complete || !itemsCorrect || batchGetRequests() != 4 || table.largestBatch > 100 ||
+        controller->GetCounters()["BatchGetItem"].throttled != 1) {
+        std::cerr << "FAILED: Got " << items.size() << " items with " << batchGetRequests() << " requests" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Got " << items.size() << " items with " << batchGetRequests() << " requests" << std::endl;
+    }
+
+    // Concurrent single-key lookups share batches
+    std::cout << "\n2. Coalesced lookups:" << std::endl;
+    int before = batchGetRequests();
+    awsexamples::CoalescerOptions coalescerOptions;
+    coalescerOptions.window = std::chrono::milliseconds(20);
+    awsexamples::CoalescerStats stats;
+    bool lookupsCorrect = true;
+    {
+        awsexamples::GetItemCoalescer coalescer(dynamoManager, "BatchTable", coalescerOptions);
+        std::vector<std::future<awsexamples::GetItemResult>> lookups(64);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&coalescer, &lookups, t]() {
+                for (int i = 0; i < 8; ++i) {
+                    // Threads look up overlapping keys
+                    lookups[t * 8 + i] = coalescer.Get(std::to_string((t * 8 + i) % 40));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (std::size_t i = 0; i < lookups.size(); ++i) {
+            auto result = lookups[i].get();
+            std::string id = std::to_string(i % 40);
+            bool expected = ItemExists(id) ? result.item.count("name") && result.item.at("name").GetS() == "Item " + id
+                                           : result.item.empty();
+            lookupsCorrect = lookupsCorrect && result.success && expected;
+        }
+        stats = coalescer.GetStats();
+    }
+    int requests = batchGetRequests() - before;
+    if (!lookupsCorrect || stats.lookups != 64 || stats.keys > 64 || requests >= 64 || requests == 0) {
+        std::cerr << "FAILED: " << stats.lookups << " lookups sent " << requests << " requests" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << stats.lookups << " lookups of " << stats.keys << " keys sent " << requests
+                  << " requests in " << stats.batches << " batches" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = false;
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestBatchGet(dynamo, table);
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
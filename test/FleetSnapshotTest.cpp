@@ -0,0 +1,274 @@
+/**
+ * @file FleetSnapshotTest.cpp
+ * @brief Test cases for the StringPool and FleetSnapshot classes
+ */
+
+#include "awsexamples/FleetSnapshot.h"
+#include "awsexamples/AwsUtils.h"
+#include <aws/core/utils/DateTime.h>
+#include <aws/ec2/model/Instance.h>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using awsexamples::FleetFilter;
+using awsexamples::FleetSnapshot;
+using awsexamples::StringPool;
+
+// Build an instance as DescribeInstances would return it
+Aws::EC2::Model::Instance MakeInstance(const std::string& instanceId,
+                                       Aws::EC2::Model::InstanceStateName state,
+                                       Aws::EC2::Model::InstanceType type,
+                                       std::int64_t launchTime,
+                                       const std::vector<std::pair<std::string, std::string>>& tags) {
+    Aws::EC2::Model::InstanceState instanceState;
+    instanceState.SetName(state);
+
+    Aws::Vector<Aws::EC2::Model::Tag> instanceTags;
+    for (const auto& tag : tags) {
+        Aws::EC2::Model::Tag instanceTag;
+        instanceTag.SetKey(tag.first);
+        instanceTag.SetValue(tag.second);
+        instanceTags.push_back(instanceTag);
+    }
+
+    Aws::EC2::Model::Instance instance;
+    instance.SetInstanceId(instanceId);
+    instance.SetState(instanceState);
+    instance.SetInstanceType(type);
+    instance.SetLaunchTime(Aws::Utils::DateTime(launchTime));
+    instance.SetTags(instanceTags);
+    return instance;
+}
+
+// Select the IDs of the instances matching a filter
+std::vector<std::string> SelectIds(const FleetSnapshot& snapshot, const FleetFilter& filter) {
+    std::vector<std::string> ids;
+    for (std::size_t row : snapshot.Select(filter)) {
+        ids.push_back(snapshot.InstanceId(row));
+    }
+    return ids;
+}
+
+// Test interning without any snapshot
+bool TestStringPool() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== StringPool Test ===" << std::endl;
+
+    std::cout << "\n1. Interning:" << std::endl;
+    StringPool pool;
+    StringPool::Id running = pool.Intern("running");
+    StringPool::Id stopped = pool.Intern("stopped");
+    StringPool::Id runningAgain = pool.Intern(std::string("run") + "ning");
+    StringPool::Id found = stopped;
+    bool foundRunning = pool.Find("running", found) && found == running;
+    bool foundPending = pool.Find("pending", found);
+    if (running != runningAgain || running == stopped || pool.Size() != 2 || !foundRunning || foundPending ||
+        pool.Get(running) != "running" || pool.Get(stopped) != "stopped") {
+        std::cerr << "FAILED: Equal strings did not share one ID" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Equal strings shared one ID and lookups did not intern" << std::endl;
+    }
+
+    // References stay valid while the pool grows and after it is moved
+    std::cout << "\n2. Stable references:" << std::endl;
+    const std::string& first = pool.Get(running);
+    for (int i = 0; i < 10000; ++i) {
+        pool.Intern("tag-" + std::to_string(i));
+    }
+    StringPool moved = std::move(pool);
+    if (&first != &moved.Get(running) || first != "running" || moved.Intern("tag-42") != 44 ||
+        moved.Size() != 10002) {
+        std::cerr << "FAILED: An interned string moved as the pool grew" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << moved.Size() << " strings were interned without moving the first" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test adding instances and selecting them by state, type, region and tag
+bool TestSelect() {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== FleetSnapshot Select Test ===" << std::endl;
+
+    using Aws::EC2::Model::InstanceStateName;
+    using Aws::EC2::Model::InstanceType;
+    FleetSnapshot snapshot;
+    snapshot.Add(MakeInstance("i-1", InstanceStateName::running, InstanceType::t2_micro, 1000,
+                              {{"env", "prod"}, {"team", "web"}}),
+                 "us-east-1");
+    snapshot.Add(MakeInstance("i-2", InstanceStateName::stopped, InstanceType::t2_micro, 2000, {{"env", "dev"}}),
+                 "us-east-1");
+    snapshot.Add(MakeInstance("i-3", InstanceStateName::running, InstanceType::t3_micro, 3000, {{"env", "prod"}}),
+                 "us-west-2");
+    snapshot.Add(MakeInstance("i-4", InstanceStateName::running, InstanceType::t2_micro, 4000, {}), "us-west-2");
+
+    // Adding an instance again keeps its first row
+    std::cout << "\n3. Rows:" << std::endl;
+    snapshot.Add(MakeInstance("i-1", InstanceStateName::stopped, InstanceType::t3_micro, 5000, {}), "us-west-2");
+    std::size_t row = 0;
+    std::string env;
+    bool foundFirst = snapshot.Find("i-1", row) && row == 0;
+    if (snapshot.Size() != 4 || !foundFirst || snapshot.State(0) != "running" ||
+        snapshot.InstanceType(0) != "t2.micro" || snapshot.Region(0) != "us-east-1" || snapshot.LaunchTime(0) != 1000 ||
+        !snapshot.GetTag(0, "env", env) || env != "prod" || snapshot.GetTags(0).size() != 2 ||
+        snapshot.GetTag(3, "env", env) || snapshot.Find("i-5", row)) {
+        std::cerr << "FAILED: The rows did not hold the instances as added" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << snapshot.Size() << " rows held the instances as added" << std::endl;
+    }
+
+    std::cout << "\n4. Filters:" << std::endl;
+    FleetFilter all;
+    FleetFilter running;
+    running.state = "running";
+    FleetFilter runningMicro = running;
+    runningMicro.instanceType = "t2.micro";
+    FleetFilter west;
+    west.region = "us-west-2";
+    FleetFilter prod;
+    prod.tagKey = "env";
+    prod.tagValue = "prod";
+    FleetFilter tagged;
+    tagged.tagKey = "team";
+    FleetFilter runningDev = running;
+    runningDev.tagKey = "env";
+    runningDev.tagValue = "dev";
+    using Ids = std::vector<std::string>;
+    std::vector<std::pair<FleetFilter, Ids>> cases = {
+        {all, {"i-1", "i-2", "i-3", "i-4"}},
+        {running, {"i-1", "i-3", "i-4"}},
+        {runningMicro, {"i-1", "i-4"}},
+        {west, {"i-3", "i-4"}},
+        {prod, {"i-1", "i-3"}},
+        {tagged, {"i-1"}},
+        {runningDev, {}},
+    };
+    std::size_t matched = 0;
+    for (const auto& filterCase : cases) {
+        Ids ids = SelectIds(snapshot, filterCase.first);
+        if (ids != filterCase.second) {
+            std::cerr << "FAILED: A filter selected " << ids.size() << " instances instead of "
+                      << filterCase.second.size() << std::endl;
+            allTestsPassed = false;
+        } else {
+            ++matched;
+        }
+    }
+    if (matched == cases.size()) {
+        std::cout << "PASSED: " << matched << " filters selected the expected rows in order" << std::endl;
+    }
+
+    // A value no instance has matches nothing
+    std::cout << "\n5. Unknown values:" << std::endl;
+    FleetFilter pending;
+    pending.state = "pending";
+    FleetFilter unknownTag;
+    unknownTag.tagKey = "owner";
+    FleetFilter unknownValue;
+    unknownValue.tagKey = "env";
+    unknownValue.tagValue = "test";
+    if (!snapshot.Select(pending).empty() || !snapshot.Select(unknownTag).empty() ||
+        !snapshot.Select(unknownValue).empty()) {
+        std::cerr << "FAILED: A filter on a value no instance has selected rows" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Filters on values no instance has selected nothing" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test merging snapshots whose string pools were interned in different orders
+bool TestAppend() {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== FleetSnapshot Append Test ===" << std::endl;
+
+    using Aws::EC2::Model::InstanceStateName;
+    using Aws::EC2::Model::InstanceType;
+    FleetSnapshot east;
+    east.Add(MakeInstance("i-1", InstanceStateName::running, InstanceType::t2_micro, 1000, {{"env", "prod"}}),
+             "us-east-1");
+    east.Add(MakeInstance("i-2", InstanceStateName::stopped, InstanceType::t3_micro, 2000, {}), "us-east-1");
+
+    // Interns the same strings as the east snapshot, in a different order
+    FleetSnapshot west;
+    west.Add(MakeInstance("i-3", InstanceStateName::stopped, InstanceType::t3_micro, 3000,
+                          {{"team", "dev"}, {"env", "prod"}}),
+             "us-west-2");
+    west.Add(MakeInstance("i-4", InstanceStateName::running, InstanceType::t2_micro, 4000, {{"env", "dev"}}),
+             "us-west-2");
+    west.Add(MakeInstance("i-1", InstanceStateName::running, InstanceType::t2_micro, 1000, {{"env", "prod"}}),
+             "us-west-2");
+
+    FleetSnapshot fleet;
+    fleet.Append(east);
+    fleet.Append(west);
+
+    std::cout << "\n6. Appended rows:" << std::endl;
+    std::size_t row = 0;
+    std::string team;
+    bool translated = fleet.Size() == 4 && fleet.Find("i-3", row) && row == 2 && fleet.State(row) == "stopped" &&
+                      fleet.InstanceType(row) == "t3.micro" && fleet.Region(row) == "us-west-2" &&
+                      fleet.LaunchTime(row) == 3000 && fleet.GetTag(row, "team", team) && team == "dev" &&
+                      fleet.GetTags(row) == std::vector<std::pair<std::string, std::string>>{{"team", "dev"},
+                                                                                             {"env", "prod"}};
+    bool firstKept = fleet.Find("i-1", row) && row == 0 && fleet.Region(row) == "us-east-1";
+    if (!translated || !firstKept) {
+        std::cerr << "FAILED: The appended rows did not keep their values" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << fleet.Size() << " rows kept their values and the duplicate was ignored" << std::endl;
+    }
+
+    // Filters compare IDs of the merged pool, so they match rows from both snapshots
+    std::cout << "\n7. Filters across appended rows:" << std::endl;
+    FleetFilter stopped;
+    stopped.state = "stopped";
+    FleetFilter prod;
+    prod.tagKey = "env";
+    prod.tagValue = "prod";
+    FleetFilter dev;
+    dev.tagKey = "env";
+    dev.tagValue = "dev";
+    if (SelectIds(fleet, stopped) != std::vector<std::string>{"i-2", "i-3"} ||
+        SelectIds(fleet, prod) != std::vector<std::string>{"i-1", "i-3"} ||
+        SelectIds(fleet, dev) != std::vector<std::string>{"i-4"}) {
+        std::cerr << "FAILED: Filters did not match rows from both snapshots" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Filters matched rows from both snapshots" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    bool testResult = TestStringPool();
+    {
+        // Initialize AWS SDK for the EC2 model types
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestSelect() && testResult;
+        testResult = TestAppend() && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
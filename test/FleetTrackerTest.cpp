@@ -0,0 +1,335 @@
+/**
+ * @file FleetTrackerTest.cpp
+ * @brief Test cases for the FleetTracker class and the EC2 fleet operations, against a mock EC2 endpoint
+ */
+
+#include "awsexamples/EC2Manager.h"
+#include "awsexamples/FleetTracker.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/RetryController.h"
+#include "MockHttpServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// In-memory fleet served by the mock endpoint
+struct MockFleet {
+    struct Instance {
+        std::string state;
+        std::string type;
+        std::string team;
+    };
+    
+    std::mutex mutex;
+    std::map<std::string, Instance> instances;
+    bool failNextRequest = false;
+    int pageSize = 2;
+    int throttleStateChanges = 0;  // StopInstances requests still to be throttled
+    int stateChangeRequests = 0;
+};
+
+std::string InstanceXml(const std::string& instanceId, const MockFleet::Instance& instance) {
+    return "<item><instanceId>" + instanceId + "</instanceId>"
+           "<instanceState><code>0</code><name>" + instance.state + "</name></instanceState>"
+           "<instanceType>" + instance.type + "</instanceType>"
+           "<launchTime>2026-01-01T00:00:00.000Z</launchTime>"
+           "<tagSet><item><key>team</key><value>" + instance.team + "</value></item></tagSet></item>";
+}
+
+// Answer StopInstances, failing the whole request if it is throttled or names an unknown instance
+MockHttpServer::Response HandleStopInstances(MockFleet& fleet, const MockHttpServer::Request& request) {
+    MockHttpServer::Response response;
+    ++fleet.stateChangeRequests;
+    
+    bool unknown = false;
+    std::string items;
+    for (const auto& param : request.params) {
+        if (param.first.rfind("InstanceId.", 0) == 0) {
+            unknown = unknown || fleet.instances.count(param.second) == 0;
+            items += "<item><instanceId>" + param.second + "</instanceId>"
+                     "<currentState><code>64</code><name>stopping</name></currentState>"
+                     "<previousState><code>16</code><name>running</name></previousState></item>";
+        }
+    }
+    
+    std::string error;
+    if (fleet.throttleStateChanges > 0) {
+        --fleet.throttleStateChanges;
+        response.status = 503;
+        error = "RequestLimitExceeded";
+    } else if (unknown) {
+        response.status = 400;
+        error = "InvalidInstanceID.NotFound";
+    }
+    if (!error.empty()) {
+        response.body = "<Response><Errors><Error><Code>" + error + "</Code><Message>Mock " + error +
+                        "</Message></Error></Errors><RequestID>mock</RequestID></Response>";
+    } else {
+        response.body = "<StopInstancesResponse xmlns=\"http://ec2.amazonaws.com/doc/2016-11-15/\">"
+                        "<requestId>mock</requestId><instancesSet>" + items + "</instancesSet></StopInstancesResponse>";
+    }
+    return response;
+}
+
+// Answer DescribeInstances with pages of fleet.pageSize instances, honouring instance-id filters
+MockHttpServer::Response HandleEc2Request(MockFleet& fleet, const MockHttpServer::Request& request) {
+    std::lock_guard<std::mutex> lock(fleet.mutex);
+    MockHttpServer::Response response;
+    
+    auto action = request.params.find("Action");
+    if (action != request.params.end() && action->second == "StopInstances") {
+        return HandleStopInstances(fleet, request);
+    }
+    if (fleet.failNextRequest || action == request.params.end() || action->second != "DescribeInstances") {
+        fleet.failNextRequest = false;
+        response.status = 500;
+        response.body = "<Response><Errors><Error><Code>InternalError</Code>"
+                        "<Message>Mock failure</Message></Error></Errors><RequestID>mock</RequestID></Response>";
+        return response;
+    }
+    
+    std::vector<std::string> wanted;
+    for (const auto& param : request.params) {
+        if (param.first.rfind("Filter.1.Value.", 0) == 0) {
+            wanted.push_back(param.second);
+        }
+    }
+    
+    std::vector<std::string> matching;
+    for (const auto& instance : fleet.instances) {
+        if (wanted.empty() || std::find(wanted.begin(), wanted.end(), instance.first) != wanted.end()) {
+            matching.push_back(instance.first);
+        }
+    }
+    
+    std::size_t offset = 0;
+    auto token = request.params.find("NextToken");
+    if (token != request.params.end()) {
+        offset = std::stoul(token->second);
+    }
+    std::size_t end = std::min(matching.size(), offset + static_cast<std::size_t>(fleet.pageSize));
+    
+    std::string items;
+    for (std::size_t i = offset; i < end; ++i) {
+        items += InstanceXml(matching[i], fleet.instances[matching[i]]);
+    }
+    response.body = "<DescribeInstancesResponse xmlns=\"http://ec2.amazonaws.com/doc/2016-11-15/\">"
+                    "<requestId>mock</requestId><reservationSet><item><reservationId>r-mock</reservationId>"
+                    "<instancesSet>" + items + "</instancesSet></item></reservationSet>";
+    if (end < matching.size()) {
+        response.body += "<nextToken>" + std::to_string(end) + "</nextToken>";
+    }
+    response.body += "</DescribeInstancesResponse>";
+    return response;
+}
+
+bool Contains(const std::vector<std::string>& values, const std::string& value) {
+    return std::find(values.begin(), values.end(), value) != values.end();
+}
+
+// Test FleetTracker and the fleet-wide EC2Manager operations against the mock endpoint
+bool TestFleetTracker(const std::string& endpoint, MockFleet& fleet) {
+    bool allTestsPassed = true;
+    
+    std::cout << "=== FleetTracker Test ===" << std::endl;
+    std::cout << "Using mock EC2 endpoint: " << endpoint << std::endl;
+    
+    awsexamples::utils::ClientOptions options;
+    options.region = "us-east-1";
+    options.endpointOverride = endpoint;
+    options.requestTimeoutMs = 5000;
+    awsexamples::EC2Manager ec2Manager(awsexamples::utils::ConfigureClient(options));
+    awsexamples::FleetTracker tracker(ec2Manager);
+    awsexamples::FleetDiff diff;
+    
+    // The first refresh reports the whole fleet, following pagination
+    std::cout << "\n1. Initial refresh:" << std::endl;
+    if (!tracker.Refresh(diff) || diff.added.size() != 5 || !diff.removed.empty() || !diff.stateChanged.empty()) {
+        std::cerr << "FAILED: Initial refresh did not report 5 added instances" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Initial refresh reported " << diff.added.size() << " added instances" << std::endl;
+    }
+    
+    // Filtering the snapshot uses interned columns
+    awsexamples::FleetFilter filter;
+    filter.state = "running";
+    filter.tagKey = "team";
+    filter.tagValue = "blue";
+    auto rows = tracker.GetSnapshot().Select(filter);
+    if (rows.size() != 2 || tracker.GetSnapshot().InstanceType(rows[0]) != "t3.micro") {
+        std::cerr << "FAILED: Snapshot filter returned " << rows.size() << " rows, expected 2" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Snapshot filter found the running blue instances" << std::endl;
+    }
+    
+    // Nothing changed
+    std::cout << "\n2. Refresh without changes:" << std::endl;
+    if (!tracker.Refresh(diff) || !diff.Empty()) {
+        std::cerr << "FAILED: Unchanged fleet produced a non-empty diff" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Unchanged fleet produced an empty diff" << std::endl;
+    }
+    
+    // One instance stops, one is removed and one is added
+    std::cout << "\n3. Refresh after churn:" << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(fleet.mutex);
+        fleet.instances["i-0000000000000001"].state = "stopped";
+        fleet.instances.erase("i-0000000000000002");
+        fleet.instances["i-0000000000000006"] = {"pending", "t3.large", "red"};
+    }
+    if (!tracker.Refresh(diff) ||
+        diff.added != std::vector<std::string>{"i-0000000000000006"} ||
+        diff.removed != std::vector<std::string>{"i-0000000000000002"} ||
+        diff.stateChanged.size() != 1 ||
+        diff.stateChanged[0].instanceId != "i-0000000000000001" ||
+        diff.stateChanged[0].previousState != "running" ||
+        diff.stateChanged[0].currentState != "stopped") {
+        std::cerr << "FAILED: Diff did not report exactly the changed instances" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Diff reported one added, one removed and one state change" << std::endl;
+    }
+    
+    // A failed poll keeps the previous snapshot, so the changes are reported later
+    std::cout << "\n4. Failed refresh:" << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(fleet.mutex);
+        fleet.instances["i-0000000000000006"].state = "running";
+        fleet.failNextRequest = true;
+    }
+    bool failedRefresh = tracker.Refresh(diff);
+    bool retriedRefresh = tracker.Refresh(diff);
+    if (failedRefresh || !retriedRefresh || diff.stateChanged.size() != 1 ||
+        diff.stateChanged[0].currentState != "running") {
+        std::cerr << "FAILED: Changes were lost across a failed refresh" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Changes were reported after a failed refresh" << std::endl;
+    }
+    
+    // Batched state query; unknown IDs are simply missing
+    std::cout << "\n5. Batched instance states:" << std::endl;
+    awsexamples::InstanceStateMap states;
+    bool statesFetched = ec2Manager.GetInstanceStates(
+        {"i-0000000000000001", "i-0000000000000003", "i-does-not-exist"}, states).success;
+    if (!statesFetched || states.size() != 2 || states["i-0000000000000001"] != "stopped") {
+        std::cerr << "FAILED: GetInstanceStates returned " << states.size() << " states" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: GetInstanceStates returned the states of the known instances" << std::endl;
+    }
+    
+    // Waits are coalesced and complete once the instance reaches the state
+    std::cout << "\n6. Waiting for instance states:" << std::endl;
+    awsexamples::WaitOptions waitOptions;
+    waitOptions.initialDelay = std::chrono::milliseconds(20);
+    waitOptions.maxDelay = std::chrono::milliseconds(100);
+    waitOptions.timeout = std::chrono::milliseconds(5000);
+    auto reached = ec2Manager.WaitForInstancesStateAsync(
+        {"i-0000000000000004", "i-0000000000000005"}, "running", waitOptions);
+    waitOptions.timeout = std::chrono::milliseconds(300);
+    auto timedOut = ec2Manager.WaitForInstanceStateAsync("i-0000000000000001", "running", waitOptions);
+    if (!reached.get() || timedOut.get()) {
+        std::cerr << "FAILED: Instance waits did not complete as expected" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Instance waits completed as expected" << std::endl;
+    }
+    
+    awsexamples::utils::RetryOptions retryOptions;
+    retryOptions.maxAttempts = 2;
+    retryOptions.throttleBaseDelay = std::chrono::milliseconds(5);
+    ec2Manager.SetRetryController(std::make_shared<awsexamples::utils::RetryController>(retryOptions));
+    auto stateChangeRequests = [&fleet]() {
+        std::lock_guard<std::mutex> lock(fleet.mutex);
+        return fleet.stateChangeRequests;
+    };
+    
+    // A bad ID fails its batch, whose other instances are then stopped one by one
+    std::cout << "\n7. Bulk stop with an unknown instance:" << std::endl;
+    int before = stateChangeRequests();
+    auto stopped = ec2Manager.StopInstances({"i-0000000000000001", "i-0000000000000003", "i-does-not-exist"});
+    if (stateChangeRequests() - before != 4 || !stopped["i-0000000000000001"] || !stopped["i-0000000000000003"] ||
+        stopped["i-does-not-exist"]) {
+        std::cerr << "FAILED: The batch with an unknown instance was not split" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The known instances were stopped one by one" << std::endl;
+    }
+    
+    // Throttling is retried as a whole batch and never split
+    std::cout << "\n8. Throttled bulk stop:" << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(fleet.mutex);
+        fleet.throttleStateChanges = retryOptions.maxAttempts;
+    }
+    before = stateChangeRequests();
+    stopped = ec2Manager.StopInstances({"i-0000000000000001", "i-0000000000000003", "i-0000000000000004"});
+    int throttledRequests = stateChangeRequests() - before;
+    if (throttledRequests != retryOptions.maxAttempts || stopped.size() != 3 || stopped["i-0000000000000001"]) {
+        std::cerr << "FAILED: The throttled batch took " << throttledRequests << " requests" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The throttled batch was retried whole, not split" << std::endl;
+    }
+    
+    return allTestsPassed;
+}
+
+int main() {
+    // The mock endpoint accepts any signature
+    setenv("AWS_ACCESS_KEY_ID", "AKIDMOCK", 1);
+    setenv("AWS_SECRET_ACCESS_KEY", "mock-secret", 1);
+    setenv("AWS_EC2_METADATA_DISABLED", "true", 1);
+    
+    MockFleet fleet;
+    fleet.instances["i-0000000000000001"] = {"running", "t3.micro", "blue"};
+    fleet.instances["i-0000000000000002"] = {"running", "t3.micro", "blue"};
+    fleet.instances["i-0000000000000003"] = {"pending", "t3.micro", "blue"};
+    fleet.instances["i-0000000000000004"] = {"running", "t3.small", "green"};
+    fleet.instances["i-0000000000000005"] = {"stopped", "t3.small", "green"};
+    
+    MockHttpServer server([&fleet](const MockHttpServer::Request& request) {
+        // i-0000000000000005 starts once a filtered request has seen it stopped
+        auto response = HandleEc2Request(fleet, request);
+        std::lock_guard<std::mutex> lock(fleet.mutex);
+        auto& stopped = fleet.instances["i-0000000000000005"];
+        if (request.body.find("Filter.1.Value") != std::string::npos &&
+            response.body.find("i-0000000000000005") != std::string::npos && stopped.state == "stopped") {
+            stopped.state = "running";
+        }
+        return response;
+    });
+    if (!server.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+    
+    bool testResult;
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+        
+        // Run the test
+        testResult = TestFleetTracker(server.Endpoint(), fleet);
+    }
+    
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
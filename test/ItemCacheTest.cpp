@@ -0,0 +1,238 @@
+/**
+ * @file ItemCacheTest.cpp
+ * @brief Test cases for the ItemCache class, directly and in front of DynamoDBManager::GetItem against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/ItemCache.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// In-memory table served by the mock endpoint
+struct MockTable {
+    std::mutex mutex;
+    std::map<std::string, std::pair<std::string, std::string>> items;  // id -> (name, age)
+    int getItemRequests = 0;
+};
+
+// Extract the string or number value of attribute @p name from a DynamoDB JSON body
+std::string JsonAttribute(const std::string& body, const std::string& name) {
+    std::size_t attribute = body.find("\"" + name + "\":{\"");
+    if (attribute == std::string::npos) {
+        return "";
+    }
+    std::size_t start = body.find(":\"", body.find("\":{\"", attribute) + 3) + 2;
+    return body.substr(start, body.find('"', start) - start);
+}
+
+// Answer GetItem, PutItem and DeleteItem for a table keyed by "id"
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table,
+                                             const std::string& operation,
+                                             const MockDynamoDB::Request& request) {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    std::string id = JsonAttribute(request.body, "id");
+    if (operation == "GetItem") {
+        ++table.getItemRequests;
+        auto item = table.items.find(id);
+        if (item == table.items.end()) {
+            return MockDynamoDB::Reply();
+        }
+        return MockDynamoDB::Reply("{\"Item\":{\"id\":{\"S\":\"" + id + "\"},\"name\":{\"S\":\"" + item->second.first +
+                                   "\"},\"age\":{\"N\":\"" + item->second.second + "\"}}}");
+    } else if (operation == "PutItem") {
+        table.items[id] = {JsonAttribute(request.body, "name"), JsonAttribute(request.body, "age")};
+    } else if (operation == "DeleteItem") {
+        table.items.erase(id);
+    } else {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Unsupported");
+    }
+    return MockDynamoDB::Reply();
+}
+
+// Test expiry, eviction and invalidation without sending any requests
+bool TestCache() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== ItemCache Test ===" << std::endl;
+
+    awsexamples::AttributeMap item;
+    item["id"].SetS("1");
+    item["name"].SetS("Alice");
+
+    std::cout << "\n1. Hits and misses:" << std::endl;
+    awsexamples::ItemCache cache;
+    awsexamples::AttributeMap found;
+    bool coldHit = cache.Get("Table", "1", found);
+    cache.Put("Table", "1", item, cache.Generation("Table", "1"));
+    bool warmHit = cache.Get("Table", "1", found);
+    auto stats = cache.GetStats();
+    if (coldHit || !warmHit || found.at("name").GetS() != "Alice" || stats.hits != 1 || stats.misses != 1) {
+        std::cerr << "FAILED: Lookups were not counted as one miss and one hit" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: A cached item was served from the cache" << std::endl;
+    }
+
+    // A read that started before a write must not re-cache the old item
+    std::cout << "\n2. Invalidation:" << std::endl;
+    std::uint64_t generation = cache.Generation("Table", "1");
+    cache.Invalidate("Table", "1");
+    cache.Put("Table", "1", item, generation);
+    if (cache.Get("Table", "1", found) || cache.GetStats().invalidations != 1) {
+        std::cerr << "FAILED: A stale fill was cached after an invalidation" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: A stale fill was dropped after an invalidation" << std::endl;
+    }
+
+    std::cout << "\n3. Expiry:" << std::endl;
+    awsexamples::ItemCacheOptions shortLived;
+    shortLived.ttl = std::chrono::milliseconds(20);
+    awsexamples::ItemCache expiringCache(shortLived);
+    expiringCache.Put("Table", "1", item, expiringCache.Generation("Table", "1"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (expiringCache.Get("Table", "1", found) || expiringCache.GetStats().expirations != 1) {
+        std::cerr << "FAILED: An expired item was served" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: An expired item was not served" << std::endl;
+    }
+
+    // The least recently used items make room for new ones
+    std::cout << "\n4. Eviction:" << std::endl;
+    awsexamples::ItemCacheOptions small;
+    small.maxBytes = 4096;
+    small.shards = 1;
+    awsexamples::ItemCache smallCache(small);
+    for (int i = 0; i < 100; ++i) {
+        std::string id = std::to_string(i);
+        smallCache.Put("Table", id, item, smallCache.Generation("Table", id));
+        smallCache.Get("Table", "0", found);  // Keep item 0 hot
+    }
+    stats = smallCache.GetStats();
+    if (stats.evictions == 0 || stats.bytes > small.maxBytes || !smallCache.Get("Table", "0", found) ||
+        smallCache.Get("Table", "1", found)) {
+        std::cerr << "FAILED: Eviction did not keep the cache within " << small.maxBytes << " bytes" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << stats.evictions << " evictions kept " << stats.entries << " entries in "
+                  << stats.bytes << " bytes" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test DynamoDBManager::GetItem with a cache against the mock endpoint
+bool TestManagerCache(const MockDynamoDB& dynamo, MockTable& table) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== DynamoDBManager Item Cache Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions options = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(options));
+    auto cache = std::make_shared<awsexamples::ItemCache>();
+    dynamoManager.SetItemCache(cache);
+
+    auto getItemRequests = [&table]() {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.getItemRequests;
+    };
+
+    // Repeated lookups go to DynamoDB once
+    std::cout << "\n5. Repeated lookups:" << std::endl;
+    dynamoManager.PutItem("CacheTable", "1", "Alice", 30);
+    awsexamples::AttributeMap item;
+    int before = getItemRequests();
+    bool firstRead = dynamoManager.GetItem("CacheTable", "1", item).success;
+    bool secondRead = dynamoManager.GetItem("CacheTable", "1", item).success;
+    auto asyncRead = dynamoManager.GetItemAsync("CacheTable", "1").get();
+    if (!firstRead || !secondRead || !asyncRead.success || getItemRequests() - before != 1 ||
+        item.at("name").GetS() != "Alice") {
+        std::cerr << "FAILED: Repeated lookups sent " << getItemRequests() - before << " requests" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Three lookups sent one GetItem request" << std::endl;
+    }
+
+    // Writes through the manager are visible at once
+    std::cout << "\n6. Lookups after writes:" << std::endl;
+    dynamoManager.PutItem("CacheTable", "1", "Bob", 40);
+    bool updatedRead = dynamoManager.GetItem("CacheTable", "1", item).success;
+    bool updated = updatedRead && item.at("name").GetS() == "Bob";
+    dynamoManager.DeleteItemAsync("CacheTable", "1").get();
+    bool deletedRead = dynamoManager.GetItem("CacheTable", "1", item).success;
+    if (!updated || !deletedRead || !item.empty()) {
+        std::cerr << "FAILED: A lookup returned an item that had been overwritten or deleted" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Lookups saw the update and the deletion" << std::endl;
+    }
+
+    // Missing items are cached too
+    before = getItemRequests();
+    dynamoManager.GetItem("CacheTable", "1", item);
+    if (getItemRequests() != before || !item.empty()) {
+        std::cerr << "FAILED: A missing item was looked up again" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: A missing item was served from the cache" << std::endl;
+    }
+
+    // Writes of items with a number key invalidate the lookups of that key
+    std::cout << "\n7. Lookups after writes with number keys:" << std::endl;
+    dynamoManager.GetItem("CacheTable", "5", item);
+    awsexamples::AttributeMap numbered;
+    numbered["id"].SetN("5");
+    numbered["name"].SetS("Carol");
+    numbered["age"].SetN("50");
+    dynamoManager.PutItem("CacheTable", numbered);
+    bool numberedRead = dynamoManager.GetItem("CacheTable", "5", item).success;
+    if (!numberedRead || item.empty() || item.at("name").GetS() != "Carol") {
+        std::cerr << "FAILED: A lookup returned the item cached before a write with a number key" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The lookup saw the write with a number key" << std::endl;
+    }
+
+    auto stats = cache->GetStats();
+    std::cout << "Cache: hits=" << stats.hits << " misses=" << stats.misses
+              << " invalidations=" << stats.invalidations << " entries=" << stats.entries << std::endl;
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = TestCache();
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestManagerCache(dynamo, table) && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,205 @@
+/**
+ * @file ItemMappingTest.cpp
+ * @brief Test cases for the typed item mapping, directly and through DynamoDBManager against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/ItemMapping.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+// A record using every supported member type
+struct Customer {
+    std::string id;
+    std::string name;
+    int age = 0;
+    double balance = 0;
+    bool active = false;
+    std::optional<std::string> email;
+    std::vector<std::string> tags;
+};
+
+namespace awsexamples {
+template <>
+struct ItemTraits<Customer> {
+    static constexpr auto attributes = std::make_tuple(
+        Attribute("id", &Customer::id),
+        Attribute("name", &Customer::name),
+        Attribute("age", &Customer::age),
+        Attribute("balance", &Customer::balance),
+        Attribute("active", &Customer::active),
+        Attribute("email", &Customer::email),
+        Attribute("tags", &Customer::tags));
+};
+}  // namespace awsexamples
+
+bool operator==(const Customer& a, const Customer& b) {
+    return a.id == b.id && a.name == b.name && a.age == b.age && a.balance == b.balance && a.active == b.active &&
+           a.email == b.email && a.tags == b.tags;
+}
+
+// In-memory table served by the mock endpoint, holding each item's JSON as sent
+struct MockTable {
+    std::mutex mutex;
+    std::map<std::string, std::string> items;  // id -> item JSON
+};
+
+// Extract the JSON object following "@p name": in @p body
+std::string JsonObject(const std::string& body, const std::string& name) {
+    std::size_t start = body.find("\"" + name + "\":{");
+    if (start == std::string::npos) {
+        return "";
+    }
+    start = body.find('{', start);
+    int depth = 0;
+    for (std::size_t i = start; i < body.size(); ++i) {
+        if (body[i] == '{') {
+            ++depth;
+        } else if (body[i] == '}' && --depth == 0) {
+            return body.substr(start, i - start + 1);
+        }
+    }
+    return "";
+}
+
+// Extract the string value of the "id" key attribute from a DynamoDB JSON body
+std::string JsonId(const std::string& body) {
+    std::size_t start = body.find("\"id\":{\"S\":\"");
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += 11;
+    return body.substr(start, body.find('"', start) - start);
+}
+
+// Answer GetItem and PutItem for a table keyed by "id"
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table,
+                                             const std::string& operation,
+                                             const MockDynamoDB::Request& request) {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (operation == "PutItem") {
+        std::string item = JsonObject(request.body, "Item");
+        table.items[JsonId(item)] = item;
+    } else if (operation == "GetItem") {
+        auto item = table.items.find(JsonId(request.body));
+        if (item != table.items.end()) {
+            return MockDynamoDB::Reply("{\"Item\":" + item->second + "}");
+        }
+    } else {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Unsupported");
+    }
+    return MockDynamoDB::Reply();
+}
+
+// Test marshalling without sending any requests
+bool TestMapping() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Item Mapping Test ===" << std::endl;
+
+    Customer customer{"1", "Alice", 30, 12.5, true, std::string("alice@example.com"), {"gold", "new"}};
+
+    std::cout << "\n1. Round trip:" << std::endl;
+    awsexamples::AttributeMap item;
+    awsexamples::ToItem(customer, item);
+    Customer decoded;
+    if (item.size() != 7 || item.at("age").GetN() != "30" || !awsexamples::FromItem(item, decoded) ||
+        !(decoded == customer)) {
+        std::cerr << "FAILED: The record did not survive a round trip" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: All seven attributes survived a round trip" << std::endl;
+    }
+
+    // Reusing the map must not leave attributes of the previous record behind
+    std::cout << "\n2. Optional attributes:" << std::endl;
+    customer.email.reset();
+    customer.tags.clear();
+    awsexamples::ToItem(customer, item);
+    if (item.size() != 5 || !awsexamples::FromItem(item, decoded) || decoded.email || !decoded.tags.empty()) {
+        std::cerr << "FAILED: Empty optional attributes were written or read back" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Empty optional attributes were left out" << std::endl;
+    }
+
+    std::cout << "\n3. Unreadable items:" << std::endl;
+    const char* badAttribute = "";
+    awsexamples::AttributeMap missing = item;
+    missing.erase("name");
+    awsexamples::AttributeMap mistyped = item;
+    mistyped["age"].SetS("thirty");
+    bool missingRead = awsexamples::FromItem(missing, decoded, &badAttribute);
+    std::string missingAttribute = badAttribute;
+    bool mistypedRead = awsexamples::FromItem(mistyped, decoded, &badAttribute);
+    if (missingRead || missingAttribute != "name" || mistypedRead || std::string(badAttribute) != "age") {
+        std::cerr << "FAILED: A missing or mistyped attribute was not reported" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Missing and mistyped attributes were reported" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test PutRecord and GetRecord against the mock endpoint
+bool TestManagerMapping(const MockDynamoDB& dynamo) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== DynamoDBManager Record Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions options = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(options));
+
+    std::cout << "\n4. Records through the manager:" << std::endl;
+    Customer customer{"7", "Bob", 41, -3.25, false, std::string("bob@example.com"), {"vip"}};
+    bool written = awsexamples::PutRecord(dynamoManager, "Customers", customer).success;
+    std::optional<Customer> found;
+    bool read = awsexamples::GetRecord(dynamoManager, "Customers", "7", found).success;
+    std::optional<Customer> absent;
+    bool readAbsent = awsexamples::GetRecord(dynamoManager, "Customers", "8", absent).success;
+    if (!written || !read || !found || !(*found == customer) || !readAbsent || absent) {
+        std::cerr << "FAILED: The record read back differs from the one written" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The record read back matches the one written" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = TestMapping();
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestManagerMapping(dynamo) && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
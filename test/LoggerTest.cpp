@@ -0,0 +1,266 @@
+/**
+ * @file LoggerTest.cpp
+ * @brief Test cases for the Logger class and for OperationResults returned against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/Logger.h"
+#include "awsexamples/RetryController.h"
+#include "MockDynamoDB.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using awsexamples::utils::Logger;
+using awsexamples::utils::LogLevel;
+
+// How the mock endpoint answers the next requests
+struct MockTable {
+    std::atomic<bool> throttle{false};
+    std::atomic<bool> reject{false};
+};
+
+// Answer every DynamoDB request with success, a throttling error or a validation error
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table, const std::string&, const MockDynamoDB::Request&) {
+    if (table.reject) {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Mock rejection");
+    } else if (table.throttle) {
+        return MockDynamoDB::Error(MockDynamoDB::kThrottlingException, "Mock throttling");
+    }
+    return MockDynamoDB::Reply();
+}
+
+// Messages written to the test sink
+struct CapturedLog {
+    std::mutex mutex;
+    std::vector<std::pair<LogLevel, std::string>> messages;
+};
+
+// Count the evaluations of a log message's arguments
+int Evaluate(int& evaluations) {
+    return ++evaluations;
+}
+
+// Test level filtering, the sink and flushing without sending any requests
+bool TestLogger(CapturedLog& log) {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Logger Test ===" << std::endl;
+
+    Logger& logger = Logger::Instance();
+    logger.SetSink([&log](LogLevel level, const std::string& message) {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        log.messages.emplace_back(level, message);
+    });
+
+    // Disabled messages do not evaluate their arguments
+    std::cout << "\n1. Level filtering:" << std::endl;
+    logger.SetLevel(LogLevel::Warn);
+    int evaluations = 0;
+    AWSEXAMPLES_LOG(Info, "skipped " << Evaluate(evaluations));
+    AWSEXAMPLES_LOG(Debug, "skipped " << Evaluate(evaluations));
+    AWSEXAMPLES_LOG(Warn, "written " << Evaluate(evaluations));
+    AWSEXAMPLES_LOG(Error, "written " << Evaluate(evaluations));
+    logger.Flush();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        if (evaluations != 2 || log.messages.size() != 2 || log.messages[0].first != LogLevel::Warn ||
+            log.messages[0].second != "written 1" || log.messages[1].second != "written 2") {
+            std::cerr << "FAILED: Messages below the level were evaluated or written" << std::endl;
+            allTestsPassed = false;
+        } else {
+            std::cout << "PASSED: Only Warn and Error messages were formatted and written" << std::endl;
+        }
+        log.messages.clear();
+    }
+
+    // Messages from many threads all arrive, each thread's in order
+    std::cout << "\n2. Concurrent writers:" << std::endl;
+    logger.SetLevel(LogLevel::Info);
+    const int threadCount = 4;
+    const int perThread = 1000;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threadCount; ++t) {
+        writers.emplace_back([t]() {
+            for (int i = 0; i < perThread; ++i) {
+                AWSEXAMPLES_LOG(Info, t << ' ' << i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    logger.Flush();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        std::vector<int> next(threadCount, 0);
+        bool ordered = true;
+        for (const auto& message : log.messages) {
+            int t = std::stoi(message.second);
+            int i = std::stoi(message.second.substr(message.second.find(' ') + 1));
+            ordered = ordered && i == next[t]++;
+        }
+        if (log.messages.size() != threadCount * perThread || !ordered || logger.GetDropped() != 0) {
+            std::cerr << "FAILED: " << log.messages.size() << " of " << threadCount * perThread
+                      << " messages were written in order" << std::endl;
+            allTestsPassed = false;
+        } else {
+            std::cout << "PASSED: All " << log.messages.size() << " messages were written in order" << std::endl;
+        }
+        log.messages.clear();
+    }
+
+    // Off disables every level
+    std::cout << "\n3. Logging off:" << std::endl;
+    logger.SetLevel(LogLevel::Off);
+    AWSEXAMPLES_LOG(Fatal, "skipped " << Evaluate(evaluations));
+    logger.Flush();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        if (evaluations != 2 || !log.messages.empty()) {
+            std::cerr << "FAILED: A message was written with logging off" << std::endl;
+            allTestsPassed = false;
+        } else {
+            std::cout << "PASSED: Nothing was written with logging off" << std::endl;
+        }
+    }
+    logger.SetLevel(LogLevel::Info);
+
+    return allTestsPassed;
+}
+
+// Test the results of DynamoDBManager calls against the mock endpoint
+bool TestOperationResults(const MockDynamoDB& dynamo, MockTable& table, CapturedLog& log) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== OperationResult Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions clientOptions = dynamo.Options();
+    clientOptions.logLevel = LogLevel::Debug;
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(clientOptions));
+
+    awsexamples::utils::RetryOptions retryOptions;
+    retryOptions.maxAttempts = 2;
+    retryOptions.baseDelay = std::chrono::milliseconds(1);
+    retryOptions.throttleBaseDelay = std::chrono::milliseconds(1);
+    dynamoManager.SetRetryController(std::make_shared<awsexamples::utils::RetryController>(retryOptions));
+
+    // Building a client configuration must not reset process-wide logging
+    std::cout << "\n4. Log level kept by ConfigureClient:" << std::endl;
+    if (Logger::Instance().GetLevel() != LogLevel::Error) {
+        std::cerr << "FAILED: ConfigureClient changed the logger level" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The logger level is still the initializer's Error" << std::endl;
+    }
+
+    std::cout << "\n5. Successful PutItem:" << std::endl;
+    awsexamples::OperationResult put = dynamoManager.PutItem("ResultTable", "1", "Alice", 30);
+    if (!put || !put.errorType.empty() || put.retryable || put.latency.count() <= 0) {
+        std::cerr << "FAILED: The successful result was not filled in" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: PutItem succeeded in " << put.latency.count() << " us" << std::endl;
+    }
+
+    std::cout << "\n6. Rejected PutItem:" << std::endl;
+    table.reject = true;
+    awsexamples::OperationResult rejected = dynamoManager.PutItem("ResultTable", "2", "Bob", 40);
+    table.reject = false;
+    if (rejected || rejected.errorType.find("ValidationException") == std::string::npos ||
+        rejected.message != "Mock rejection" || rejected.retryable) {
+        std::cerr << "FAILED: Unexpected result " << rejected.errorType << ": " << rejected.message << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << rejected.errorType << " is not retryable" << std::endl;
+    }
+
+    std::cout << "\n7. Throttled DeleteItem:" << std::endl;
+    table.throttle = true;
+    awsexamples::OperationResult throttled = dynamoManager.DeleteItem("ResultTable", "1");
+    table.throttle = false;
+    if (throttled || throttled.errorType.find("ProvisionedThroughputExceededException") == std::string::npos ||
+        !throttled.retryable) {
+        std::cerr << "FAILED: Unexpected result " << throttled.errorType << ": " << throttled.message << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << throttled.errorType << " is retryable" << std::endl;
+    }
+
+    // Invalid arguments fail before a request is built
+    std::cout << "\n8. Invalid table spec:" << std::endl;
+    awsexamples::TableSpec spec;
+    spec.name = "NoKey";
+    spec.hashKey.name.clear();
+    awsexamples::OperationResult invalid = dynamoManager.CreateTable(spec);
+    if (invalid || invalid.errorType != awsexamples::errors::kInvalidArgument || invalid.message.empty()) {
+        std::cerr << "FAILED: The invalid spec was not reported as an invalid argument" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << invalid.errorType << ": " << invalid.message << std::endl;
+    }
+
+    // The errors above went through the logger
+    Logger::Instance().Flush();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        std::size_t errors = 0;
+        for (const auto& message : log.messages) {
+            errors += message.first == LogLevel::Error ? 1 : 0;
+        }
+        if (errors != 3 || errors != log.messages.size()) {
+            std::cerr << "FAILED: Expected 3 error messages, got " << errors << " of " << log.messages.size()
+                      << std::endl;
+            allTestsPassed = false;
+        } else {
+            std::cout << "PASSED: The three failures were logged as errors" << std::endl;
+        }
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    CapturedLog log;
+    bool testResult = TestLogger(log);
+    {
+        // Initialize AWS SDK, which sets the logger's level
+        awsexamples::utils::AwsApiInitializer awsInitializer(
+            awsexamples::utils::CreateDefaultSDKOptions(LogLevel::Error));
+
+        // Run the test without the initialization message
+        Logger::Instance().Flush();
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            log.messages.clear();
+        }
+        testResult = TestOperationResults(dynamo, table, log) && testResult;
+    }
+    Logger::Instance().SetSink(nullptr);
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
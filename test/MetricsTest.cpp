@@ -0,0 +1,273 @@
+/**
+ * @file MetricsTest.cpp
+ * @brief Test cases for the LatencyHistogram and MetricsRegistry classes, including calls to a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/Metrics.h"
+#include "MockDynamoDB.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using awsexamples::utils::ErrorClass;
+using awsexamples::utils::LatencyHistogram;
+using awsexamples::utils::MetricsRegistry;
+
+// Answer every DynamoDB request with success, or a validation error while reject is set
+MockDynamoDB::Response HandleDynamoDBRequest(const std::atomic<bool>& reject,
+                                             const std::string&,
+                                             const MockDynamoDB::Request&) {
+    if (reject) {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Mock rejection");
+    }
+    return MockDynamoDB::Reply();
+}
+
+// Check that a quantile lies at or at most 1/32 above the true value
+bool WithinBucketError(std::uint64_t reported, std::uint64_t expected) {
+    return reported >= expected && reported <= expected + expected / LatencyHistogram::kSubBucketCount;
+}
+
+// Test bucketing, quantiles and merging without any registry
+bool TestLatencyHistogram() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== LatencyHistogram Test ===" << std::endl;
+
+    // Every bucket's upper bound falls back in that bucket and the next value in the next one
+    std::cout << "\n1. Bucket bounds:" << std::endl;
+    bool boundsConsistent = true;
+    for (std::size_t bucket = 0; bucket + 1 < LatencyHistogram::kBucketCount; ++bucket) {
+        const std::uint64_t bound = LatencyHistogram::BucketUpperBound(bucket);
+        boundsConsistent = boundsConsistent && LatencyHistogram::BucketOf(bound) == bucket &&
+                           LatencyHistogram::BucketOf(bound + 1) == bucket + 1;
+    }
+    if (!boundsConsistent || LatencyHistogram::BucketOf(UINT64_MAX) != LatencyHistogram::kBucketCount - 1) {
+        std::cerr << "FAILED: Bucket bounds are inconsistent" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << LatencyHistogram::kBucketCount << " buckets cover the range without gaps"
+                  << std::endl;
+    }
+
+    // Quantiles of 1..100000 us are within the bucket error of the exact values
+    std::cout << "\n2. Quantiles:" << std::endl;
+    LatencyHistogram histogram;
+    for (std::uint64_t value = 1; value <= 100000; ++value) {
+        histogram.Record(value);
+    }
+    const std::uint64_t p50 = histogram.ValueAtQuantile(0.5);
+    const std::uint64_t p99 = histogram.ValueAtQuantile(0.99);
+    const std::uint64_t p999 = histogram.ValueAtQuantile(0.999);
+    if (!WithinBucketError(p50, 50000) || !WithinBucketError(p99, 99000) || !WithinBucketError(p999, 99900) ||
+        histogram.ValueAtQuantile(1.0) != 100000 || histogram.GetCount() != 100000 ||
+        histogram.GetSum() != 5000050000ULL || histogram.GetMax() != 100000) {
+        std::cerr << "FAILED: p50 " << p50 << ", p99 " << p99 << ", p999 " << p999 << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: p50 " << p50 << " us, p99 " << p99 << " us, p999 " << p999 << " us" << std::endl;
+    }
+
+    // Merging two halves gives the same histogram as recording everything in one
+    std::cout << "\n3. Merge:" << std::endl;
+    LatencyHistogram lower;
+    LatencyHistogram upper;
+    for (std::uint64_t value = 1; value <= 100000; ++value) {
+        (value <= 50000 ? lower : upper).Record(value);
+    }
+    lower.Merge(upper);
+    bool sameCounts = true;
+    for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+        sameCounts = sameCounts && lower.GetBucketCount(bucket) == histogram.GetBucketCount(bucket);
+    }
+    if (!sameCounts || lower.GetSum() != histogram.GetSum() || lower.GetMax() != histogram.GetMax() ||
+        lower.ValueAtQuantile(0.99) != p99) {
+        std::cerr << "FAILED: The merged histogram differs" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The merged histogram matches" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test recording from many threads and the exposition formats
+bool TestMetricsRegistry() {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== MetricsRegistry Test ===" << std::endl;
+
+    MetricsRegistry& metrics = MetricsRegistry::Instance();
+
+    // Counters of every thread are merged, including threads that have exited
+    std::cout << "\n4. Concurrent recording:" << std::endl;
+    const int threadCount = 8;
+    const int perThread = 10000;
+    std::vector<std::thread> recorders;
+    for (int t = 0; t < threadCount; ++t) {
+        recorders.emplace_back([&metrics]() {
+            for (int i = 0; i < perThread; ++i) {
+                metrics.Record("TestOperation", std::chrono::microseconds(i % 100 + 1),
+                               i % 10 == 0 ? ErrorClass::Throttling : ErrorClass::None);
+                metrics.AddBytes("TestOperation", 2);
+            }
+        });
+    }
+    for (auto& recorder : recorders) {
+        recorder.join();
+    }
+    auto snapshot = metrics.Snapshot();
+    const auto& recorded = snapshot["TestOperation"];
+    const std::uint64_t expectedCalls = threadCount * perThread;
+    if (recorded.calls != expectedCalls || recorded.latency.GetCount() != expectedCalls ||
+        recorded.bytes != 2 * expectedCalls || recorded.Errors(ErrorClass::Throttling) != expectedCalls / 10 ||
+        recorded.latency.GetMax() != 100) {
+        std::cerr << "FAILED: Merged " << recorded.calls << " calls and " << recorded.bytes << " bytes" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << recorded.calls << " calls from " << threadCount << " threads were merged"
+                  << std::endl;
+    }
+
+    // New threads reuse the counters of exited ones and keep adding to them
+    std::cout << "\n5. Counters of exited threads:" << std::endl;
+    for (int round = 0; round < 4; ++round) {
+        std::thread([&metrics]() { metrics.Record("TestOperation", std::chrono::microseconds(1), ErrorClass::None); })
+            .join();
+    }
+    snapshot = metrics.Snapshot();
+    if (snapshot["TestOperation"].calls != expectedCalls + 4) {
+        std::cerr << "FAILED: Calls of short-lived threads were lost" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Calls of short-lived threads were kept" << std::endl;
+    }
+
+    // Nothing is recorded while disabled
+    std::cout << "\n6. Recording disabled:" << std::endl;
+    metrics.SetEnabled(false);
+    metrics.Record("TestOperation", std::chrono::microseconds(1), ErrorClass::None);
+    metrics.SetEnabled(true);
+    if (metrics.Snapshot()["TestOperation"].calls != expectedCalls + 4) {
+        std::cerr << "FAILED: A call was recorded while disabled" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: No call was recorded while disabled" << std::endl;
+    }
+
+    // The Prometheus text holds every metric family of the operation
+    std::cout << "\n7. Prometheus exposition:" << std::endl;
+    std::ostringstream text;
+    metrics.WritePrometheus(text);
+    const std::string exposition = text.str();
+    const std::string expectedLines[] = {
+        "# TYPE awsexamples_calls_total counter",
+        "awsexamples_calls_total{operation=\"TestOperation\"} " + std::to_string(expectedCalls + 4),
+        "awsexamples_errors_total{operation=\"TestOperation\",class=\"throttling\"} " +
+            std::to_string(expectedCalls / 10),
+        "awsexamples_bytes_total{operation=\"TestOperation\"} " + std::to_string(2 * expectedCalls),
+        "# TYPE awsexamples_latency_seconds summary",
+        "awsexamples_latency_seconds{operation=\"TestOperation\",quantile=\"0.99\"} ",
+        "awsexamples_latency_seconds_count{operation=\"TestOperation\"} " + std::to_string(expectedCalls + 4),
+    };
+    bool allLinesFound = true;
+    for (const auto& line : expectedLines) {
+        if (exposition.find(line) == std::string::npos) {
+            std::cerr << "FAILED: Missing line: " << line << std::endl;
+            allLinesFound = false;
+        }
+    }
+    if (!allLinesFound) {
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: All metric families were written" << std::endl;
+    }
+
+    // The dump hook writes the same text to a file
+    std::cout << "\n8. Dump to file:" << std::endl;
+    const std::string dumpPath = "metrics_test.prom";
+    bool dumped = metrics.DumpToFile(dumpPath);
+    std::ifstream dumpFile(dumpPath);
+    std::stringstream dumpContents;
+    dumpContents << dumpFile.rdbuf();
+    dumpFile.close();
+    std::remove(dumpPath.c_str());
+    if (!dumped || dumpContents.str().find(expectedLines[1]) == std::string::npos) {
+        std::cerr << "FAILED: The metrics file was not written" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Wrote " << dumpContents.str().size() << " bytes to " << dumpPath << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test that manager calls against the mock endpoint are recorded
+bool TestManagerMetrics(const MockDynamoDB& dynamo, std::atomic<bool>& reject) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== Manager Metrics Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions clientOptions = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(clientOptions));
+
+    std::cout << "\n9. PutItem calls:" << std::endl;
+    dynamoManager.PutItem("MetricsTable", "1", "Alice", 30);
+    reject = true;
+    dynamoManager.PutItem("MetricsTable", "2", "Bob", 40);
+    reject = false;
+
+    auto snapshot = MetricsRegistry::Instance().Snapshot();
+    const auto& putItem = snapshot["PutItem"];
+    if (putItem.calls != 2 || putItem.Errors(ErrorClass::Client) != 1 || putItem.latency.GetCount() != 2 ||
+        putItem.latency.GetSum() == 0) {
+        std::cerr << "FAILED: Recorded " << putItem.calls << " calls and " << putItem.Errors(ErrorClass::Client)
+                  << " client errors" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Recorded 2 calls, 1 client error, p50 " << putItem.latency.ValueAtQuantile(0.5)
+                  << " us" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    std::atomic<bool> reject{false};
+    MockDynamoDB dynamo([&reject](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(reject, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = TestLatencyHistogram();
+    testResult = TestMetricsRegistry() && testResult;
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestManagerMetrics(dynamo, reject) && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file MockDynamoDB.h
+ * @brief Mock DynamoDB endpoint shared by the DynamoDBManager tests
+ */
+
+#ifndef AWSEXAMPLES_TEST_MOCKDYNAMODB_H
+#define AWSEXAMPLES_TEST_MOCKDYNAMODB_H
+
+#include "awsexamples/AwsUtils.h"
+#include "MockHttpServer.h"
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+/**
+ * @class MockDynamoDB
+ * @brief Serves the DynamoDB JSON protocol on a MockHttpServer
+ *
+ * Each request is passed to the test's handler together with its operation
+ * name, e.g. "GetItem", taken from the x-amz-target header. Construct the mock
+ * before the first client is created: the constructor also sets the dummy
+ * credentials the clients sign with.
+ */
+class MockDynamoDB {
+public:
+    using Request = MockHttpServer::Request;
+    using Response = MockHttpServer::Response;
+    using Handler = std::function<Response(const std::string& operation, const Request& request)>;
+
+    /// Error type of requests that can never succeed
+    static constexpr const char* kValidationException = "com.amazon.coral.validate#ValidationException";
+    /// Error type of throttled requests
+    static constexpr const char* kThrottlingException =
+        "com.amazonaws.dynamodb.v20120810#ProvisionedThroughputExceededException";
+
+    /**
+     * @brief Start serving on an ephemeral port
+     *
+     * @param handler Produces the response to each request; called on the server thread
+     */
+    explicit MockDynamoDB(Handler handler)
+        : server([handler = std::move(handler)](const Request& request) {
+              return handler(Operation(request), request);
+          }) {
+        // The mock endpoint accepts any signature
+        setenv("AWS_ACCESS_KEY_ID", "AKIDMOCK", 1);
+        setenv("AWS_SECRET_ACCESS_KEY", "mock-secret", 1);
+        setenv("AWS_EC2_METADATA_DISABLED", "true", 1);
+    }
+
+    /**
+     * @brief Build a successful response
+     *
+     * @param body The JSON body
+     */
+    static Response Reply(const std::string& body = "{}") {
+        Response response;
+        response.contentType = "application/x-amz-json-1.0";
+        response.body = body;
+        return response;
+    }
+
+    /**
+     * @brief Build an error response
+     *
+     * @param type The error type, e.g. kValidationException
+     * @param message The error message
+     */
+    static Response Error(const std::string& type, const std::string& message) {
+        Response response = Reply("{\"__type\":\"" + type + "\",\"message\":\"" + message + "\"}");
+        response.status = 400;
+        return response;
+    }
+
+    /**
+     * @brief Check whether the endpoint is listening
+     */
+    bool IsRunning() const { return server.IsRunning(); }
+
+    /**
+     * @brief Get the endpoint URL
+     */
+    std::string Endpoint() const { return server.Endpoint(); }
+
+    /**
+     * @brief Get the number of requests served so far
+     */
+    int RequestCount() const { return server.RequestCount(); }
+
+    /**
+     * @brief Get client options that point at the endpoint
+     */
+    awsexamples::utils::ClientOptions Options() const {
+        awsexamples::utils::ClientOptions options;
+        options.region = "us-east-1";
+        options.endpointOverride = Endpoint();
+        options.requestTimeoutMs = 5000;
+        return options;
+    }
+
+private:
+    static std::string Operation(const Request& request) {
+        auto target = request.headers.find("x-amz-target");
+        if (target == request.headers.end()) {
+            return "";
+        }
+        return target->second.substr(target->second.find('.') + 1);
+    }
+
+    MockHttpServer server;  ///< Underlying HTTP server
+};
+
+#endif  // AWSEXAMPLES_TEST_MOCKDYNAMODB_H
@@ -0,0 +1,318 @@
+/**
+ * @file MockHttpServer.h
+ * @brief Minimal local HTTP server standing in for an AWS endpoint in tests and benchmarks
+ */
+
+#ifndef AWSEXAMPLES_TEST_MOCKHTTPSERVER_H
+#define AWSEXAMPLES_TEST_MOCKHTTPSERVER_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MockHttpServer
+ * @brief Serves requests on 127.0.0.1 with a test-provided handler
+ *
+ * By default each connection carries one request and is closed after the
+ * response, which keeps the server trivial while still exercising the SDK's
+ * real HTTP stack. In keep-alive mode connections stay open and each one is
+ * served on its own thread, so a client's connection pool is used the way it
+ * is against a real endpoint and concurrent requests do not queue behind one
+ * another. Request bodies must carry a Content-Length.
+ */
+class MockHttpServer {
+public:
+    /// Parsed request passed to the handler
+    struct Request {
+        std::string method;                         ///< e.g. "POST"
+        std::string target;                         ///< Path and query string
+        std::string path;                           ///< Decoded path without the query string
+        std::map<std::string, std::string> query;   ///< Decoded query parameters
+        std::map<std::string, std::string> headers; ///< Headers by lower-case name
+        std::string body;                           ///< Request body
+        std::map<std::string, std::string> params;  ///< Decoded parameters of a form-encoded body
+    };
+
+    /// Response returned by the handler
+    struct Response {
+        int status = 200;                                          ///< HTTP status code
+        std::string contentType = "text/xml";                      ///< Content-Type header
+        std::vector<std::pair<std::string, std::string>> headers;  ///< Additional headers
+        std::string body;                                          ///< Response body; not sent for HEAD
+        long long contentLength = -1;  ///< Content-Length to declare for HEAD; -1 uses the body size
+    };
+
+    using Handler = std::function<Response(const Request&)>;
+
+    /**
+     * @brief Start serving on an ephemeral port
+     *
+     * @param handler Produces the response to each request; called on the server thread, or concurrently from
+     *                the connection threads in keep-alive mode
+     * @param keepAlive Whether to keep connections open and serve each on its own thread
+     */
+    explicit MockHttpServer(Handler handler, bool keepAlive = false)
+        : handler(std::move(handler)), keepAlive(keepAlive) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listener, keepAlive ? 256 : 64) != 0 ||
+            getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            close(listener);
+            listener = -1;
+            return;
+        }
+        port = ntohs(address.sin_port);
+        thread = std::thread([this]() { Serve(); });
+    }
+
+    ~MockHttpServer() {
+        running = false;
+        if (listener >= 0) {
+            // Wakes the accept loop, which then sees running == false
+            shutdown(listener, SHUT_RDWR);
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+        {
+            // Wakes connection threads blocked in recv
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& connection : connections) {
+                shutdown(connection.first, SHUT_RDWR);
+            }
+        }
+        // Only the accept loop adds connections, so the map is stable now
+        for (auto& connection : connections) {
+            connection.second.join();
+            close(connection.first);
+        }
+        if (listener >= 0) {
+            close(listener);
+        }
+    }
+
+    MockHttpServer(const MockHttpServer&) = delete;
+    MockHttpServer& operator=(const MockHttpServer&) = delete;
+
+    /**
+     * @brief Check whether the server is listening
+     */
+    bool IsRunning() const { return listener >= 0; }
+
+    /**
+     * @brief Get the endpoint URL, e.g. "http://127.0.0.1:40123"
+     */
+    std::string Endpoint() const { return "http://127.0.0.1:" + std::to_string(port); }
+
+    /**
+     * @brief Get the number of requests served so far
+     */
+    int RequestCount() const { return requests.load(); }
+
+private:
+    void Serve() {
+        while (running) {
+            int connection = accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                continue;
+            }
+            if (!keepAlive) {
+                std::string data;
+                Handle(connection, data);
+                close(connection);
+                continue;
+            }
+
+            int noDelay = 1;
+            setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+            std::lock_guard<std::mutex> lock(mutex);
+            Reap();
+            if (!running) {
+                close(connection);
+                break;
+            }
+            connections[connection] = std::thread([this, connection]() { ServeConnection(connection); });
+        }
+    }
+
+    // Serve requests on one keep-alive connection until the client closes it
+    void ServeConnection(int connection) {
+        std::string data;
+        while (running && Handle(connection, data)) {
+        }
+        // The socket stays open until Reap, so its descriptor is not reused while still in connections
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(connection);
+    }
+
+    // Join the threads of finished connections and close their sockets; mutex must be held
+    void Reap() {
+        for (int connection : finished) {
+            auto entry = connections.find(connection);
+            entry->second.join();
+            close(connection);
+            connections.erase(entry);
+        }
+        finished.clear();
+    }
+
+    // Read, handle and answer one request; data carries bytes already received past it
+    bool Handle(int connection, std::string& data) {
+        char buffer[64 * 1024];
+        std::size_t headerEnd;
+        while ((headerEnd = data.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            data.append(buffer, static_cast<std::size_t>(received));
+        }
+
+        Request request;
+        std::string head = data.substr(0, headerEnd);
+        std::size_t firstSpace = head.find(' ');
+        std::size_t secondSpace = head.find(' ', firstSpace + 1);
+        request.method = head.substr(0, firstSpace);
+        request.target = head.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+        std::size_t queryStart = request.target.find('?');
+        request.path = Decode(request.target.substr(0, queryStart));
+        if (queryStart != std::string::npos) {
+            request.query = ParseForm(request.target.substr(queryStart + 1));
+        }
+
+        for (std::size_t line = head.find("\r\n"); line != std::string::npos;) {
+            std::size_t next = head.find("\r\n", line + 2);
+            std::string header = head.substr(line + 2, next == std::string::npos ? std::string::npos : next - line - 2);
+            std::size_t colon = header.find(':');
+            if (colon != std::string::npos) {
+                std::string name = header.substr(0, colon);
+                for (auto& c : name) {
+                    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+                std::size_t value = header.find_first_not_of(' ', colon + 1);
+                request.headers[name] = value == std::string::npos ? "" : header.substr(value);
+            }
+            line = next;
+        }
+
+        // Some clients wait for "100 Continue" before sending the body
+        auto expect = request.headers.find("expect");
+        if (expect != request.headers.end() && expect->second == "100-continue") {
+            const std::string continueLine = "HTTP/1.1 100 Continue\r\n\r\n";
+            send(connection, continueLine.data(), continueLine.size(), MSG_NOSIGNAL);
+        }
+
+        auto lengthHeader = request.headers.find("content-length");
+        std::size_t contentLength =
+            lengthHeader == request.headers.end() ? 0 : std::strtoul(lengthHeader->second.c_str(), nullptr, 10);
+        data.erase(0, headerEnd + 4);
+        while (data.size() < contentLength) {
+            ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                return false;
+            }
+            data.append(buffer, static_cast<std::size_t>(received));
+        }
+        request.body = data.substr(0, contentLength);
+        data.erase(0, contentLength);
+        auto contentType = request.headers.find("content-type");
+        if (contentType != request.headers.end() &&
+            contentType->second.rfind("application/x-www-form-urlencoded", 0) == 0) {
+            request.params = ParseForm(request.body);
+        }
+
+        ++requests;
+        Response response = handler(request);
+        bool headRequest = request.method == "HEAD";
+        long long length = headRequest && response.contentLength >= 0 ? response.contentLength
+                                                                       : static_cast<long long>(response.body.size());
+        std::string message = "HTTP/1.1 " + std::to_string(response.status) + " Mock\r\n" +
+                              "Content-Type: " + response.contentType + "\r\n" +
+                              "Content-Length: " + std::to_string(length) + "\r\n";
+        for (const auto& header : response.headers) {
+            message += header.first + ": " + header.second + "\r\n";
+        }
+        message += keepAlive ? "\r\n" : "Connection: close\r\n\r\n";
+        if (!headRequest) {
+            message += response.body;
+        }
+        return SendAll(connection, message);
+    }
+
+    static bool SendAll(int connection, const std::string& message) {
+        for (std::size_t sent = 0; sent < message.size();) {
+            ssize_t written = send(connection, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) {
+                return false;
+            }
+            sent += static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    static std::string Decode(const std::string& text) {
+        std::string decoded;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            if (text[i] == '+') {
+                decoded += ' ';
+            } else if (text[i] == '%' && i + 2 < text.size()) {
+                decoded += static_cast<char>(std::strtol(text.substr(i + 1, 2).c_str(), nullptr, 16));
+                i += 2;
+            } else {
+                decoded += text[i];
+            }
+        }
+        return decoded;
+    }
+
+    // Parse "a=1&b" into {"a": "1", "b": ""}
+    static std::map<std::string, std::string> ParseForm(const std::string& text) {
+        std::map<std::string, std::string> params;
+        std::size_t start = 0;
+        while (start < text.size()) {
+            std::size_t end = text.find('&', start);
+            if (end == std::string::npos) {
+                end = text.size();
+            }
+            std::string pair = text.substr(start, end - start);
+            std::size_t equals = pair.find('=');
+            params[Decode(pair.substr(0, equals))] = equals == std::string::npos ? "" : Decode(pair.substr(equals + 1));
+            start = end + 1;
+        }
+        return params;
+    }
+
+    Handler handler;                          ///< Produces responses
+    bool keepAlive;                           ///< Whether connections are kept open
+    int listener = -1;                        ///< Listening socket
+    int port = 0;                             ///< Port the server listens on
+    std::atomic<bool> running{true};          ///< Cleared on destruction
+    std::atomic<int> requests{0};             ///< Number of requests served
+    std::thread thread;                       ///< Accept loop
+    std::mutex mutex;                         ///< Guards the members below
+    std::map<int, std::thread> connections;   ///< Threads of open keep-alive connections by socket
+    std::vector<int> finished;                ///< Connections whose thread has finished
+};
+
+#endif  // AWSEXAMPLES_TEST_MOCKHTTPSERVER_H
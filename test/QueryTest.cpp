@@ -0,0 +1,189 @@
+/**
+ * @file QueryTest.cpp
+ * @brief Test cases for DynamoDBManager::Query and QueryPage against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Requests seen by the mock endpoint
+struct MockTable {
+    std::mutex mutex;
+    int queryRequests = 0;
+    std::string lastBody;
+};
+
+constexpr int kOrderCount = 25;  // Orders of customer "c1", sort keys "001" to "025"
+
+std::string SortKey(int order) {
+    char key[8];
+    std::snprintf(key, sizeof(key), "%03d", order);
+    return key;
+}
+
+// Extract the sort key of the ExclusiveStartKey in a Query body, or "" if there is none
+std::string StartSortKey(const std::string& body) {
+    std::size_t start = body.find("\"ExclusiveStartKey\":");
+    if (start == std::string::npos) {
+        return "";
+    }
+    start = body.find("\"sk\":{\"S\":\"", start) + 11;
+    return body.substr(start, body.find('"', start) - start);
+}
+
+// Answer Query for the orders of one customer, honouring Limit, ExclusiveStartKey and ScanIndexForward
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table,
+                                             const std::string& operation,
+                                             const MockDynamoDB::Request& request) {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (operation != "Query") {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Unsupported");
+    }
+    ++table.queryRequests;
+    table.lastBody = request.body;
+
+    bool forward = request.body.find("\"ScanIndexForward\":false") == std::string::npos;
+    std::size_t limitAt = request.body.find("\"Limit\":");
+    int limit = limitAt == std::string::npos ? kOrderCount : std::stoi(request.body.substr(limitAt + 8));
+    std::string startKey = StartSortKey(request.body);
+    int order = startKey.empty() ? (forward ? 1 : kOrderCount) : std::stoi(startKey) + (forward ? 1 : -1);
+
+    std::string items;
+    int count = 0;
+    for (; order >= 1 && order <= kOrderCount && count < limit; order += forward ? 1 : -1, ++count) {
+        items += (items.empty() ? "" : ",") + std::string("{\"pk\":{\"S\":\"c1\"},\"sk\":{\"S\":\"") +
+                 SortKey(order) + "\"},\"total\":{\"N\":\"" + std::to_string(order * 10) + "\"}}";
+    }
+    std::string body = "{\"Count\":" + std::to_string(count) + ",\"ScannedCount\":" + std::to_string(count) +
+                       ",\"Items\":[" + items + "]";
+    if (order >= 1 && order <= kOrderCount) {
+        int last = order - (forward ? 1 : -1);
+        body += ",\"LastEvaluatedKey\":{\"pk\":{\"S\":\"c1\"},\"sk\":{\"S\":\"" + SortKey(last) + "\"}}";
+    }
+    return MockDynamoDB::Reply(body + "}");
+}
+
+// Test streaming, limits and single pages against the mock endpoint
+bool TestQuery(const MockDynamoDB& dynamo, MockTable& table) {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Query Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions clientOptions = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(clientOptions));
+
+    auto queryRequests = [&table]() {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.queryRequests;
+    };
+
+    awsexamples::QueryOptions options;
+    options.keyConditionExpression = "pk = :pk";
+    options.expressionAttributeValues[":pk"].SetS("c1");
+    options.pageSize = 10;
+
+    // Every page is followed until LastEvaluatedKey runs out
+    std::cout << "\n1. Streaming every page:" << std::endl;
+    std::vector<std::string> keys;
+    bool queried = dynamoManager.Query("Orders", options, [&keys](const awsexamples::AttributeMap& item) {
+        keys.push_back(item.at("sk").GetS());
+        return true;
+    }).success;
+    bool inOrder = keys.size() == kOrderCount;
+    for (std::size_t i = 0; inOrder && i < keys.size(); ++i) {
+        inOrder = keys[i] == SortKey(static_cast<int>(i) + 1);
+    }
+    if (!queried || !inOrder || queryRequests() != 3) {
+        std::cerr << "FAILED: Got " << keys.size() << " items with " << queryRequests() << " requests" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Got " << keys.size() << " items in order with 3 requests" << std::endl;
+    }
+
+    // The last request asks only for the items the limit still allows
+    std::cout << "\n2. Limit:" << std::endl;
+    int before = queryRequests();
+    awsexamples::QueryOptions limited = options;
+    limited.limit = 12;
+    limited.scanIndexForward = false;
+    keys.clear();
+    queried = dynamoManager.Query("Orders", limited, [&keys](const awsexamples::AttributeMap& item) {
+        keys.push_back(item.at("sk").GetS());
+        return true;
+    }).success;
+    if (!queried || keys.size() != 12 || keys.front() != SortKey(kOrderCount) || queryRequests() - before != 2) {
+        std::cerr << "FAILED: A limit of 12 returned " << keys.size() << " items" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: A limit of 12 returned the 12 newest items with 2 requests" << std::endl;
+    }
+
+    // A caller can page through results one request at a time
+    std::cout << "\n3. Single pages:" << std::endl;
+    awsexamples::QueryOptions paged = options;
+    paged.indexName = "ByTotal";
+    paged.projectionExpression = "sk, #t";
+    paged.expressionAttributeNames["#t"] = "total";
+    std::vector<awsexamples::AttributeMap> items;
+    awsexamples::AttributeMap lastKey;
+    int pages = 0;
+    std::size_t itemCount = 0;
+    bool pagesRead = true;
+    do {
+        pagesRead = dynamoManager.QueryPage("Orders", paged, items, lastKey) && pagesRead;
+        paged.exclusiveStartKey = lastKey;
+        itemCount += items.size();
+        ++pages;
+    } while (pagesRead && !lastKey.empty() && pages < 10);
+    std::string lastBody;
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        lastBody = table.lastBody;
+    }
+    bool forwarded = lastBody.find("\"IndexName\":\"ByTotal\"") != std::string::npos &&
+                     lastBody.find("\"ProjectionExpression\":\"sk, #t\"") != std::string::npos;
+    if (!pagesRead || pages != 3 || itemCount != kOrderCount || !forwarded) {
+        std::cerr << "FAILED: Paging returned " << itemCount << " items in " << pages << " pages" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Paging returned " << itemCount << " items in 3 pages from the index" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = false;
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestQuery(dynamo, table);
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
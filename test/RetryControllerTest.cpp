@@ -0,0 +1,215 @@
+/**
+ * @file RetryControllerTest.cpp
+ * @brief Test cases for the RetryController class, directly and through DynamoDBManager against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBBatchWriter.h"
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/RetryController.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Errors the mock endpoint returns before it lets a request succeed
+struct MockTable {
+    std::atomic<int> throttleNext{0};
+    std::atomic<bool> rejectNext{false};
+};
+
+// Answer every DynamoDB request with success, a throttling error or a validation error
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table, const std::string&, const MockDynamoDB::Request&) {
+    if (table.rejectNext.exchange(false)) {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Mock rejection");
+    } else if (table.throttleNext.fetch_sub(1) > 0) {
+        return MockDynamoDB::Error(MockDynamoDB::kThrottlingException, "Mock throttling");
+    }
+    table.throttleNext = 0;
+    return MockDynamoDB::Reply();
+}
+
+// Test the controller's decisions without sending any requests
+bool TestDecisions() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== RetryController Decision Test ===" << std::endl;
+
+    std::cout << "\n1. Throttling errors:" << std::endl;
+    using awsexamples::utils::RetryController;
+    if (!RetryController::IsThrottlingError("SlowDown", 503) ||
+        !RetryController::IsThrottlingError("com.amazonaws.dynamodb.v20120810#ThrottlingException", 400) ||
+        !RetryController::IsThrottlingError("", 429) ||
+        RetryController::IsThrottlingError("ValidationException", 400)) {
+        std::cerr << "FAILED: Throttling errors were not classified correctly" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Throttling errors were classified correctly" << std::endl;
+    }
+
+    // Two retries of transient errors exhaust a budget of 10
+    std::cout << "\n2. Retry budget:" << std::endl;
+    awsexamples::utils::RetryOptions options;
+    options.maxAttempts = 10;
+    options.retryBudget = 10;
+    options.baseDelay = std::chrono::milliseconds(1);
+    RetryController controller(options);
+    std::chrono::milliseconds delay{0};
+    bool first = controller.OnFailure("Op", 1, false, true, delay);
+    bool second = controller.OnFailure("Op", 2, false, true, delay);
+    bool third = controller.OnFailure("Op", 3, false, true, delay);
+    bool permanent = controller.OnFailure("Other", 1, false, false, delay);
+    auto counters = controller.GetCounters();
+    if (!first || !second || third || permanent || counters["Op"].retriesDenied != 1 || controller.GetRetryBudget() != 0) {
+        std::cerr << "FAILED: Retries were not limited by the budget" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Retries stopped once the budget was spent" << std::endl;
+    }
+
+    // Once throttled, a burst of calls is spread out at the reduced rate
+    std::cout << "\n3. Admission after throttling:" << std::endl;
+    RetryController limiter;
+    for (int i = 0; i < 20; ++i) {
+        limiter.Admit("Op");
+    }
+    limiter.OnFailure("Op", 1, true, true, delay);
+    std::chrono::milliseconds waited{0};
+    for (int i = 0; i < 20; ++i) {
+        waited = limiter.Admit("Op");
+    }
+    if (waited.count() <= 0 || limiter.GetCounters()["Op"].admissionRate <= 0) {
+        std::cerr << "FAILED: Calls were not delayed after throttling" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The last call of the burst waits " << waited.count() << " ms at "
+                  << limiter.GetCounters()["Op"].admissionRate << " calls/s" << std::endl;
+    }
+
+    // Unprocessed batch items slow the operation down like a throttling error
+    std::cout << "\n4. Partial throttling:" << std::endl;
+    RetryController batches;
+    batches.Admit("BatchWriteItem");
+    batches.OnSuccess("BatchWriteItem", 1);
+    batches.OnThrottled("BatchWriteItem");
+    auto batchCounters = batches.GetCounters()["BatchWriteItem"];
+    if (batchCounters.throttled != 1 || batchCounters.admissionRate <= 0 || batchCounters.retries != 0) {
+        std::cerr << "FAILED: Unprocessed items did not limit the operation" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Unprocessed items limited the operation to " << batchCounters.admissionRate
+                  << " calls/s" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+// Test that DynamoDBManager calls are retried through the controller
+bool TestManagerRetries(const MockDynamoDB& dynamo, MockTable& table) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== DynamoDBManager Retry Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions clientOptions = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(clientOptions));
+
+    awsexamples::utils::RetryOptions retryOptions;
+    retryOptions.baseDelay = std::chrono::milliseconds(5);
+    retryOptions.throttleBaseDelay = std::chrono::milliseconds(20);
+    auto controller = std::make_shared<awsexamples::utils::RetryController>(retryOptions);
+    dynamoManager.SetRetryController(controller);
+
+    // Two throttled attempts, then success
+    std::cout << "\n5. Throttled PutItem:" << std::endl;
+    table.throttleNext = 2;
+    int before = dynamo.RequestCount();
+    bool put = dynamoManager.PutItem("RetryTable", "1", "Alice", 30).success;
+    auto counters = controller->GetCounters()["PutItem"];
+    if (!put || dynamo.RequestCount() - before != 3 || counters.attempts != 3 ||
+        counters.throttled != 2 || counters.retries != 2 || counters.successes != 1) {
+        std::cerr << "FAILED: PutItem was not retried after throttling" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: PutItem succeeded on its third attempt" << std::endl;
+    }
+
+    // The asynchronous path backs off on the Waiter
+    std::cout << "\n6. Throttled DeleteItemAsync:" << std::endl;
+    table.throttleNext = 1;
+    bool deleted = dynamoManager.DeleteItemAsync("RetryTable", "1").get();
+    counters = controller->GetCounters()["DeleteItem"];
+    if (!deleted || counters.attempts != 2 || counters.retries != 1) {
+        std::cerr << "FAILED: DeleteItemAsync was not retried after throttling" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: DeleteItemAsync succeeded on its second attempt" << std::endl;
+    }
+
+    // Errors that cannot succeed on a retry fail at once
+    std::cout << "\n7. Rejected PutItem:" << std::endl;
+    table.rejectNext = true;
+    before = dynamo.RequestCount();
+    bool rejected = dynamoManager.PutItem("RetryTable", "2", "Bob", 40).success;
+    if (rejected || dynamo.RequestCount() - before != 1) {
+        std::cerr << "FAILED: A validation error was retried" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: A validation error failed without a retry" << std::endl;
+    }
+
+    // Batch writes report their throttling to the controller and are retried by it
+    std::cout << "\n8. Throttled BatchWriteItem:" << std::endl;
+    table.throttleNext = 1;
+    before = dynamo.RequestCount();
+    bool flushed = false;
+    {
+        awsexamples::DynamoDBBatchWriter writer(dynamoManager, "RetryTable");
+        Aws::DynamoDB::Model::AttributeValue id;
+        id.SetS("3");
+        writer.Put({{"id", id}});
+        flushed = writer.Flush();
+    }
+    counters = controller->GetCounters()["BatchWriteItem"];
+    if (!flushed || dynamo.RequestCount() - before != 2 || counters.attempts != 2 ||
+        counters.throttled != 1 || counters.successes != 1) {
+        std::cerr << "FAILED: BatchWriteItem throttling did not reach the controller" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: BatchWriteItem succeeded on its second attempt" << std::endl;
+    }
+
+    controller->PrintCounters();
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = TestDecisions();
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestManagerRetries(dynamo, table) && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
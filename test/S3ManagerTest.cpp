@@ -4,12 +4,50 @@
  */
 
 #include "awsexamples/S3Manager.h"
+#include "awsexamples/S3ObjectLister.h"
 #include "awsexamples/AwsUtils.h"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iterator>
+#include <future>
+#include <thread>
+#include <chrono>
 #include <aws/core/utils/UUID.h>
 
+// Create an S3Manager, targeting an S3-compatible stand-in such as MinIO when
+// AWSEXAMPLES_S3_ENDPOINT (e.g. "http://localhost:9000") is set
+awsexamples::S3Manager CreateS3Manager() {
+    const char* endpoint = std::getenv("AWSEXAMPLES_S3_ENDPOINT");
+    if (endpoint == nullptr || *endpoint == '\0') {
+        return awsexamples::S3Manager();
+    }
+    
+    std::cout << "Using S3 endpoint override: " << endpoint << std::endl;
+    Aws::Client::ClientConfiguration config = awsexamples::utils::ConfigureClient();
+    config.endpointOverride = endpoint;
+    if (std::string(endpoint).rfind("http://", 0) == 0) {
+        config.scheme = Aws::Http::Scheme::HTTP;
+        config.verifySSL = false;
+    }
+    return awsexamples::S3Manager(config, false);
+}
+
+// Compare two local files byte for byte
+bool FilesEqual(const std::string& lhsPath, const std::string& rhsPath) {
+    std::ifstream lhs(lhsPath, std::ios::binary);
+    std::ifstream rhs(rhsPath, std::ios::binary);
+    if (!lhs || !rhs) {
+        return false;
+    }
+    return std::equal(std::istreambuf_iterator<char>(lhs), std::istreambuf_iterator<char>(),
+                      std::istreambuf_iterator<char>(rhs), std::istreambuf_iterator<char>());
+}
+
 // Basic test to verify S3Manager functionality
 bool TestS3Manager() {
     bool allTestsPassed = true;
@@ -21,7 +59,13 @@ bool TestS3Manager() {
     std::cout << "=== S3Manager Test ===" << std::endl;
     std::cout << "Using test bucket name: " << bucketName << std::endl;
     
-    awsexamples::S3Manager s3Manager;
+    awsexamples::S3Manager s3Manager = CreateS3Manager();
+    
+    // Managers built from the same configuration share one client
+    if (CreateS3Manager().GetClient() != s3Manager.GetClient()) {
+        std::cerr << "FAILED: Managers with equal configurations do not share a client" << std::endl;
+        allTestsPassed = false;
+    }
     
     // Test listing buckets (no assertion, just informational)
     std::cout << "\n1. Listing buckets:" << std::endl;
@@ -29,7 +73,7 @@ bool TestS3Manager() {
     
     // Test bucket creation
     std::cout << "\n2. Creating bucket:" << std::endl;
-    bool bucketCreated = s3Manager.CreateBucket(bucketName);
+    bool bucketCreated = s3Manager.CreateBucket(bucketName).success;
     if (!bucketCreated) {
         std::cerr << "FAILED: Could not create bucket" << std::endl;
         allTestsPassed = false;
@@ -44,7 +88,7 @@ bool TestS3Manager() {
     // Test uploading text content
     std::cout << "\n3. Uploading text content:" << std::endl;
     std::string textContent = "This is a test file for S3 upload.";
-    bool textUploaded = s3Manager.UploadText(bucketName, "test.txt", textContent);
+    bool textUploaded = s3Manager.UploadText(bucketName, "test.txt", textContent).success;
     if (!textUploaded) {
         std::cerr << "FAILED: Could not upload text" << std::endl;
         allTestsPassed = false;
@@ -56,10 +100,44 @@ bool TestS3Manager() {
     std::cout << "\n4. Listing objects:" << std::endl;
     s3Manager.ListObjects(bucketName);
     
+    // Spread a few keys over two prefixes and list them with tiny pages so the
+    // iterator has to follow continuation tokens
+    const std::vector<std::string> listingKeys = {
+        "listing/a/1.txt", "listing/a/2.txt", "listing/a/3.txt", "listing/b/1.txt", "listing/b/2.txt"};
+    for (const auto& key : listingKeys) {
+        s3Manager.UploadText(bucketName, key, key);
+    }
+    awsexamples::ListObjectsOptions listOptions;
+    listOptions.prefix = "listing/";
+    listOptions.pageSize = 2;
+    awsexamples::S3ObjectLister lister(s3Manager, bucketName, listOptions);
+    std::size_t listedCount = std::distance(lister.begin(), lister.end());
+    
+    awsexamples::ParallelListOptions parallelOptions;
+    parallelOptions.prefix = "listing/";
+    parallelOptions.concurrency = 2;
+    std::atomic<std::size_t> parallelCount{0};
+    bool parallelListed = s3Manager.ListObjectsParallel(
+        bucketName, parallelOptions, [&parallelCount](const Aws::S3::Model::Object&) {
+            ++parallelCount;
+            return true;
+        }).success;
+    if (lister.Failed() || listedCount != listingKeys.size() ||
+        !parallelListed || parallelCount != listingKeys.size()) {
+        std::cerr << "FAILED: Paginated listing found " << listedCount << " and parallel listing found "
+                  << parallelCount << " of " << listingKeys.size() << " objects" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Paginated and parallel listings found all objects" << std::endl;
+    }
+    for (const auto& key : listingKeys) {
+        s3Manager.DeleteObject(bucketName, key);
+    }
+    
     // Test downloading file
     std::cout << "\n5. Downloading file:" << std::endl;
     std::string downloadPath = "test-download.txt";
-    bool fileDownloaded = s3Manager.DownloadFile(bucketName, "test.txt", downloadPath);
+    bool fileDownloaded = s3Manager.DownloadFile(bucketName, "test.txt", downloadPath).success;
     if (!fileDownloaded) {
         std::cerr << "FAILED: Could not download file" << std::endl;
         allTestsPassed = false;
@@ -77,9 +155,96 @@ bool TestS3Manager() {
         }
     }
     
+    // Test parallel multipart upload
+    std::cout << "\n6. Multipart upload:" << std::endl;
+    std::string largeFilePath = "test-multipart.bin";
+    std::string largeDownloadPath = "test-multipart-download.bin";
+    {
+        // 12 MiB + 1 byte gives two full 5 MiB parts and a short final part
+        std::ofstream largeFile(largeFilePath, std::ios::binary);
+        for (std::size_t i = 0; i < 12 * 1024 * 1024 + 1; ++i) {
+            largeFile.put(static_cast<char>(i * 31 % 251));
+        }
+    }
+    awsexamples::MultipartUploadOptions uploadOptions;
+    uploadOptions.partSize = 5 * 1024 * 1024;
+    uploadOptions.concurrency = 3;
+    awsexamples::TransferStats uploadStats;
+    bool multipartUploaded = s3Manager.UploadFile(
+        bucketName, "multipart.bin", largeFilePath, uploadOptions, &uploadStats).success;
+    if (!multipartUploaded || uploadStats.partCount != 3) {
+        std::cerr << "FAILED: Multipart upload did not complete in 3 parts" << std::endl;
+        allTestsPassed = false;
+    } else if (!s3Manager.DownloadFile(bucketName, "multipart.bin", largeDownloadPath) ||
+               !FilesEqual(largeFilePath, largeDownloadPath)) {
+        std::cerr << "FAILED: Multipart object contents don't match" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Multipart upload round-trips at "
+                  << uploadStats.throughputMiBps << " MiB/s" << std::endl;
+    }
+    
+    // Test parallel ranged download of the multipart object
+    std::cout << "\n7. Ranged download:" << std::endl;
+    std::string rangedDownloadPath = "test-ranged-download.bin";
+    awsexamples::RangedDownloadOptions downloadOptions;
+    downloadOptions.rangeSize = 1024 * 1024;
+    downloadOptions.concurrency = 4;
+    awsexamples::TransferStats downloadStats;
+    if (!multipartUploaded ||
+        !s3Manager.DownloadFile(
+            bucketName, "multipart.bin", rangedDownloadPath, downloadOptions, &downloadStats) ||
+        downloadStats.partCount != 13 || !FilesEqual(largeFilePath, rangedDownloadPath)) {
+        std::cerr << "FAILED: Ranged download contents don't match" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Ranged download matches at "
+                  << downloadStats.throughputMiBps << " MiB/s" << std::endl;
+    }
+    std::remove(rangedDownloadPath.c_str());
+    
+    if (multipartUploaded) {
+        s3Manager.DeleteObject(bucketName, "multipart.bin");
+    }
+    
+    // Test asynchronous operations with several requests in flight at once
+    std::cout << "\n8. Asynchronous operations:" << std::endl;
+    const int asyncObjectCount = 8;
+    std::vector<std::future<bool>> uploads;
+    for (int i = 0; i < asyncObjectCount; ++i) {
+        uploads.push_back(s3Manager.UploadTextAsync(
+            bucketName, "async/" + std::to_string(i) + ".txt", "async object " + std::to_string(i)));
+    }
+    bool asyncUploaded = std::all_of(uploads.begin(), uploads.end(), [](std::future<bool>& upload) {
+        return upload.get();
+    });
+    std::string asyncDownloadPath = "test-async-download.txt";
+    bool asyncDownloaded = asyncUploaded &&
+        s3Manager.DownloadFileAsync(bucketName, "async/3.txt", asyncDownloadPath).get();
+    std::string asyncContent;
+    if (asyncDownloaded) {
+        std::ifstream file(asyncDownloadPath);
+        asyncContent.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    int asyncDeleted = 0;
+    std::vector<std::future<bool>> deletes;
+    for (int i = 0; i < asyncObjectCount; ++i) {
+        deletes.push_back(s3Manager.DeleteObjectAsync(bucketName, "async/" + std::to_string(i) + ".txt"));
+    }
+    for (auto& deletion : deletes) {
+        asyncDeleted += deletion.get() ? 1 : 0;
+    }
+    if (!asyncUploaded || asyncContent != "async object 3" || asyncDeleted != asyncObjectCount) {
+        std::cerr << "FAILED: Asynchronous upload, download or delete did not complete" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Asynchronous operations completed" << std::endl;
+    }
+    std::remove(asyncDownloadPath.c_str());
+    
     // Test deleting object
-    std::cout << "\n6. Deleting object:" << std::endl;
-    bool objectDeleted = s3Manager.DeleteObject(bucketName, "test.txt");
+    std::cout << "\n9. Deleting object:" << std::endl;
+    bool objectDeleted = s3Manager.DeleteObject(bucketName, "test.txt").success;
     if (!objectDeleted) {
         std::cerr << "FAILED: Could not delete object" << std::endl;
         allTestsPassed = false;
@@ -88,8 +253,8 @@ bool TestS3Manager() {
     }
     
     // Test deleting bucket
-    std::cout << "\n7. Deleting bucket:" << std::endl;
-    bool bucketDeleted = s3Manager.DeleteBucket(bucketName);
+    std::cout << "\n10. Deleting bucket:" << std::endl;
+    bool bucketDeleted = s3Manager.DeleteBucket(bucketName).success;
     if (!bucketDeleted) {
         std::cerr << "FAILED: Could not delete bucket" << std::endl;
         allTestsPassed = false;
@@ -99,6 +264,8 @@ bool TestS3Manager() {
     
     // Clean up
     std::remove(downloadPath.c_str());
+    std::remove(largeFilePath.c_str());
+    std::remove(largeDownloadPath.c_str());
     
     return allTestsPassed;
 }
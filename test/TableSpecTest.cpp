@@ -0,0 +1,158 @@
+/**
+ * @file TableSpecTest.cpp
+ * @brief Test cases for DynamoDBManager::CreateTable with a TableSpec against a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "MockDynamoDB.h"
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// CreateTable requests seen by the mock endpoint
+struct MockTable {
+    std::mutex mutex;
+    std::vector<std::string> createTableBodies;
+};
+
+// Answer CreateTable with a table that is being created
+MockDynamoDB::Response HandleDynamoDBRequest(MockTable& table,
+                                             const std::string& operation,
+                                             const MockDynamoDB::Request& request) {
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (operation != "CreateTable") {
+        return MockDynamoDB::Error(MockDynamoDB::kValidationException, "Unsupported");
+    }
+    table.createTableBodies.push_back(request.body);
+    return MockDynamoDB::Reply("{\"TableDescription\":{\"TableStatus\":\"CREATING\"}}");
+}
+
+// Count the occurrences of @p needle in @p body
+std::size_t CountOf(const std::string& body, const std::string& needle) {
+    std::size_t count = 0;
+    for (std::size_t at = body.find(needle); at != std::string::npos; at = body.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Test the requests built from table specs against the mock endpoint
+bool TestTableSpec(const MockDynamoDB& dynamo, MockTable& table) {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Table Spec Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions options = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(options));
+
+    auto lastBody = [&table]() {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.createTableBodies.empty() ? std::string() : table.createTableBodies.back();
+    };
+    auto requestCount = [&table]() {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        return table.createTableBodies.size();
+    };
+
+    // The name-only overload keeps creating the provisioned "id" table
+    std::cout << "\n1. Default table:" << std::endl;
+    bool created = dynamoManager.CreateTable("Simple").success;
+    std::string body = lastBody();
+    if (!created || body.find("\"AttributeName\":\"id\"") == std::string::npos ||
+        body.find("\"ReadCapacityUnits\":5") == std::string::npos) {
+        std::cerr << "FAILED: The default table was not a provisioned table keyed by id: " << body << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The default table is keyed by id with 5 capacity units" << std::endl;
+    }
+
+    // Orders by customer and date, looked up by status and by amount
+    std::cout << "\n2. On-demand table with indexes:" << std::endl;
+    awsexamples::TableSpec spec;
+    spec.name = "Orders";
+    spec.hashKey = {"customer", awsexamples::KeyAttributeType::String};
+    spec.rangeKey = {"date", awsexamples::KeyAttributeType::String};
+    spec.billing = awsexamples::TableBilling::OnDemand;
+
+    awsexamples::SecondaryIndexSpec byStatus;
+    byStatus.name = "ByStatus";
+    byStatus.hashKey = {"status", awsexamples::KeyAttributeType::String};
+    byStatus.rangeKey = {"date", awsexamples::KeyAttributeType::String};
+    byStatus.projection = awsexamples::IndexProjection::KeysOnly;
+    spec.globalIndexes.push_back(byStatus);
+
+    awsexamples::SecondaryIndexSpec byAmount;
+    byAmount.name = "ByAmount";
+    byAmount.rangeKey = {"amount", awsexamples::KeyAttributeType::Number};
+    byAmount.projection = awsexamples::IndexProjection::Include;
+    byAmount.nonKeyAttributes = {"items"};
+    spec.localIndexes.push_back(byAmount);
+
+    created = dynamoManager.CreateTableAsync(spec).get();
+    body = lastBody();
+    bool shaped = body.find("\"BillingMode\":\"PAY_PER_REQUEST\"") != std::string::npos &&
+                  body.find("ProvisionedThroughput") == std::string::npos &&
+                  CountOf(body, "\"AttributeName\":\"date\",\"AttributeType\":\"S\"") == 1 &&
+                  body.find("\"AttributeName\":\"amount\",\"AttributeType\":\"N\"") != std::string::npos &&
+                  body.find("\"IndexName\":\"ByStatus\"") != std::string::npos &&
+                  body.find("\"ProjectionType\":\"KEYS_ONLY\"") != std::string::npos &&
+                  body.find("\"NonKeyAttributes\":[\"items\"]") != std::string::npos &&
+                  body.find("\"KeyType\":\"RANGE\"") != std::string::npos;
+    if (!created || !shaped) {
+        std::cerr << "FAILED: The request did not match the spec: " << body << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: The request has on-demand billing, four key attributes and both indexes" << std::endl;
+    }
+
+    // Invalid specs fail without a request
+    std::cout << "\n3. Invalid specs:" << std::endl;
+    std::size_t before = requestCount();
+    awsexamples::TableSpec hashOnly;
+    hashOnly.name = "HashOnly";
+    hashOnly.localIndexes.push_back(byAmount);
+    awsexamples::TableSpec conflicting = spec;
+    conflicting.globalIndexes[0].rangeKey.type = awsexamples::KeyAttributeType::Number;
+    bool hashOnlyCreated = dynamoManager.CreateTable(hashOnly).success;
+    bool conflictingCreated = dynamoManager.CreateTable(conflicting).success;
+    if (hashOnlyCreated || conflictingCreated || requestCount() != before) {
+        std::cerr << "FAILED: An invalid spec was sent" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Invalid specs were rejected before sending" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    MockTable table;
+    MockDynamoDB dynamo([&table](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(table, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = false;
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestTableSpec(dynamo, table);
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}
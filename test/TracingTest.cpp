@@ -0,0 +1,265 @@
+/**
+ * @file TracingTest.cpp
+ * @brief Test cases for the Tracer and TraceScope classes, including traces of calls to a mock endpoint
+ */
+
+#include "awsexamples/DynamoDBManager.h"
+#include "awsexamples/AwsUtils.h"
+#include "awsexamples/RetryController.h"
+#include "awsexamples/Tracing.h"
+#include "MockDynamoDB.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using awsexamples::utils::TraceEvent;
+using awsexamples::utils::TraceKind;
+using awsexamples::utils::Tracer;
+
+// Answer every DynamoDB request with success, or a throttling error while throttle is set
+MockDynamoDB::Response HandleDynamoDBRequest(const std::atomic<bool>& throttle,
+                                             const std::string&,
+                                             const MockDynamoDB::Request&) {
+    if (throttle) {
+        return MockDynamoDB::Error(MockDynamoDB::kThrottlingException, "Mock throttling");
+    }
+    return MockDynamoDB::Reply();
+}
+
+// Record a Scope event named after a number
+void RecordScope(int number) {
+    TraceEvent event;
+    event.kind = TraceKind::Scope;
+    event.name = std::to_string(number);
+    event.start = std::chrono::steady_clock::now();
+    Tracer::Instance().Record(event);
+}
+
+// Find the events of one kind and name
+std::vector<TraceEvent> FindEvents(const std::vector<TraceEvent>& events, TraceKind kind, const std::string& name) {
+    std::vector<TraceEvent> found;
+    for (const auto& event : events) {
+        if (event.kind == kind && event.name == name) {
+            found.push_back(event);
+        }
+    }
+    return found;
+}
+
+// Test the ring buffer without sending any requests
+bool TestRingBuffer() {
+    bool allTestsPassed = true;
+
+    std::cout << "=== Tracer Test ===" << std::endl;
+
+    Tracer& tracer = Tracer::Instance();
+
+    // Tracing is off until enabled
+    std::cout << "\n1. Disabled by default:" << std::endl;
+    RecordScope(0);
+    {
+        awsexamples::utils::TraceScope scope("Ignored");
+    }
+    if (tracer.IsEnabled() || !tracer.Events().empty()) {
+        std::cerr << "FAILED: Events were recorded before tracing was enabled" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Nothing was recorded" << std::endl;
+    }
+
+    // A full buffer keeps the newest events, oldest first
+    std::cout << "\n2. Overwriting the oldest events:" << std::endl;
+    tracer.Enable(4);
+    for (int number = 1; number <= 6; ++number) {
+        RecordScope(number);
+    }
+    auto events = tracer.Events();
+    bool newestKept = events.size() == 4;
+    for (std::size_t i = 0; newestKept && i < events.size(); ++i) {
+        newestKept = events[i].name == std::to_string(i + 3);
+    }
+    if (!newestKept || tracer.GetOverwritten() != 2) {
+        std::cerr << "FAILED: Kept " << events.size() << " events, " << tracer.GetOverwritten() << " overwritten"
+                  << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Events 3 to 6 were kept, 2 overwritten" << std::endl;
+    }
+
+    // Events from many threads are all kept, each on its own thread lane
+    std::cout << "\n3. Concurrent recording:" << std::endl;
+    tracer.Enable();
+    const int threadCount = 4;
+    const int perThread = 1000;
+    std::vector<std::thread> recorders;
+    for (int t = 0; t < threadCount; ++t) {
+        recorders.emplace_back([]() {
+            for (int i = 0; i < perThread; ++i) {
+                RecordScope(i);
+            }
+        });
+    }
+    for (auto& recorder : recorders) {
+        recorder.join();
+    }
+    events = tracer.Events();
+    std::vector<std::uint32_t> threads;
+    for (const auto& event : events) {
+        if (std::find(threads.begin(), threads.end(), event.thread) == threads.end()) {
+            threads.push_back(event.thread);
+        }
+    }
+    if (events.size() != threadCount * perThread || threads.size() != threadCount || tracer.GetOverwritten() != 0) {
+        std::cerr << "FAILED: Recorded " << events.size() << " events on " << threads.size() << " threads"
+                  << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << events.size() << " events on " << threads.size() << " threads" << std::endl;
+    }
+    tracer.Disable();
+
+    return allTestsPassed;
+}
+
+// Test the events recorded for calls to the mock endpoint and their export
+bool TestCallTraces(const MockDynamoDB& dynamo, std::atomic<bool>& throttle) {
+    bool allTestsPassed = true;
+
+    std::cout << "\n=== Call Trace Test ===" << std::endl;
+    std::cout << "Using mock DynamoDB endpoint: " << dynamo.Endpoint() << std::endl;
+
+    awsexamples::utils::ClientOptions clientOptions = dynamo.Options();
+    awsexamples::DynamoDBManager dynamoManager(awsexamples::utils::ConfigureClient(clientOptions));
+
+    awsexamples::utils::RetryOptions retryOptions;
+    retryOptions.maxAttempts = 2;
+    retryOptions.baseDelay = std::chrono::milliseconds(1);
+    retryOptions.throttleBaseDelay = std::chrono::milliseconds(5);
+    dynamoManager.SetRetryController(std::make_shared<awsexamples::utils::RetryController>(retryOptions));
+
+    Tracer& tracer = Tracer::Instance();
+    tracer.Enable();
+    {
+        awsexamples::utils::TraceScope scope("PutAndDelete");
+        dynamoManager.PutItem("TraceTable", "1", "Alice", 30);
+        throttle = true;
+        dynamoManager.DeleteItem("TraceTable", "1");
+        throttle = false;
+    }
+    tracer.Disable();
+    const auto events = tracer.Events();
+
+    // The retry path records one Operation event per call, nested in the scope
+    std::cout << "\n4. Operation events:" << std::endl;
+    const auto scopes = FindEvents(events, TraceKind::Scope, "PutAndDelete");
+    const auto puts = FindEvents(events, TraceKind::Operation, "PutItem");
+    const auto deletes = FindEvents(events, TraceKind::Operation, "DeleteItem");
+    if (scopes.size() != 1 || puts.size() != 1 || deletes.size() != 1) {
+        std::cerr << "FAILED: Expected one scope, PutItem and DeleteItem event" << std::endl;
+        allTestsPassed = false;
+    } else {
+        const auto& scope = scopes[0];
+        const auto& put = puts[0];
+        const auto& deleted = deletes[0];
+        // Durations are truncated to microseconds, so allow the scope to end 1 us early
+        const bool nested = scope.start <= put.start && put.start <= deleted.start &&
+                            deleted.start + deleted.duration <=
+                                scope.start + scope.duration + std::chrono::microseconds(1) &&
+                            put.thread == scope.thread && deleted.thread == scope.thread;
+        if (!nested || put.attempts != 1 || !put.errorType.empty() || deleted.attempts != 2 ||
+            deleted.errorType.find("ProvisionedThroughputExceededException") == std::string::npos) {
+            std::cerr << "FAILED: Unexpected events: PutItem " << put.attempts << " attempts, DeleteItem "
+                      << deleted.attempts << " attempts" << std::endl;
+            allTestsPassed = false;
+        } else {
+            std::cout << "PASSED: DeleteItem took " << deleted.attempts << " attempts with "
+                      << deleted.retryDelay.count() << " us of backoff" << std::endl;
+        }
+    }
+
+    // The SDK's monitoring hook records one Attempt event per HTTP request
+    std::cout << "\n5. Attempt events:" << std::endl;
+    const auto putAttempts = FindEvents(events, TraceKind::Attempt, "PutItem");
+    const auto deleteAttempts = FindEvents(events, TraceKind::Attempt, "DeleteItem");
+    if (putAttempts.size() != 1 || putAttempts[0].status != 200 || putAttempts[0].service.empty() ||
+        deleteAttempts.size() != 2 || deleteAttempts[1].status != 400 || deleteAttempts[1].errorType.empty()) {
+        std::cerr << "FAILED: Recorded " << putAttempts.size() << " PutItem and " << deleteAttempts.size()
+                  << " DeleteItem attempts" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: " << putAttempts[0].service << " PutItem took " << putAttempts[0].duration.count()
+                  << " us, first byte after " << putAttempts[0].firstByteMillis << " ms" << std::endl;
+    }
+
+    // The export is a Chrome trace with the events and their arguments
+    std::cout << "\n6. Chrome trace export:" << std::endl;
+    std::ostringstream trace;
+    tracer.WriteChromeTrace(trace);
+    const std::string json = trace.str();
+    const std::string expectedFragments[] = {
+        "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[",
+        "{\"name\":\"PutAndDelete\",\"cat\":\"scope\",\"ph\":\"X\",\"ts\":0,",
+        "{\"name\":\"DeleteItem\",\"cat\":\"operation\",\"ph\":\"X\",",
+        "\"args\":{\"attempts\":2,",
+        "\"cat\":\"attempt\"",
+    };
+    bool allFragmentsFound = json.size() > 3 && json.compare(json.size() - 3, 3, "]}\n") == 0;
+    for (const auto& fragment : expectedFragments) {
+        if (json.find(fragment) == std::string::npos) {
+            std::cerr << "FAILED: Missing fragment: " << fragment << std::endl;
+            allFragmentsFound = false;
+        }
+    }
+    const std::string tracePath = "tracing_test.json";
+    bool dumped = tracer.DumpToFile(tracePath);
+    std::ifstream traceFile(tracePath);
+    std::stringstream traceContents;
+    traceContents << traceFile.rdbuf();
+    traceFile.close();
+    std::remove(tracePath.c_str());
+    if (!allFragmentsFound || !dumped || traceContents.str() != json) {
+        std::cerr << "FAILED: The Chrome trace is incomplete" << std::endl;
+        allTestsPassed = false;
+    } else {
+        std::cout << "PASSED: Wrote " << json.size() << " bytes of trace events" << std::endl;
+    }
+
+    return allTestsPassed;
+}
+
+int main() {
+    std::atomic<bool> throttle{false};
+    MockDynamoDB dynamo([&throttle](const std::string& operation, const MockDynamoDB::Request& request) {
+        return HandleDynamoDBRequest(throttle, operation, request);
+    });
+    if (!dynamo.IsRunning()) {
+        std::cerr << "\nTESTS FAILED! Could not start the mock endpoint" << std::endl;
+        return 1;
+    }
+
+    bool testResult = TestRingBuffer();
+    {
+        // Initialize AWS SDK
+        awsexamples::utils::AwsApiInitializer awsInitializer;
+
+        // Run the test
+        testResult = TestCallTraces(dynamo, throttle) && testResult;
+    }
+
+    // Print final result
+    if (testResult) {
+        std::cout << "\nALL TESTS PASSED!" << std::endl;
+        return 0;
+    } else {
+        std::cerr << "\nTESTS FAILED!" << std::endl;
+        return 1;
+    }
+}